@@ -1352,6 +1352,8 @@ declare global {
         enableAllDrawableTrackPieces: boolean;
         enableChainLiftOnAllTrack: boolean;
         fastLiftHill: boolean;
+        fastPathfinding: boolean;
+        fastRideRatings: boolean;
         freezeWeather: boolean;
         ignoreResearchStatus: boolean;
         ignoreRideIntensity: boolean;
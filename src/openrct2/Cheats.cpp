@@ -53,6 +53,8 @@ bool gCheatsDisableRideValueAging = false;
 bool gCheatsIgnoreResearchStatus = false;
 bool gCheatsEnableAllDrawableTrackPieces = false;
 bool gCheatsAllowTrackPlaceInvalidHeights = false;
+bool gCheatsFastPathfinding = false;
+bool gCheatsFastRideRatings = false;
 
 void CheatsReset()
 {
@@ -78,6 +80,8 @@ void CheatsReset()
     gCheatsIgnoreResearchStatus = false;
     gCheatsEnableAllDrawableTrackPieces = false;
     gCheatsAllowTrackPlaceInvalidHeights = false;
+    gCheatsFastPathfinding = false;
+    gCheatsFastRideRatings = false;
 }
 
 void CheatsSet(CheatType cheatType, int32_t param1 /* = 0*/, int32_t param2 /* = 0*/)
@@ -126,6 +130,8 @@ void CheatsSerialise(DataSerialiser& ds)
         CheatEntrySerialise(ds, CheatType::IgnoreResearchStatus, gCheatsIgnoreResearchStatus, count);
         CheatEntrySerialise(ds, CheatType::EnableAllDrawableTrackPieces, gCheatsEnableAllDrawableTrackPieces, count);
         CheatEntrySerialise(ds, CheatType::AllowTrackPlaceInvalidHeights, gCheatsAllowTrackPlaceInvalidHeights, count);
+        CheatEntrySerialise(ds, CheatType::FastPathfinding, gCheatsFastPathfinding, count);
+        CheatEntrySerialise(ds, CheatType::FastRideRatings, gCheatsFastRideRatings, count);
 
         // Remember current position and update count.
         uint64_t endOffset = stream.GetPosition();
@@ -213,6 +219,12 @@ void CheatsSerialise(DataSerialiser& ds)
                 case CheatType::AllowTrackPlaceInvalidHeights:
                     ds << gCheatsAllowTrackPlaceInvalidHeights;
                     break;
+                case CheatType::FastPathfinding:
+                    ds << gCheatsFastPathfinding;
+                    break;
+                case CheatType::FastRideRatings:
+                    ds << gCheatsFastRideRatings;
+                    break;
                 default:
                     break;
             }
@@ -318,6 +330,10 @@ const char* CheatsGetName(CheatType cheatType)
             return language_get_string(STR_CHEAT_ENABLE_ALL_DRAWABLE_TRACK_PIECES);
         case CheatType::AllowTrackPlaceInvalidHeights:
             return language_get_string(STR_CHEAT_ALLOW_TRACK_PLACE_INVALID_HEIGHTS);
+        case CheatType::FastPathfinding:
+            return language_get_string(STR_CHEAT_FAST_PATHFINDING);
+        case CheatType::FastRideRatings:
+            return language_get_string(STR_CHEAT_FAST_RIDE_RATINGS);
         default:
             return "Unknown Cheat";
     }
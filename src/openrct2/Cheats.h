@@ -34,6 +34,8 @@ extern bool gCheatsAllowArbitraryRideTypeChanges;
 extern bool gCheatsIgnoreResearchStatus;
 extern bool gCheatsEnableAllDrawableTrackPieces;
 extern bool gCheatsAllowTrackPlaceInvalidHeights;
+extern bool gCheatsFastPathfinding;
+extern bool gCheatsFastRideRatings;
 
 enum class CheatType : int32_t
 {
@@ -87,6 +89,8 @@ enum class CheatType : int32_t
     CreateDucks,
     RemoveDucks,
     AllowTrackPlaceInvalidHeights,
+    FastPathfinding,
+    FastRideRatings,
     Count,
 };
 
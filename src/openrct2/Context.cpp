@@ -156,6 +156,7 @@ namespace OpenRCT2
             //       If objects use GetContext() in their destructor things won't go well.
 
             GameActions::ClearQueue();
+            game_autosave_finish();
             network_close();
             window_close_all();
 
@@ -430,16 +431,18 @@ namespace OpenRCT2
             //      of the object cache.
             _objectRepository->LoadOrConstruct(_localisationService->GetCurrentLanguage());
 
-            // TODO Like objects, this can take a while if there are a lot of track designs
-            //      its also really something really we might want to do in the background
-            //      as its not required until the player wants to place a new ride.
-            _trackDesignRepository->Scan(_localisationService->GetCurrentLanguage());
-
             _scenarioRepository->Scan(_localisationService->GetCurrentLanguage());
-            TitleSequenceManager::Scan();
 
+            // Track designs, title sequences and audio are only used by the user interface, so a headless server does not
+            // scan or initialise them.
             if (!gOpenRCT2Headless)
             {
+                // TODO Like objects, this can take a while if there are a lot of track designs
+                //      its also really something really we might want to do in the background
+                //      as its not required until the player wants to place a new ride.
+                _trackDesignRepository->Scan(_localisationService->GetCurrentLanguage());
+                TitleSequenceManager::Scan();
+
                 audio_init();
                 audio_populate_devices();
                 audio_init_ride_sounds_and_info();
@@ -36,11 +36,14 @@
 #include "network/network.h"
 #include "object/Object.h"
 #include "object/ObjectList.h"
+#include "paint/PaintCache.h"
 #include "peep/Peep.h"
 #include "peep/Staff.h"
 #include "platform/platform.h"
 #include "rct1/RCT1.h"
 #include "ride/Ride.h"
+#include "ride/RideProximity.h"
+#include "ride/RideReachability.h"
 #include "ride/RideRatings.h"
 #include "ride/Station.h"
 #include "ride/Track.h"
@@ -58,6 +61,7 @@
 #include "world/Climate.h"
 #include "world/Entrance.h"
 #include "world/Footpath.h"
+#include "world/FootpathGraph.h"
 #include "world/Map.h"
 #include "world/MapAnimation.h"
 #include "world/Park.h"
@@ -67,7 +71,9 @@
 #include "world/Water.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cstdio>
+#include <future>
 #include <iterator>
 #include <memory>
 
@@ -88,6 +94,10 @@ uint32_t gCurrentRealTimeTicks;
 rct_string_id gGameCommandErrorTitle;
 rct_string_id gGameCommandErrorText;
 
+// The autosave that is being written in the background, if any.
+static std::future<bool> _autosaveTask;
+static AutosaveStats _autosaveStats;
+
 using namespace OpenRCT2;
 
 void game_reset_speed()
@@ -570,7 +580,16 @@ void game_load_init()
         GameActions::ClearQueue();
         reset_sprite_spatial_index();
     }
+    else
+    {
+        // Clients keep the spatial index of the server, only the cells are built from it.
+        sprite_spatial_rebuild_cells();
+    }
     reset_all_sprite_quadrant_placements();
+    ride_proximity_invalidate_all();
+    ride_reachability_invalidate_all();
+    footpath_graph_invalidate_all();
+    paint_cache_invalidate_all();
     scenery_set_default_placement_configuration();
 
     auto intent = Intent(INTENT_ACTION_REFRESH_NEW_RIDES);
@@ -768,6 +787,11 @@ static void limit_autosave_count(const size_t numberOfFilesToKeep, bool processL
 
 void game_autosave()
 {
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    // The previous autosave has to be written before the autosaves are rotated.
+    game_autosave_finish();
+
     const char* subDirectory = "save";
     const char* fileExtension = ".sv6";
     uint32_t saveFlags = 0x80000000;
@@ -808,8 +832,39 @@ void game_autosave()
         platform_file_copy(path, backupPath, true);
     }
 
-    if (!scenario_save(path, saveFlags))
+    if (gConfigGeneral.autosave_in_background)
+    {
+        // The park state is copied right away, exporting and writing it is done while the game carries on.
+        _autosaveTask = scenario_save_in_background(path, saveFlags);
+        _autosaveStats.BackgroundAutosaves++;
+    }
+    else if (!scenario_save(path, saveFlags))
+    {
+        std::fprintf(stderr, "Could not autosave the scenario. Is the save folder writeable?\n");
+    }
+
+    auto stall = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - startTime).count();
+    _autosaveStats.Autosaves++;
+    _autosaveStats.LastStallSeconds = stall;
+    _autosaveStats.MaxStallSeconds = std::max(_autosaveStats.MaxStallSeconds, stall);
+    _autosaveStats.TotalStallSeconds += stall;
+    log_verbose("Autosave held up the game for %.1f ms", stall * 1000.0);
+}
+
+/**
+ * Waits for an autosave that is being written in the background.
+ */
+void game_autosave_finish()
+{
+    if (_autosaveTask.valid() && !_autosaveTask.get())
+    {
         std::fprintf(stderr, "Could not autosave the scenario. Is the save folder writeable?\n");
+    }
+}
+
+AutosaveStats game_autosave_get_stats()
+{
+    return _autosaveStats;
 }
 
 static void game_load_or_quit_no_save_prompt_callback(int32_t result, const utf8* path)
@@ -16,6 +16,16 @@
 struct ParkLoadResult;
 struct rct_s6_data;
 
+struct AutosaveStats
+{
+    uint32_t Autosaves;
+    uint32_t BackgroundAutosaves;
+    // Time the game thread was held up by autosaving.
+    double LastStallSeconds;
+    double MaxStallSeconds;
+    double TotalStallSeconds;
+};
+
 enum GAME_COMMAND
 {
     GAME_COMMAND_SET_RIDE_APPEARANCE,          // GA
@@ -168,6 +178,8 @@ void save_game_as();
 void save_game_cmd(const utf8* name = nullptr);
 void save_game_with_name(const utf8* name);
 void game_autosave();
+void game_autosave_finish();
+AutosaveStats game_autosave_get_stats();
 void game_convert_strings_to_utf8();
 void game_convert_news_items_to_utf8();
 void game_convert_strings_to_rct2(rct_s6_data* s6);
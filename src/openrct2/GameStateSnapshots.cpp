@@ -13,60 +13,119 @@
 #include "peep/Peep.h"
 #include "world/Sprite.h"
 
+#include <cstring>
+#include <vector>
+
 static constexpr size_t MaximumGameStateSnapshots = 32;
 static constexpr uint32_t InvalidTick = 0xFFFFFFFF;
 
 struct GameStateSnapshot_t
 {
-    GameStateSnapshot_t& operator=(GameStateSnapshot_t&& mv) noexcept
-    {
-        tick = mv.tick;
-        storedSprites = std::move(mv.storedSprites);
-        return *this;
-    }
-
     uint32_t tick = InvalidTick;
     uint32_t srand0 = 0;
 
-    MemoryStream storedSprites;
+    // The sprites that exist and their indices, in order of index. Sprites hold the same bytes they would after being
+    // serialised and deserialised, everything else is zero, so two snapshots can be compared block by block.
+    std::vector<uint32_t> spriteIndices;
+    std::vector<rct_sprite> sprites;
     MemoryStream parkParameters;
 
-    void SerialiseSprites(rct_sprite* sprites, const size_t numSprites, bool saving)
+    void Reset()
     {
-        const bool loading = !saving;
-
-        storedSprites.SetPosition(0);
-        DataSerialiser ds(saving, storedSprites);
+        tick = InvalidTick;
+        srand0 = 0;
+        spriteIndices.clear();
+        sprites.clear();
+        parkParameters = MemoryStream();
+    }
 
-        std::vector<uint32_t> indexTable;
-        indexTable.reserve(numSprites);
+    /**
+     * Gets how many bytes of the sprite are serialised, besides the identifier and type for misc sprites.
+     */
+    static size_t GetSerialisedSize(const rct_sprite& sprite)
+    {
+        switch (sprite.generic.sprite_identifier)
+        {
+            case SPRITE_IDENTIFIER_VEHICLE:
+                return sizeof(Vehicle);
+            case SPRITE_IDENTIFIER_PEEP:
+                return sizeof(Peep);
+            case SPRITE_IDENTIFIER_LITTER:
+                return sizeof(Litter);
+            case SPRITE_IDENTIFIER_MISC:
+                switch (sprite.generic.type)
+                {
+                    case SPRITE_MISC_MONEY_EFFECT:
+                        return sizeof(MoneyEffect);
+                    case SPRITE_MISC_BALLOON:
+                        return sizeof(Balloon);
+                    case SPRITE_MISC_DUCK:
+                        return sizeof(Duck);
+                    case SPRITE_MISC_JUMPING_FOUNTAIN_WATER:
+                        return sizeof(JumpingFountain);
+                    case SPRITE_MISC_STEAM_PARTICLE:
+                        return sizeof(SteamParticle);
+                }
+                break;
+        }
+        return 0;
+    }
 
-        uint32_t numSavedSprites = 0;
+    /**
+     * Copies all sprites that exist straight from the sprite list.
+     */
+    void CaptureSprites(const rct_sprite* spriteList, const size_t numSprites)
+    {
+        spriteIndices.clear();
+        for (size_t i = 0; i < numSprites; i++)
+        {
+            if (spriteList[i].generic.sprite_identifier != SPRITE_IDENTIFIER_NULL)
+            {
+                spriteIndices.push_back(static_cast<uint32_t>(i));
+            }
+        }
 
-        if (saving)
+        // Only grows the buffer, every byte of the sprites is written below.
+        if (sprites.size() < spriteIndices.size())
+        {
+            sprites.resize(spriteIndices.size());
+        }
+        for (size_t i = 0; i < spriteIndices.size(); i++)
         {
-            for (size_t i = 0; i < numSprites; i++)
+            const rct_sprite& src = spriteList[spriteIndices[i]];
+            rct_sprite& dst = sprites[i];
+            const size_t size = GetSerialisedSize(src);
+            std::memcpy(&dst, &src, size);
+            std::memset(reinterpret_cast<uint8_t*>(&dst) + size, 0, sizeof(rct_sprite) - size);
+            if (size == 0)
             {
-                if (sprites[i].generic.sprite_identifier == SPRITE_IDENTIFIER_NULL)
-                    continue;
-                indexTable.push_back(static_cast<uint32_t>(i));
+                dst.generic.sprite_identifier = src.generic.sprite_identifier;
+                dst.generic.type = src.generic.type;
             }
-            numSavedSprites = static_cast<uint32_t>(indexTable.size());
         }
+    }
 
+    void SerialiseSprites(MemoryStream& storedSprites, bool saving)
+    {
+        const bool loading = !saving;
+
+        storedSprites.SetPosition(0);
+        DataSerialiser ds(saving, storedSprites);
+
+        uint32_t numSavedSprites = static_cast<uint32_t>(spriteIndices.size());
         ds << numSavedSprites;
 
         if (loading)
         {
-            indexTable.resize(numSavedSprites);
+            spriteIndices.resize(numSavedSprites);
+            sprites.assign(numSavedSprites, rct_sprite());
         }
 
         for (uint32_t i = 0; i < numSavedSprites; i++)
         {
-            ds << indexTable[i];
+            ds << spriteIndices[i];
 
-            const uint32_t spriteIdx = indexTable[i];
-            rct_sprite& sprite = sprites[spriteIdx];
+            rct_sprite& sprite = sprites[i];
 
             ds << sprite.generic.sprite_identifier;
 
@@ -118,7 +177,17 @@ struct GameStateSnapshots final : public IGameStateSnapshots
 
     virtual GameStateSnapshot_t& CreateSnapshot() override final
     {
-        auto snapshot = std::make_unique<GameStateSnapshot_t>();
+        // Once the buffer is full, the oldest snapshot is reused so its buffers do not have to be allocated again.
+        std::unique_ptr<GameStateSnapshot_t> snapshot;
+        if (_snapshots.size() == _snapshots.capacity())
+        {
+            snapshot = std::move(_snapshots.front());
+            snapshot->Reset();
+        }
+        else
+        {
+            snapshot = std::make_unique<GameStateSnapshot_t>();
+        }
         _snapshots.push_back(std::move(snapshot));
 
         return *_snapshots.back();
@@ -132,7 +201,7 @@ struct GameStateSnapshots final : public IGameStateSnapshots
 
     virtual void Capture(GameStateSnapshot_t& snapshot) override final
     {
-        snapshot.SerialiseSprites(get_sprite(0), MAX_SPRITES, true);
+        snapshot.CaptureSprites(get_sprite(0), MAX_SPRITES);
 
         // log_info("Snapshot size: %u bytes", static_cast<uint32_t>(snapshot.storedSprites.GetLength()));
     }
@@ -149,26 +218,22 @@ struct GameStateSnapshots final : public IGameStateSnapshots
 
     virtual void SerialiseSnapshot(GameStateSnapshot_t& snapshot, DataSerialiser& ds) const override final
     {
+        // Sprites are only serialised field by field when the snapshot is sent or stored.
+        MemoryStream storedSprites;
+        if (ds.IsSaving())
+        {
+            snapshot.SerialiseSprites(storedSprites, true);
+        }
+
         ds << snapshot.tick;
         ds << snapshot.srand0;
-        ds << snapshot.storedSprites;
+        ds << storedSprites;
         ds << snapshot.parkParameters;
-    }
 
-    std::vector<rct_sprite> BuildSpriteList(GameStateSnapshot_t& snapshot) const
-    {
-        std::vector<rct_sprite> spriteList;
-        spriteList.resize(MAX_SPRITES);
-
-        for (auto& sprite : spriteList)
+        if (ds.IsLoading())
         {
-            // By default they don't exist.
-            sprite.generic.sprite_identifier = SPRITE_IDENTIFIER_NULL;
+            snapshot.SerialiseSprites(storedSprites, false);
         }
-
-        snapshot.SerialiseSprites(spriteList.data(), MAX_SPRITES, false);
-
-        return spriteList;
     }
 
 #define COMPARE_FIELD(struc, field)                                                                                            \
@@ -523,16 +588,31 @@ struct GameStateSnapshots final : public IGameStateSnapshots
         res.srand0Left = base.srand0;
         res.srand0Right = cmp.srand0;
 
-        std::vector<rct_sprite> spritesBase = BuildSpriteList(const_cast<GameStateSnapshot_t&>(base));
-        std::vector<rct_sprite> spritesCmp = BuildSpriteList(const_cast<GameStateSnapshot_t&>(cmp));
+        // Both sprite lists are in order of index, walk them together. Sprites are stored the same way in both, so
+        // only the ones with different bytes are compared field by field.
+        rct_sprite nullSprite;
+        nullSprite.generic.sprite_identifier = SPRITE_IDENTIFIER_NULL;
 
-        for (uint32_t i = 0; i < static_cast<uint32_t>(spritesBase.size()); i++)
+        res.spriteChanges.reserve(MAX_SPRITES);
+        size_t baseIndex = 0;
+        size_t cmpIndex = 0;
+        for (uint32_t i = 0; i < MAX_SPRITES; i++)
         {
             GameStateSpriteChange_t changeData;
             changeData.spriteIndex = i;
 
-            const rct_sprite& spriteBase = spritesBase[i];
-            const rct_sprite& spriteCmp = spritesCmp[i];
+            const rct_sprite* baseSprite = &nullSprite;
+            if (baseIndex < base.spriteIndices.size() && base.spriteIndices[baseIndex] == i)
+            {
+                baseSprite = &base.sprites[baseIndex++];
+            }
+            const rct_sprite* cmpSprite = &nullSprite;
+            if (cmpIndex < cmp.spriteIndices.size() && cmp.spriteIndices[cmpIndex] == i)
+            {
+                cmpSprite = &cmp.sprites[cmpIndex++];
+            }
+            const rct_sprite& spriteBase = *baseSprite;
+            const rct_sprite& spriteCmp = *cmpSprite;
 
             changeData.spriteIdentifier = spriteBase.generic.sprite_identifier;
             changeData.miscIdentifier = spriteBase.generic.type;
@@ -559,6 +639,10 @@ struct GameStateSnapshots final : public IGameStateSnapshots
                 // Do nothing.
                 changeData.changeType = GameStateSpriteChange_t::EQUAL;
             }
+            else if (std::memcmp(&spriteBase, &spriteCmp, sizeof(rct_sprite)) == 0)
+            {
+                changeData.changeType = GameStateSpriteChange_t::EQUAL;
+            }
             else
             {
                 CompareSpriteData(spriteBase, spriteCmp, changeData);
@@ -572,7 +656,7 @@ struct GameStateSnapshots final : public IGameStateSnapshots
                 }
             }
 
-            res.spriteChanges.push_back(changeData);
+            res.spriteChanges.push_back(std::move(changeData));
         }
 
         return res;
@@ -13,6 +13,7 @@
 #include "../management/Finance.h"
 #include "../windows/Intent.h"
 #include "../world/Banner.h"
+#include "../world/FootpathGraph.h"
 #include "GameAction.h"
 
 // There is also the BannerSetColourAction that sets primary colour but this action takes banner index rather than x, y, z,
@@ -151,6 +152,7 @@ public:
                     allowedEdges &= ~(1 << bannerElement->GetPosition());
                 }
                 bannerElement->SetAllowedEdges(allowedEdges);
+                footpath_graph_invalidate_tile(banner->position.ToCoordsXY());
                 break;
             }
             default:
@@ -16,6 +16,7 @@
 #include "../localisation/StringIds.h"
 #include "../management/Finance.h"
 #include "../world/Footpath.h"
+#include "../world/FootpathGraph.h"
 #include "../world/Location.hpp"
 #include "../world/Park.h"
 #include "../world/Scenery.h"
@@ -185,6 +186,7 @@ private:
         pathElement->SetSurfaceEntryIndex(_type & ~FOOTPATH_ELEMENT_INSERT_QUEUE);
         bool isQueue = _type & FOOTPATH_ELEMENT_INSERT_QUEUE;
         pathElement->SetIsQueue(isQueue);
+        footpath_graph_invalidate_tile(_loc);
 
         rct_scenery_entry* elem = pathElement->GetAdditionEntry();
         if (elem != nullptr)
@@ -249,6 +249,12 @@ public:
             case CheatType::AllowTrackPlaceInvalidHeights:
                 gCheatsAllowTrackPlaceInvalidHeights = _param1 != 0;
                 break;
+            case CheatType::FastPathfinding:
+                gCheatsFastPathfinding = _param1 != 0;
+                break;
+            case CheatType::FastRideRatings:
+                gCheatsFastRideRatings = _param1 != 0;
+                break;
             default:
             {
                 log_error("Unabled cheat: %d", _cheatType.id);
@@ -315,6 +321,10 @@ private:
                 [[fallthrough]];
             case CheatType::EnableAllDrawableTrackPieces:
                 [[fallthrough]];
+            case CheatType::FastPathfinding:
+                [[fallthrough]];
+            case CheatType::FastRideRatings:
+                [[fallthrough]];
             case CheatType::OpenClosePark:
                 return { { 0, 1 }, { 0, 0 } };
             case CheatType::AddMoney:
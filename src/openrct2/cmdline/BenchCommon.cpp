@@ -0,0 +1,94 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifdef USE_BENCHMARK
+
+#    include "BenchCommon.h"
+
+#    include "../Context.h"
+#    include "../Game.h"
+#    include "../Intro.h"
+#    include "../OpenRCT2.h"
+#    include "../core/FileScanner.h"
+#    include "../core/Path.hpp"
+#    include "../platform/platform.h"
+
+#    include <algorithm>
+#    include <memory>
+
+bool load_park(const std::string& parkFileName)
+{
+    auto context = OpenRCT2::GetContext();
+    if (!context->LoadParkFromFile(parkFileName))
+    {
+        log_error("Failed to load park!");
+        return false;
+    }
+
+    gIntroState = INTRO_STATE_NONE;
+    gScreenFlags = SCREEN_FLAGS_PLAYING;
+    return true;
+}
+
+/**
+ * Gets the parks to benchmark from a file or directory argument, an empty list if it is neither.
+ */
+std::vector<std::string> get_park_files(const utf8* path)
+{
+    std::vector<std::string> parkFiles;
+    if (platform_file_exists(path))
+    {
+        parkFiles.emplace_back(path);
+    }
+    else if (platform_directory_exists(path))
+    {
+        auto scanner = std::unique_ptr<IFileScanner>(Path::ScanDirectory(Path::Combine(path, "*.sv6;*.sc6"), false));
+        while (scanner->Next())
+        {
+            parkFiles.emplace_back(scanner->GetPath());
+        }
+        std::sort(parkFiles.begin(), parkFiles.end());
+    }
+    return parkFiles;
+}
+
+/**
+ * Gets the parks to benchmark from the park files and directories in the arguments, the ones that come with the tests
+ * when there are none. Other arguments are benchmark options and are added to argvForBenchmark.
+ */
+std::vector<std::string> split_benchmark_arguments(int argc, const char** argv, std::vector<char*>& argvForBenchmark)
+{
+    // Google benchmark does stuff to argv. It doesn't modify the pointees,
+    // but it wants to reorder the pointers, so present a copy of them.
+    // argv[0] is expected to contain the binary name. It's only for logging purposes, don't bother.
+    argvForBenchmark.push_back(nullptr);
+
+    std::vector<std::string> parkFiles;
+    for (int i = 0; i < argc; i++)
+    {
+        auto argParkFiles = get_park_files(argv[i]);
+        if (!argParkFiles.empty())
+        {
+            parkFiles.insert(parkFiles.end(), argParkFiles.begin(), argParkFiles.end());
+        }
+        else
+        {
+            argvForBenchmark.push_back(const_cast<char*>(argv[i]));
+        }
+    }
+
+    // Without any parks, use the ones that come with the tests when run from the repository.
+    if (parkFiles.empty())
+    {
+        parkFiles = get_park_files(DEFAULT_PARKS_DIRECTORY);
+    }
+    return parkFiles;
+}
+
+#endif // USE_BENCHMARK
@@ -0,0 +1,22 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+
+#include <string>
+#include <vector>
+
+// The parks that come with the tests, relative to the root of the repository.
+constexpr const utf8* DEFAULT_PARKS_DIRECTORY = "test/tests/testdata/parks";
+
+bool load_park(const std::string& parkFileName);
+std::vector<std::string> get_park_files(const utf8* path);
+std::vector<std::string> split_benchmark_arguments(int argc, const char** argv, std::vector<char*>& argvForBenchmark);
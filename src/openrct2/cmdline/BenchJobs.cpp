@@ -0,0 +1,159 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "CommandLine.hpp"
+
+#ifdef USE_BENCHMARK
+
+#    include "../core/JobPool.hpp"
+#    include "../core/TaskScheduler.h"
+
+#    include <benchmark/benchmark.h>
+#    include <cstdint>
+#    include <vector>
+
+// Same column width viewport_paint splits the viewport into.
+static constexpr int32_t BenchColumnWidth = 32;
+static constexpr int32_t BenchViewportHeight = 1080;
+
+/**
+ * Stands in for painting one column: every pixel gets a value that depends on its neighbours so the work can not be
+ * skipped. The amount of passes sets how expensive a column is.
+ */
+static void bench_fill_column(std::vector<uint8_t>& pixels, int32_t column, int32_t passes)
+{
+    uint8_t* bits = &pixels[column * BenchColumnWidth * BenchViewportHeight];
+    for (int32_t pass = 0; pass < passes; pass++)
+    {
+        uint8_t last = static_cast<uint8_t>(pass);
+        for (int32_t i = 0; i < BenchColumnWidth * BenchViewportHeight; i++)
+        {
+            last = static_cast<uint8_t>(bits[i] * 31 + last + i);
+            bits[i] = last;
+        }
+    }
+}
+
+static void BM_paint_columns_serial(benchmark::State& state)
+{
+    const int32_t columns = static_cast<int32_t>(state.range(0));
+    const int32_t passes = static_cast<int32_t>(state.range(1));
+    std::vector<uint8_t> pixels(columns * BenchColumnWidth * BenchViewportHeight);
+    for (auto _ : state)
+    {
+        for (int32_t i = 0; i < columns; i++)
+        {
+            bench_fill_column(pixels, i, passes);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * columns);
+}
+
+// The way viewport_paint shared out columns before: one std::function per column, joined every frame.
+static void BM_paint_columns_job_pool(benchmark::State& state)
+{
+    const int32_t columns = static_cast<int32_t>(state.range(0));
+    const int32_t passes = static_cast<int32_t>(state.range(1));
+    std::vector<uint8_t> pixels(columns * BenchColumnWidth * BenchViewportHeight);
+    JobPool jobPool;
+    for (auto _ : state)
+    {
+        for (int32_t i = 0; i < columns; i++)
+        {
+            jobPool.AddTask([&pixels, i, passes]() { bench_fill_column(pixels, i, passes); });
+        }
+        jobPool.Join();
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * columns);
+}
+
+static void BM_paint_columns_task_scheduler(benchmark::State& state)
+{
+    const int32_t columns = static_cast<int32_t>(state.range(0));
+    const int32_t passes = static_cast<int32_t>(state.range(1));
+    std::vector<uint8_t> pixels(columns * BenchColumnWidth * BenchViewportHeight);
+    auto& scheduler = TaskScheduler::GetDefault();
+    for (auto _ : state)
+    {
+        scheduler.ParallelFor(0, columns, 1, [&pixels, passes](size_t i) {
+            bench_fill_column(pixels, static_cast<int32_t>(i), passes);
+        });
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * columns);
+}
+
+static int cmdline_for_bench_jobs(int argc, const char** argv)
+{
+    // Columns of a 1920 pixel wide viewport, with cheap and expensive columns.
+    benchmark::RegisterBenchmark("paint_columns_serial", BM_paint_columns_serial)->Args({ 60, 1 })->Args({ 60, 8 });
+    benchmark::RegisterBenchmark("paint_columns_job_pool", BM_paint_columns_job_pool)
+        ->Args({ 60, 1 })
+        ->Args({ 60, 8 })
+        ->UseRealTime();
+    benchmark::RegisterBenchmark("paint_columns_task_scheduler", BM_paint_columns_task_scheduler)
+        ->Args({ 60, 1 })
+        ->Args({ 60, 8 })
+        ->UseRealTime();
+
+    // Google benchmark does stuff to argv. It doesn't modify the pointees,
+    // but it wants to reorder the pointers, so present a copy of them.
+    std::vector<char*> argv_for_benchmark;
+
+    // argv[0] is expected to contain the binary name. It's only for logging purposes, don't bother.
+    argv_for_benchmark.push_back(nullptr);
+    for (int i = 0; i < argc; i++)
+    {
+        argv_for_benchmark.push_back(const_cast<char*>(argv[i]));
+    }
+
+    argc = static_cast<int>(argv_for_benchmark.size());
+    ::benchmark::Initialize(&argc, &argv_for_benchmark[0]);
+    if (::benchmark::ReportUnrecognizedArguments(argc, &argv_for_benchmark[0]))
+        return -1;
+    ::benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
+
+static exitcode_t HandleBenchJobs(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    int32_t result = cmdline_for_bench_jobs(argc, argv);
+    if (result < 0)
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+#else
+static exitcode_t HandleBenchJobs(CommandLineArgEnumerator* argEnumerator)
+{
+    log_error("Sorry, Google benchmark not enabled in this build");
+    return EXITCODE_FAIL;
+}
+#endif // USE_BENCHMARK
+
+const CommandLineCommand CommandLine::BenchJobsCommands[]{
+#ifdef USE_BENCHMARK
+    DefineCommand(
+        "",
+        "[--benchmark_list_tests={true|false}] [--benchmark_filter=<regex>] [--benchmark_min_time=<min_time>] "
+        "[--benchmark_repetitions=<num_repetitions>] [--benchmark_report_aggregates_only={true|false}] "
+        "[--benchmark_format=<console|json|csv>] [--benchmark_out=<filename>] [--benchmark_out_format=<json|console|csv>] "
+        "[--benchmark_color={auto|true|false}] [--benchmark_counters_tabular={true|false}] [--v=<verbosity>]",
+        nullptr, HandleBenchJobs),
+    CommandTableEnd
+#else
+    DefineCommand("", "*** SORRY NOT ENABLED IN THIS BUILD ***", nullptr, HandleBenchJobs), CommandTableEnd
+#endif // USE_BENCHMARK
+};
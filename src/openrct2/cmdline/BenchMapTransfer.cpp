@@ -0,0 +1,320 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "CommandLine.hpp"
+
+#if defined(USE_BENCHMARK) && !defined(DISABLE_NETWORK)
+
+#    include "../Context.h"
+#    include "../Game.h"
+#    include "../GameState.h"
+#    include "../OpenRCT2.h"
+#    include "../core/MemoryStream.h"
+#    include "../network/NetworkConnection.h"
+#    include "../network/NetworkMap.h"
+#    include "../network/NetworkTypes.h"
+#    include "../platform/platform.h"
+#    include "../rct2/S6Exporter.h"
+#    include "../util/SawyerCoding.h"
+
+#    include <algorithm>
+#    include <benchmark/benchmark.h>
+#    include <memory>
+#    include <string>
+#    include <vector>
+
+// The park that comes with the tests, relative to the root of the repository.
+static constexpr const utf8* DEFAULT_PARK_PATH = "test/tests/testdata/parks/bpb.sv6";
+static constexpr uint16_t BENCH_PORT = 11760;
+// The same as the chunks the server sends the map in.
+static constexpr size_t CHUNK_SIZE = 1024 * 63;
+// Ticks between the map a client holds and the map it is sent the difference to.
+static constexpr uint32_t DELTA_TICKS = 40;
+
+enum class MapTransferMode
+{
+    // Every client gets the map saved and compressed again, as before maps were cached.
+    Uncached,
+    // The map is compressed once for all clients.
+    Cached,
+    // Clients that hold an older map get the difference to it.
+    Delta,
+};
+
+static std::vector<uint8_t> _baseMap;
+static std::vector<uint8_t> _currentMap;
+
+static std::vector<uint8_t> save_map()
+{
+    bool rleState = gUseRLE;
+    gUseRLE = false;
+    auto s6exporter = std::make_unique<S6Exporter>();
+    s6exporter->Export();
+    MemoryStream ms;
+    s6exporter->SaveGame(&ms);
+    gUseRLE = rleState;
+
+    const uint8_t* data = static_cast<const uint8_t*>(ms.GetData());
+    return std::vector<uint8_t>(data, data + ms.GetLength());
+}
+
+/**
+ * Server and client ends of loopback connections.
+ */
+struct LoopbackConnections
+{
+    std::unique_ptr<ITcpSocket> ListenSocket;
+    std::vector<std::unique_ptr<NetworkConnection>> Servers;
+    std::vector<std::unique_ptr<NetworkConnection>> Clients;
+
+    explicit LoopbackConnections(size_t count)
+    {
+        ListenSocket = CreateTcpSocket();
+        ListenSocket->Listen("127.0.0.1", BENCH_PORT);
+        for (size_t i = 0; i < count; i++)
+        {
+            auto client = std::make_unique<NetworkConnection>();
+            client->Socket = CreateTcpSocket();
+            client->Socket->Connect("127.0.0.1", BENCH_PORT);
+
+            auto server = std::make_unique<NetworkConnection>();
+            while (server->Socket == nullptr)
+            {
+                server->Socket = ListenSocket->Accept();
+            }
+            server->AuthStatus = NETWORK_AUTH_OK;
+
+            Clients.push_back(std::move(client));
+            Servers.push_back(std::move(server));
+        }
+    }
+};
+
+static void queue_map(NetworkConnection& connection, const std::vector<uint8_t>& payload)
+{
+    for (size_t i = 0; i < payload.size(); i += CHUNK_SIZE)
+    {
+        size_t datasize = std::min(CHUNK_SIZE, payload.size() - i);
+        auto packet = NetworkPacket::Allocate();
+        *packet << static_cast<uint32_t>(NETWORK_COMMAND_MAP) << static_cast<uint32_t>(payload.size())
+                << static_cast<uint32_t>(i);
+        packet->Write(&payload[i], datasize);
+        connection.QueuePacket(std::move(packet));
+    }
+}
+
+/**
+ * Sends the queued packets until every client has received the whole map, false if a connection is lost.
+ */
+static bool transfer_maps(LoopbackConnections& connections)
+{
+    std::vector<size_t> received(connections.Clients.size());
+    std::vector<size_t> expected(connections.Clients.size(), SIZE_MAX);
+    size_t numComplete = 0;
+    while (numComplete < connections.Clients.size())
+    {
+        for (auto& server : connections.Servers)
+        {
+            server->SendQueuedPackets();
+        }
+        for (size_t i = 0; i < connections.Clients.size(); i++)
+        {
+            auto& client = *connections.Clients[i];
+            int32_t status;
+            while ((status = client.ReadPacket()) == NETWORK_READPACKET_SUCCESS || status == NETWORK_READPACKET_MORE_DATA)
+            {
+                if (status == NETWORK_READPACKET_SUCCESS)
+                {
+                    uint32_t command, size, offset;
+                    client.InboundPacket >> command >> size >> offset;
+                    received[i] += client.InboundPacket.Size - client.InboundPacket.BytesRead;
+                    expected[i] = size;
+                    client.InboundPacket.Clear();
+                    if (received[i] == expected[i])
+                    {
+                        numComplete++;
+                    }
+                }
+            }
+            if (status == NETWORK_READPACKET_DISCONNECTED)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Sends the map to range(0) clients joining at the same time and compressed with level range(1), the time it takes is
+ * the latency of joining.
+ */
+static void BM_map_transfer(benchmark::State& state, MapTransferMode mode)
+{
+    const size_t numClients = static_cast<size_t>(state.range(0));
+    const int32_t level = static_cast<int32_t>(state.range(1));
+
+    std::unique_ptr<LoopbackConnections> connections;
+    try
+    {
+        connections = std::make_unique<LoopbackConnections>(numClients);
+    }
+    catch (const std::exception& e)
+    {
+        state.SkipWithError(e.what());
+        return;
+    }
+
+    // The map the clients hold is saved before the benchmark, as they would have received it earlier.
+    auto baseMap = network_map_create(_baseMap, {}, level);
+
+    size_t payloadSize = 0;
+    for (auto _ : state)
+    {
+        std::shared_ptr<NetworkMap> map;
+        std::vector<uint8_t> delta;
+        for (auto& server : connections->Servers)
+        {
+            if (map == nullptr || mode == MapTransferMode::Uncached)
+            {
+                map = network_map_create(_currentMap, {}, level);
+                if (mode == MapTransferMode::Delta)
+                {
+                    delta = network_map_create_delta(*baseMap, *map, level);
+                }
+            }
+            const auto& payload = mode == MapTransferMode::Delta ? delta : map->Payload;
+            payloadSize = payload.size();
+            queue_map(*server, payload);
+        }
+        if (!transfer_maps(*connections))
+        {
+            state.SkipWithError("Lost a connection!");
+            return;
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * numClients * payloadSize);
+    state.counters["payload_bytes"] = static_cast<double>(payloadSize);
+}
+
+static int cmdline_for_bench_map_transfer(int argc, const char** argv)
+{
+    // Google benchmark does stuff to argv. It doesn't modify the pointees,
+    // but it wants to reorder the pointers, so present a copy of them.
+    std::vector<char*> argv_for_benchmark;
+
+    // argv[0] is expected to contain the binary name. It's only for logging purposes, don't bother.
+    argv_for_benchmark.push_back(nullptr);
+
+    // The first argument that is a file is the park to send, others are benchmark options.
+    std::string parkFile = DEFAULT_PARK_PATH;
+    for (int i = 0; i < argc; i++)
+    {
+        if (platform_file_exists(argv[i]))
+        {
+            parkFile = argv[i];
+        }
+        else
+        {
+            argv_for_benchmark.push_back(const_cast<char*>(argv[i]));
+        }
+    }
+
+    core_init();
+    gOpenRCT2Headless = true;
+    if (!InitialiseWSA())
+    {
+        log_error("Failed to initialise sockets!");
+        return -1;
+    }
+    auto context = OpenRCT2::CreateContext();
+    if (!context->Initialise())
+    {
+        log_error("Failed to initialise context!");
+        return -1;
+    }
+    if (!context->LoadParkFromFile(parkFile))
+    {
+        log_error("Failed to load park!");
+        return -1;
+    }
+
+    _baseMap = save_map();
+    for (uint32_t i = 0; i < DELTA_TICKS; i++)
+    {
+        context->GetGameState()->UpdateLogic();
+    }
+    _currentMap = save_map();
+
+    std::vector<std::vector<int64_t>> args = { { 1, 6 }, { 4, 6 }, { 8, 6 }, { 8, 9 } };
+    benchmark::RegisterBenchmark("map_transfer/uncached", BM_map_transfer, MapTransferMode::Uncached)
+        ->Args(args[0])
+        ->Args(args[1])
+        ->Args(args[2])
+        ->Args(args[3])
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
+    benchmark::RegisterBenchmark("map_transfer/cached", BM_map_transfer, MapTransferMode::Cached)
+        ->Args(args[0])
+        ->Args(args[1])
+        ->Args(args[2])
+        ->Args(args[3])
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
+    benchmark::RegisterBenchmark("map_transfer/delta", BM_map_transfer, MapTransferMode::Delta)
+        ->Args(args[0])
+        ->Args(args[1])
+        ->Args(args[2])
+        ->Args(args[3])
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
+
+    argc = static_cast<int>(argv_for_benchmark.size());
+    ::benchmark::Initialize(&argc, &argv_for_benchmark[0]);
+    if (::benchmark::ReportUnrecognizedArguments(argc, &argv_for_benchmark[0]))
+        return -1;
+    ::benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
+
+static exitcode_t HandleBenchMapTransfer(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    int32_t result = cmdline_for_bench_map_transfer(argc, argv);
+    if (result < 0)
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+#else
+static exitcode_t HandleBenchMapTransfer(CommandLineArgEnumerator* argEnumerator)
+{
+    log_error("Sorry, Google benchmark or networking not enabled in this build");
+    return EXITCODE_FAIL;
+}
+#endif // USE_BENCHMARK && !DISABLE_NETWORK
+
+const CommandLineCommand CommandLine::BenchMapTransferCommands[]{
+#if defined(USE_BENCHMARK) && !defined(DISABLE_NETWORK)
+    DefineCommand(
+        "",
+        "[<file>] [--benchmark_list_tests={true|false}] [--benchmark_filter=<regex>] "
+        "[--benchmark_min_time=<min_time>] [--benchmark_repetitions=<num_repetitions>] "
+        "[--benchmark_report_aggregates_only={true|false}] [--benchmark_format=<console|json|csv>] "
+        "[--benchmark_out=<filename>] [--benchmark_out_format=<json|console|csv>] [--benchmark_color={auto|true|false}] "
+        "[--benchmark_counters_tabular={true|false}] [--v=<verbosity>]",
+        nullptr, HandleBenchMapTransfer),
+    CommandTableEnd
+#else
+    DefineCommand("", "*** SORRY NOT ENABLED IN THIS BUILD ***", nullptr, HandleBenchMapTransfer), CommandTableEnd
+#endif // USE_BENCHMARK && !DISABLE_NETWORK
+};
@@ -0,0 +1,207 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "CommandLine.hpp"
+
+#if defined(USE_BENCHMARK) && !defined(DISABLE_NETWORK)
+
+#    include "../network/NetworkConnection.h"
+#    include "../network/NetworkTypes.h"
+#    include "../platform/platform.h"
+
+#    include <benchmark/benchmark.h>
+#    include <memory>
+#    include <vector>
+
+static constexpr uint16_t BENCH_PORT = 11761;
+
+/**
+ * Connects count clients to a server over loopback sockets, returns false if that fails.
+ */
+static bool connect_clients(
+    size_t count, std::vector<std::unique_ptr<NetworkConnection>>& servers,
+    std::vector<std::unique_ptr<NetworkConnection>>& clients)
+{
+    try
+    {
+        auto listenSocket = CreateTcpSocket();
+        listenSocket->Listen("127.0.0.1", BENCH_PORT);
+        for (size_t i = 0; i < count; i++)
+        {
+            auto client = std::make_unique<NetworkConnection>();
+            client->Socket = CreateTcpSocket();
+            client->Socket->Connect("127.0.0.1", BENCH_PORT);
+
+            auto server = std::make_unique<NetworkConnection>();
+            while (server->Socket == nullptr)
+            {
+                server->Socket = listenSocket->Accept();
+            }
+            server->AuthStatus = NETWORK_AUTH_OK;
+
+            clients.push_back(std::move(client));
+            servers.push_back(std::move(server));
+        }
+    }
+    catch (const std::exception& e)
+    {
+        log_error("%s", e.what());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Sends range(1) game action packets and a tick packet to range(0) clients, as the server does every tick.
+ */
+static void BM_packet_fan_out(benchmark::State& state)
+{
+    const size_t numClients = static_cast<size_t>(state.range(0));
+    const size_t numActions = static_cast<size_t>(state.range(1));
+
+    std::vector<std::unique_ptr<NetworkConnection>> servers;
+    std::vector<std::unique_ptr<NetworkConnection>> clients;
+    if (!connect_clients(numClients, servers, clients))
+    {
+        state.SkipWithError("Failed to connect clients!");
+        return;
+    }
+
+    // Roughly the size of a serialised game action.
+    const std::vector<uint8_t> actionData(96, 0xAB);
+    size_t bytesPerClient = 0;
+    uint32_t tick = 0;
+    for (auto _ : state)
+    {
+        bytesPerClient = 0;
+        for (size_t i = 0; i <= numActions; i++)
+        {
+            auto packet = NetworkPacket::Allocate();
+            if (i < numActions)
+            {
+                *packet << static_cast<uint32_t>(NETWORK_COMMAND_GAME_ACTION) << tick << static_cast<uint32_t>(i);
+                packet->Write(actionData.data(), actionData.size());
+            }
+            else
+            {
+                *packet << static_cast<uint32_t>(NETWORK_COMMAND_TICK) << tick << static_cast<uint32_t>(0);
+            }
+            bytesPerClient += sizeof(uint16_t) + packet->Data->size();
+            for (auto& server : servers)
+            {
+                server->QueuePacket(*packet);
+            }
+        }
+        for (auto& server : servers)
+        {
+            server->SendQueuedPackets();
+        }
+
+        // Read everything so the socket buffers do not fill up between iterations.
+        state.PauseTiming();
+        for (auto& client : clients)
+        {
+            size_t numReceived = 0;
+            while (numReceived <= numActions)
+            {
+                int32_t status = client->ReadPacket();
+                if (status == NETWORK_READPACKET_SUCCESS)
+                {
+                    client->InboundPacket.Clear();
+                    numReceived++;
+                }
+                else if (status == NETWORK_READPACKET_DISCONNECTED)
+                {
+                    state.SkipWithError("Lost a connection!");
+                    return;
+                }
+                else if (status == NETWORK_READPACKET_NO_DATA)
+                {
+                    for (auto& server : servers)
+                    {
+                        server->SendQueuedPackets();
+                    }
+                }
+            }
+        }
+        tick++;
+        state.ResumeTiming();
+    }
+    state.SetBytesProcessed(state.iterations() * numClients * bytesPerClient);
+}
+
+static int cmdline_for_bench_packet_fan_out(int argc, const char** argv)
+{
+    core_init();
+    if (!InitialiseWSA())
+    {
+        log_error("Failed to initialise sockets!");
+        return -1;
+    }
+    benchmark::RegisterBenchmark("packet_fan_out", BM_packet_fan_out)
+        ->Args({ 8, 8 })
+        ->Args({ 32, 8 })
+        ->Args({ 64, 8 })
+        ->Args({ 64, 64 })
+        ->Unit(benchmark::kMicrosecond)
+        ->UseRealTime();
+
+    // Google benchmark does stuff to argv. It doesn't modify the pointees,
+    // but it wants to reorder the pointers, so present a copy of them.
+    std::vector<char*> argv_for_benchmark;
+
+    // argv[0] is expected to contain the binary name. It's only for logging purposes, don't bother.
+    argv_for_benchmark.push_back(nullptr);
+    for (int i = 0; i < argc; i++)
+    {
+        argv_for_benchmark.push_back(const_cast<char*>(argv[i]));
+    }
+
+    argc = static_cast<int>(argv_for_benchmark.size());
+    ::benchmark::Initialize(&argc, &argv_for_benchmark[0]);
+    if (::benchmark::ReportUnrecognizedArguments(argc, &argv_for_benchmark[0]))
+        return -1;
+    ::benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
+
+static exitcode_t HandleBenchPacketFanOut(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    int32_t result = cmdline_for_bench_packet_fan_out(argc, argv);
+    if (result < 0)
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+#else
+static exitcode_t HandleBenchPacketFanOut(CommandLineArgEnumerator* argEnumerator)
+{
+    log_error("Sorry, Google benchmark or networking not enabled in this build");
+    return EXITCODE_FAIL;
+}
+#endif // USE_BENCHMARK && !DISABLE_NETWORK
+
+const CommandLineCommand CommandLine::BenchPacketFanOutCommands[]{
+#if defined(USE_BENCHMARK) && !defined(DISABLE_NETWORK)
+    DefineCommand(
+        "",
+        "[--benchmark_list_tests={true|false}] [--benchmark_filter=<regex>] [--benchmark_min_time=<min_time>] "
+        "[--benchmark_repetitions=<num_repetitions>] [--benchmark_report_aggregates_only={true|false}] "
+        "[--benchmark_format=<console|json|csv>] [--benchmark_out=<filename>] [--benchmark_out_format=<json|console|csv>] "
+        "[--benchmark_color={auto|true|false}] [--benchmark_counters_tabular={true|false}] [--v=<verbosity>]",
+        nullptr, HandleBenchPacketFanOut),
+    CommandTableEnd
+#else
+    DefineCommand("", "*** SORRY NOT ENABLED IN THIS BUILD ***", nullptr, HandleBenchPacketFanOut), CommandTableEnd
+#endif // USE_BENCHMARK && !DISABLE_NETWORK
+};
@@ -0,0 +1,218 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "CommandLine.hpp"
+
+#ifdef USE_BENCHMARK
+
+#    include "BenchCommon.h"
+
+#    include "../Context.h"
+#    include "../Game.h"
+#    include "../OpenRCT2.h"
+#    include "../core/File.h"
+#    include "../core/Path.hpp"
+#    include "../core/String.hpp"
+#    include "../platform/platform.h"
+#    include "../ride/Ride.h"
+#    include "../ride/RideRatings.h"
+
+#    include <benchmark/benchmark.h>
+#    include <memory>
+#    include <set>
+#    include <string>
+#    include <vector>
+
+static constexpr const utf8* RATINGS_OUT_OPTION = "--ratings_out=";
+
+/**
+ * Gets the open rides of the loaded park of the given type, of every type for RIDE_TYPE_NULL. Closed rides are not
+ * rated.
+ */
+static std::vector<ride_id_t> get_rides_to_rate(uint8_t rideType)
+{
+    std::vector<ride_id_t> rides;
+    for (const auto& ride : GetRideManager())
+    {
+        if (ride.status != RIDE_STATUS_CLOSED && (rideType == RIDE_TYPE_NULL || ride.type == rideType))
+        {
+            rides.push_back(ride.id);
+        }
+    }
+    return rides;
+}
+
+/**
+ * Rates the open rides of the given type in a park, of every type for RIDE_TYPE_NULL, reports the rides rated a second.
+ */
+static void BM_ride_ratings(benchmark::State& state, const std::string& parkFileName, uint8_t rideType)
+{
+    if (!load_park(parkFileName))
+    {
+        state.SkipWithError("Failed to load park!");
+        return;
+    }
+
+    const auto rides = get_rides_to_rate(rideType);
+    for (auto _ : state)
+    {
+        for (auto rideIndex : rides)
+        {
+            auto ride = get_ride(rideIndex);
+            if (ride != nullptr)
+            {
+                ride_ratings_update_ride(*ride);
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * rides.size());
+    state.counters["rides"] = static_cast<double>(rides.size());
+}
+
+/**
+ * Formats the ratings of a ride the same way as the expected ratings of the ride ratings test.
+ */
+static std::string format_ratings(const Ride& ride)
+{
+    return String::StdFormat(
+        "%s: (%d, %d, %d)", ride_type_get_enum_name(ride.type), static_cast<int32_t>(ride.ratings.excitement),
+        static_cast<int32_t>(ride.ratings.intensity), static_cast<int32_t>(ride.ratings.nausea));
+}
+
+/**
+ * Rates every ride of the loaded park and writes the ratings to a file, one ride a line.
+ */
+static void write_ratings(const std::string& path)
+{
+    std::string text;
+    for (const auto& ride : GetRideManager())
+    {
+        ride_ratings_update_ride(ride);
+        text += format_ratings(ride);
+        text += '\n';
+    }
+    File::WriteAllBytes(path, text.data(), text.size());
+}
+
+static int cmdline_for_bench_ride_ratings(int argc, const char** argv)
+{
+    // Where to write the ratings is taken out of the argument list, the other arguments are parks and benchmark options.
+    std::vector<const char*> args;
+    std::string ratingsDirectory;
+    for (int i = 0; i < argc; i++)
+    {
+        if (String::StartsWith(argv[i], RATINGS_OUT_OPTION))
+        {
+            ratingsDirectory = argv[i] + String::LengthOf(RATINGS_OUT_OPTION);
+        }
+        else
+        {
+            args.push_back(argv[i]);
+        }
+    }
+
+    std::vector<char*> argv_for_benchmark;
+    auto parkFiles = split_benchmark_arguments(static_cast<int>(args.size()), args.data(), argv_for_benchmark);
+    if (parkFiles.empty())
+    {
+        log_error("No parks to benchmark!");
+        return -1;
+    }
+
+    core_init();
+    gOpenRCT2Headless = true;
+    auto context = OpenRCT2::CreateContext();
+    if (!context->Initialise())
+    {
+        log_error("Failed to initialise context!");
+        return -1;
+    }
+    if (!ratingsDirectory.empty())
+    {
+        Path::CreateDirectory(ratingsDirectory);
+    }
+
+    for (const auto& parkFile : parkFiles)
+    {
+        if (!load_park(parkFile))
+        {
+            return -1;
+        }
+
+        // Named like the expected ratings of the ride ratings test, so they can be compared with diff.
+        auto parkFileName = Path::GetFileName(parkFile);
+        if (!ratingsDirectory.empty())
+        {
+            write_ratings(Path::Combine(ratingsDirectory, parkFileName + ".txt"));
+        }
+
+        auto name = "ride_ratings/" + parkFileName;
+        benchmark::RegisterBenchmark(name.c_str(), BM_ride_ratings, parkFile, static_cast<uint8_t>(RIDE_TYPE_NULL))
+            ->Unit(benchmark::kMicrosecond);
+
+        // The ride types in the park, to time them one at a time.
+        std::set<uint8_t> rideTypes;
+        for (const auto& ride : GetRideManager())
+        {
+            if (ride.status != RIDE_STATUS_CLOSED)
+            {
+                rideTypes.insert(ride.type);
+            }
+        }
+        for (auto rideType : rideTypes)
+        {
+            auto typeName = name + "/" + ride_type_get_enum_name(rideType);
+            benchmark::RegisterBenchmark(typeName.c_str(), BM_ride_ratings, parkFile, rideType)
+                ->Unit(benchmark::kMicrosecond);
+        }
+    }
+
+    argc = static_cast<int>(argv_for_benchmark.size());
+    ::benchmark::Initialize(&argc, &argv_for_benchmark[0]);
+    if (::benchmark::ReportUnrecognizedArguments(argc, &argv_for_benchmark[0]))
+        return -1;
+    ::benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
+
+static exitcode_t HandleBenchRideRatings(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    int32_t result = cmdline_for_bench_ride_ratings(argc, argv);
+    if (result < 0)
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+#else
+static exitcode_t HandleBenchRideRatings(CommandLineArgEnumerator* argEnumerator)
+{
+    log_error("Sorry, Google benchmark not enabled in this build");
+    return EXITCODE_FAIL;
+}
+#endif // USE_BENCHMARK
+
+const CommandLineCommand CommandLine::BenchRideRatingsCommands[]{
+#ifdef USE_BENCHMARK
+    DefineCommand(
+        "",
+        "[<file|directory>]... [--ratings_out=<directory>] [--benchmark_list_tests={true|false}] "
+        "[--benchmark_filter=<regex>] [--benchmark_min_time=<min_time>] [--benchmark_repetitions=<num_repetitions>] "
+        "[--benchmark_report_aggregates_only={true|false}] [--benchmark_format=<console|json|csv>] "
+        "[--benchmark_out=<filename>] [--benchmark_out_format=<json|console|csv>] [--benchmark_color={auto|true|false}] "
+        "[--benchmark_counters_tabular={true|false}] [--v=<verbosity>]",
+        nullptr, HandleBenchRideRatings),
+    CommandTableEnd
+#else
+    DefineCommand("", "*** SORRY NOT ENABLED IN THIS BUILD ***", nullptr, HandleBenchRideRatings), CommandTableEnd
+#endif // USE_BENCHMARK
+};
@@ -0,0 +1,264 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "CommandLine.hpp"
+
+#ifdef USE_BENCHMARK
+
+#    include "BenchCommon.h"
+
+#    include "../Context.h"
+#    include "../Game.h"
+#    include "../OpenRCT2.h"
+#    include "../core/Console.hpp"
+#    include "../core/MemoryStream.h"
+#    include "../core/Path.hpp"
+#    include "../platform/platform.h"
+#    include "../rct12/SawyerChunkReader.h"
+#    include "../rct2/S6Exporter.h"
+#    include "../util/SawyerCoding.h"
+#    include "../util/Util.h"
+
+#    include <benchmark/benchmark.h>
+#    include <memory>
+#    include <string>
+#    include <vector>
+
+/**
+ * Encodes and checksums an exported park, everything a save does after exporting the park.
+ */
+static void BM_save(benchmark::State& state, std::shared_ptr<S6Exporter> s6exporter)
+{
+    uint64_t fileSize = 0;
+    for (auto _ : state)
+    {
+        MemoryStream stream;
+        s6exporter->SaveGame(&stream);
+        fileSize = stream.GetLength();
+        benchmark::DoNotOptimize(stream.GetData());
+    }
+    state.SetBytesProcessed(state.iterations() * sizeof(rct_s6_data));
+    state.counters["file_size"] = static_cast<double>(fileSize);
+}
+
+using ParkChunks = std::vector<std::vector<uint8_t>>;
+using EncodeFunction = size_t (*)(const uint8_t*, uint8_t*, size_t);
+using RotateFunction = void (*)(uint8_t*, const uint8_t*, size_t, bool);
+
+struct EncodeVersion
+{
+    const char* Name;
+    EncodeFunction EncodeRLE;
+    EncodeFunction EncodeRepeat;
+    RotateFunction Rotate;
+};
+
+static std::vector<EncodeVersion> get_encode_versions()
+{
+    std::vector<EncodeVersion> versions;
+    versions.push_back(
+        { "scalar", sawyercoding_encode_rle_scalar, sawyercoding_encode_repeat_scalar, sawyercoding_rotate_scalar });
+    if (sse41_available())
+    {
+        versions.push_back(
+            { "sse4_1", sawyercoding_encode_rle_sse4_1, sawyercoding_encode_repeat_sse4_1, sawyercoding_rotate_sse4_1 });
+    }
+    if (avx2_available())
+    {
+        versions.push_back({ "avx2", sawyercoding_encode_rle_avx2, sawyercoding_encode_repeat_avx2, sawyercoding_rotate_avx2 });
+    }
+    return versions;
+}
+
+/**
+ * Reads the chunks of a saved park back, so the encoders can be timed on what they get when saving it.
+ */
+static std::shared_ptr<ParkChunks> read_park_chunks(S6Exporter& s6exporter)
+{
+    MemoryStream stream;
+    s6exporter.SaveGame(&stream);
+    stream.SetPosition(0);
+
+    // The file ends with a checksum after the last chunk.
+    auto chunks = std::make_shared<ParkChunks>();
+    SawyerChunkReader reader(&stream);
+    while (stream.GetPosition() + sizeof(sawyercoding_chunk_header) < stream.GetLength())
+    {
+        auto chunk = reader.ReadChunk();
+        auto data = static_cast<const uint8_t*>(chunk->GetData());
+        chunks->emplace_back(data, data + chunk->GetLength());
+    }
+    return chunks;
+}
+
+static size_t get_chunks_length(const ParkChunks& chunks)
+{
+    size_t length = 0;
+    for (const auto& chunk : chunks)
+    {
+        length += chunk.size();
+    }
+    return length;
+}
+
+static void BM_encode(benchmark::State& state, std::shared_ptr<ParkChunks> chunks, EncodeFunction encode)
+{
+    const auto length = get_chunks_length(*chunks);
+    std::vector<uint8_t> buffer(length * 2 + 16);
+    for (auto _ : state)
+    {
+        for (const auto& chunk : *chunks)
+        {
+            benchmark::DoNotOptimize(encode(chunk.data(), buffer.data(), chunk.size()));
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * length);
+}
+
+static void BM_rotate(benchmark::State& state, std::shared_ptr<ParkChunks> chunks, RotateFunction rotate)
+{
+    const auto length = get_chunks_length(*chunks);
+    std::vector<uint8_t> buffer(length);
+    for (auto _ : state)
+    {
+        for (const auto& chunk : *chunks)
+        {
+            rotate(buffer.data(), chunk.data(), chunk.size(), false);
+        }
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    state.SetBytesProcessed(state.iterations() * length);
+}
+
+static void BM_decode(benchmark::State& state, std::shared_ptr<ParkChunks> chunks, uint8_t encoding)
+{
+    // Write every chunk of the park with the same encoding.
+    MemoryStream encoded;
+    for (const auto& chunk : *chunks)
+    {
+        sawyercoding_chunk_header header;
+        header.encoding = encoding;
+        header.length = static_cast<uint32_t>(chunk.size());
+        std::vector<uint8_t> buffer(sizeof(sawyercoding_chunk_header) + chunk.size() * 3 + 16);
+        encoded.Write(buffer.data(), sawyercoding_write_chunk_buffer(buffer.data(), chunk.data(), header));
+    }
+
+    for (auto _ : state)
+    {
+        encoded.SetPosition(0);
+        SawyerChunkReader reader(&encoded);
+        for (size_t i = 0; i < chunks->size(); i++)
+        {
+            benchmark::DoNotOptimize(reader.ReadChunk());
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * get_chunks_length(*chunks));
+}
+
+static void register_park_benchmarks(const std::string& parkFileName)
+{
+    if (!load_park(parkFileName))
+        return;
+
+    // Export right away, the park will be replaced by the next one before the benchmarks run.
+    auto s6exporter = std::make_shared<S6Exporter>();
+    s6exporter->RemoveTracklessRides = true;
+    s6exporter->Export();
+
+    auto parkName = Path::GetFileName(parkFileName);
+    auto name = "save/" + parkName;
+    benchmark::RegisterBenchmark(name.c_str(), BM_save, s6exporter)->Unit(benchmark::kMillisecond);
+
+    // Every version of the encoders on the chunks of the park, and decoding them again.
+    auto chunks = read_park_chunks(*s6exporter);
+    for (const auto& version : get_encode_versions())
+    {
+        auto versionName = std::string(version.Name) + "/" + parkName;
+        benchmark::RegisterBenchmark(("encode_rle/" + versionName).c_str(), BM_encode, chunks, version.EncodeRLE)
+            ->Unit(benchmark::kMicrosecond);
+        benchmark::RegisterBenchmark(("encode_repeat/" + versionName).c_str(), BM_encode, chunks, version.EncodeRepeat)
+            ->Unit(benchmark::kMicrosecond);
+        benchmark::RegisterBenchmark(("rotate/" + versionName).c_str(), BM_rotate, chunks, version.Rotate)
+            ->Unit(benchmark::kMicrosecond);
+    }
+    benchmark::RegisterBenchmark(("decode_rle/" + parkName).c_str(), BM_decode, chunks, CHUNK_ENCODING_RLE)
+        ->Unit(benchmark::kMicrosecond);
+    benchmark::RegisterBenchmark(
+        ("decode_rlecompressed/" + parkName).c_str(), BM_decode, chunks, CHUNK_ENCODING_RLECOMPRESSED)
+        ->Unit(benchmark::kMicrosecond);
+    benchmark::RegisterBenchmark(("decode_rotate/" + parkName).c_str(), BM_decode, chunks, CHUNK_ENCODING_ROTATE)
+        ->Unit(benchmark::kMicrosecond);
+}
+
+static int cmdline_for_bench_save(int argc, const char** argv)
+{
+    std::vector<char*> argv_for_benchmark;
+    auto parkFiles = split_benchmark_arguments(argc, argv, argv_for_benchmark);
+    if (parkFiles.empty())
+    {
+        log_error("No parks to benchmark!");
+        return -1;
+    }
+
+    core_init();
+    gOpenRCT2Headless = true;
+    auto context = OpenRCT2::CreateContext();
+    if (!context->Initialise())
+    {
+        log_error("Failed to initialise context!");
+        return -1;
+    }
+    for (const auto& parkFile : parkFiles)
+    {
+        register_park_benchmarks(parkFile);
+    }
+
+    argc = static_cast<int>(argv_for_benchmark.size());
+    ::benchmark::Initialize(&argc, &argv_for_benchmark[0]);
+    if (::benchmark::ReportUnrecognizedArguments(argc, &argv_for_benchmark[0]))
+        return -1;
+    ::benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
+
+static exitcode_t HandleBenchSave(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    int32_t result = cmdline_for_bench_save(argc, argv);
+    if (result < 0)
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+#else
+static exitcode_t HandleBenchSave(CommandLineArgEnumerator* argEnumerator)
+{
+    log_error("Sorry, Google benchmark not enabled in this build");
+    return EXITCODE_FAIL;
+}
+#endif // USE_BENCHMARK
+
+const CommandLineCommand CommandLine::BenchSaveCommands[]{
+#ifdef USE_BENCHMARK
+    DefineCommand(
+        "",
+        "[<file|directory>]... [--benchmark_list_tests={true|false}] [--benchmark_filter=<regex>] "
+        "[--benchmark_min_time=<min_time>] [--benchmark_repetitions=<num_repetitions>] "
+        "[--benchmark_report_aggregates_only={true|false}] [--benchmark_format=<console|json|csv>] "
+        "[--benchmark_out=<filename>] [--benchmark_out_format=<json|console|csv>] [--benchmark_color={auto|true|false}] "
+        "[--benchmark_counters_tabular={true|false}] [--v=<verbosity>]",
+        nullptr, HandleBenchSave),
+    CommandTableEnd
+#else
+    DefineCommand("", "*** SORRY NOT ENABLED IN THIS BUILD ***", nullptr, HandleBenchSave), CommandTableEnd
+#endif // USE_BENCHMARK
+};
@@ -0,0 +1,186 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "CommandLine.hpp"
+
+#if defined(USE_BENCHMARK) && !defined(DISABLE_NETWORK)
+
+#    include "../Context.h"
+#    include "../OpenRCT2.h"
+#    include "../network/NetworkConnection.h"
+#    include "../network/NetworkTypes.h"
+#    include "../network/network.h"
+#    include "../platform/platform.h"
+
+#    include <benchmark/benchmark.h>
+#    include <ctime>
+#    include <memory>
+#    include <vector>
+
+static constexpr uint16_t BENCH_PORT = 11763;
+// Each client sends a packet every this many updates, the rest of the time it is idle like most players are.
+static constexpr size_t CLIENT_SEND_INTERVAL = 16;
+
+/**
+ * Reads and discards everything the server sent to a client, returns false if the connection was lost.
+ */
+static bool drain_client(NetworkConnection& client)
+{
+    int32_t status;
+    while ((status = client.ReadPacket()) == NETWORK_READPACKET_SUCCESS || status == NETWORK_READPACKET_MORE_DATA)
+    {
+        if (status == NETWORK_READPACKET_SUCCESS)
+        {
+            client.InboundPacket.Clear();
+        }
+    }
+    return status != NETWORK_READPACKET_DISCONNECTED;
+}
+
+/**
+ * Updates the server with range(0) clients connected, reports the processor time each client costs an update.
+ */
+static void BM_server_update(benchmark::State& state)
+{
+    const size_t numClients = static_cast<size_t>(state.range(0));
+
+    std::vector<std::unique_ptr<NetworkConnection>> clients;
+    try
+    {
+        for (size_t i = 0; i < numClients; i++)
+        {
+            auto client = std::make_unique<NetworkConnection>();
+            client->Socket = CreateTcpSocket();
+            client->Socket->Connect("127.0.0.1", BENCH_PORT);
+            clients.push_back(std::move(client));
+        }
+    }
+    catch (const std::exception& e)
+    {
+        state.SkipWithError(e.what());
+        return;
+    }
+    // Accept them all.
+    network_update();
+
+    std::clock_t cpuTime = 0;
+    size_t update = 0;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        for (size_t i = update % CLIENT_SEND_INTERVAL; i < numClients; i += CLIENT_SEND_INTERVAL)
+        {
+            auto packet = NetworkPacket::Allocate();
+            *packet << static_cast<uint32_t>(NETWORK_COMMAND_PING);
+            clients[i]->QueuePacket(std::move(packet));
+            clients[i]->SendQueuedPackets();
+            if (!drain_client(*clients[i]))
+            {
+                state.SkipWithError("Lost a connection!");
+                break;
+            }
+        }
+        update++;
+        state.ResumeTiming();
+
+        std::clock_t start = std::clock();
+        network_update();
+        cpuTime += std::clock() - start;
+    }
+
+    if (state.iterations() > 0)
+    {
+        double cpuMicroseconds = static_cast<double>(cpuTime) * 1000000 / CLOCKS_PER_SEC;
+        state.counters["cpu_us_per_player"] = cpuMicroseconds / state.iterations() / numClients;
+    }
+
+    // Let the server drop the clients before the next run.
+    clients.clear();
+    network_update();
+    network_process_pending();
+}
+
+static int cmdline_for_bench_server(int argc, const char** argv)
+{
+    core_init();
+    gOpenRCT2Headless = true;
+    auto context = OpenRCT2::CreateContext();
+    if (!context->Initialise())
+    {
+        log_error("Failed to initialise context!");
+        return -1;
+    }
+    if (!network_begin_server(BENCH_PORT, "127.0.0.1"))
+    {
+        log_error("Failed to start server!");
+        return -1;
+    }
+
+    // Every client takes two sockets, one at each end, keep below the usual limit of open files.
+    benchmark::RegisterBenchmark("server_update", BM_server_update)
+        ->Arg(10)
+        ->Arg(100)
+        ->Arg(250)
+        ->Arg(450)
+        ->Unit(benchmark::kMicrosecond);
+
+    // Google benchmark does stuff to argv. It doesn't modify the pointees,
+    // but it wants to reorder the pointers, so present a copy of them.
+    std::vector<char*> argv_for_benchmark;
+
+    // argv[0] is expected to contain the binary name. It's only for logging purposes, don't bother.
+    argv_for_benchmark.push_back(nullptr);
+    for (int i = 0; i < argc; i++)
+    {
+        argv_for_benchmark.push_back(const_cast<char*>(argv[i]));
+    }
+
+    argc = static_cast<int>(argv_for_benchmark.size());
+    ::benchmark::Initialize(&argc, &argv_for_benchmark[0]);
+    if (::benchmark::ReportUnrecognizedArguments(argc, &argv_for_benchmark[0]))
+        return -1;
+    ::benchmark::RunSpecifiedBenchmarks();
+    network_close();
+    return 0;
+}
+
+static exitcode_t HandleBenchServer(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    int32_t result = cmdline_for_bench_server(argc, argv);
+    if (result < 0)
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+#else
+static exitcode_t HandleBenchServer(CommandLineArgEnumerator* argEnumerator)
+{
+    log_error("Sorry, Google benchmark or networking not enabled in this build");
+    return EXITCODE_FAIL;
+}
+#endif // USE_BENCHMARK && !DISABLE_NETWORK
+
+const CommandLineCommand CommandLine::BenchServerCommands[]{
+#if defined(USE_BENCHMARK) && !defined(DISABLE_NETWORK)
+    DefineCommand(
+        "",
+        "[--benchmark_list_tests={true|false}] [--benchmark_filter=<regex>] [--benchmark_min_time=<min_time>] "
+        "[--benchmark_repetitions=<num_repetitions>] [--benchmark_report_aggregates_only={true|false}] "
+        "[--benchmark_format=<console|json|csv>] [--benchmark_out=<filename>] [--benchmark_out_format=<json|console|csv>] "
+        "[--benchmark_color={auto|true|false}] [--benchmark_counters_tabular={true|false}] [--v=<verbosity>]",
+        nullptr, HandleBenchServer),
+    CommandTableEnd
+#else
+    DefineCommand("", "*** SORRY NOT ENABLED IN THIS BUILD ***", nullptr, HandleBenchServer), CommandTableEnd
+#endif // USE_BENCHMARK && !DISABLE_NETWORK
+};
@@ -0,0 +1,285 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "CommandLine.hpp"
+
+#ifdef USE_BENCHMARK
+
+#    include "../world/Map.h"
+#    include "../world/Sprite.h"
+
+#    include <algorithm>
+#    include <benchmark/benchmark.h>
+#    include <cstdint>
+#    include <cstdlib>
+#    include <vector>
+
+static constexpr int32_t BenchSpriteCount = MAX_SPRITES;
+static constexpr int32_t BenchQueryRadius = 96;
+
+static uint32_t bench_rand(uint32_t& state)
+{
+    state = state * 1103515245 + 12345;
+    return state >> 8;
+}
+
+/**
+ * Fills the sprite list with litter sprites scattered over a square of the given amount of tiles, the smaller the
+ * square the more sprites share a quadrant.
+ */
+static std::vector<SpriteBase*> create_bench_sprites(int32_t areaTiles)
+{
+    reset_sprite_list();
+
+    std::vector<SpriteBase*> sprites;
+    uint32_t seed = 0x1234;
+    const int32_t areaSize = areaTiles * COORDS_XY_STEP;
+    for (int32_t i = 0; i < BenchSpriteCount; i++)
+    {
+        auto sprite = create_sprite(SPRITE_IDENTIFIER_LITTER);
+        if (sprite == nullptr)
+            break;
+
+        auto& generic = sprite->generic;
+        generic.sprite_identifier = SPRITE_IDENTIFIER_LITTER;
+        generic.MoveTo({ COORDS_XY_STEP + static_cast<int32_t>(bench_rand(seed) % areaSize),
+                         COORDS_XY_STEP + static_cast<int32_t>(bench_rand(seed) % areaSize), 0 });
+        sprites.push_back(&generic);
+    }
+    return sprites;
+}
+
+static void BM_sprite_move(benchmark::State& state)
+{
+    const int32_t areaTiles = static_cast<int32_t>(state.range(0));
+    auto sprites = create_bench_sprites(areaTiles);
+    const int32_t areaSize = areaTiles * COORDS_XY_STEP;
+    uint32_t seed = 0x5678;
+    for (auto _ : state)
+    {
+        for (auto sprite : sprites)
+        {
+            // Random walk of up to half a tile, kept inside the area.
+            int32_t x = sprite->x + static_cast<int32_t>(bench_rand(seed) % 33) - 16;
+            int32_t y = sprite->y + static_cast<int32_t>(bench_rand(seed) % 33) - 16;
+            x = std::clamp(x, COORDS_XY_STEP, COORDS_XY_STEP + areaSize - 1);
+            y = std::clamp(y, COORDS_XY_STEP, COORDS_XY_STEP + areaSize - 1);
+            sprite->MoveTo({ x, y, sprite->z });
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * sprites.size());
+}
+
+// Walks the next_in_quadrant chains tile by tile, the way the game searched for nearby sprites before.
+static void BM_sprite_query_chain_walk(benchmark::State& state)
+{
+    const int32_t areaTiles = static_cast<int32_t>(state.range(0));
+    auto sprites = create_bench_sprites(areaTiles);
+    size_t found = 0;
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < sprites.size(); i += 16)
+        {
+            const auto centre = CoordsXY{ sprites[i]->x, sprites[i]->y };
+            for (int32_t x = floor2(centre.x - BenchQueryRadius, COORDS_XY_STEP); x <= centre.x + BenchQueryRadius;
+                 x += COORDS_XY_STEP)
+            {
+                for (int32_t y = floor2(centre.y - BenchQueryRadius, COORDS_XY_STEP); y <= centre.y + BenchQueryRadius;
+                     y += COORDS_XY_STEP)
+                {
+                    if (!map_is_location_valid({ x, y }))
+                        continue;
+
+                    for (uint16_t spriteIndex = sprite_get_first_in_quadrant(x, y); spriteIndex != SPRITE_INDEX_NULL;
+                         spriteIndex = get_sprite(spriteIndex)->generic.next_in_quadrant)
+                    {
+                        const auto& sprite = get_sprite(spriteIndex)->generic;
+                        if (std::abs(sprite.x - centre.x) <= BenchQueryRadius
+                            && std::abs(sprite.y - centre.y) <= BenchQueryRadius)
+                        {
+                            found++;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    benchmark::DoNotOptimize(found);
+    state.SetItemsProcessed(state.iterations() * (sprites.size() / 16));
+}
+
+// Scans the whole sprite list, the way staff_entertainer_update_nearby_peeps searched before.
+static void BM_sprite_query_list_scan(benchmark::State& state)
+{
+    const int32_t areaTiles = static_cast<int32_t>(state.range(0));
+    auto sprites = create_bench_sprites(areaTiles);
+    size_t found = 0;
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < sprites.size(); i += 16)
+        {
+            const auto centre = CoordsXY{ sprites[i]->x, sprites[i]->y };
+            for (uint16_t spriteIndex = gSpriteListHead[SPRITE_LIST_LITTER]; spriteIndex != SPRITE_INDEX_NULL;
+                 spriteIndex = get_sprite(spriteIndex)->generic.next)
+            {
+                const auto& sprite = get_sprite(spriteIndex)->generic;
+                if (std::abs(sprite.x - centre.x) <= BenchQueryRadius && std::abs(sprite.y - centre.y) <= BenchQueryRadius)
+                {
+                    found++;
+                }
+            }
+        }
+    }
+    benchmark::DoNotOptimize(found);
+    state.SetItemsProcessed(state.iterations() * (sprites.size() / 16));
+}
+
+static void BM_sprite_query_rect(benchmark::State& state)
+{
+    const int32_t areaTiles = static_cast<int32_t>(state.range(0));
+    auto sprites = create_bench_sprites(areaTiles);
+    size_t found = 0;
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < sprites.size(); i += 16)
+        {
+            const auto centre = CoordsXY{ sprites[i]->x, sprites[i]->y };
+            found += sprite_query_rect({ centre.x - BenchQueryRadius, centre.y - BenchQueryRadius,
+                                         centre.x + BenchQueryRadius, centre.y + BenchQueryRadius })
+                         .size();
+        }
+    }
+    benchmark::DoNotOptimize(found);
+    state.SetItemsProcessed(state.iterations() * (sprites.size() / 16));
+}
+
+static void BM_sprite_query_radius(benchmark::State& state)
+{
+    const int32_t areaTiles = static_cast<int32_t>(state.range(0));
+    auto sprites = create_bench_sprites(areaTiles);
+    size_t found = 0;
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < sprites.size(); i += 16)
+        {
+            found += sprite_query_radius({ sprites[i]->x, sprites[i]->y }, BenchQueryRadius).size();
+        }
+    }
+    benchmark::DoNotOptimize(found);
+    state.SetItemsProcessed(state.iterations() * (sprites.size() / 16));
+}
+
+// Scans the whole litter list, the way handymen looked for the nearest litter before.
+static void BM_litter_nearest_list_scan(benchmark::State& state)
+{
+    const int32_t areaTiles = static_cast<int32_t>(state.range(0));
+    auto sprites = create_bench_sprites(areaTiles);
+    size_t found = 0;
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < sprites.size(); i += 16)
+        {
+            const auto centre = CoordsXYZ{ sprites[i]->x, sprites[i]->y, sprites[i]->z };
+            uint16_t nearestLitterDist = 0xFFFF;
+            for (uint16_t spriteIndex = gSpriteListHead[SPRITE_LIST_LITTER]; spriteIndex != SPRITE_INDEX_NULL;
+                 spriteIndex = get_sprite(spriteIndex)->generic.next)
+            {
+                const auto& litter = get_sprite(spriteIndex)->litter;
+                uint16_t distance = std::abs(litter.x - centre.x) + std::abs(litter.y - centre.y)
+                    + std::abs(litter.z - centre.z) * 4;
+                nearestLitterDist = std::min(nearestLitterDist, distance);
+            }
+            found += nearestLitterDist <= BenchQueryRadius ? 1 : 0;
+        }
+    }
+    benchmark::DoNotOptimize(found);
+    state.SetItemsProcessed(state.iterations() * (sprites.size() / 16));
+}
+
+static void BM_litter_nearest(benchmark::State& state)
+{
+    const int32_t areaTiles = static_cast<int32_t>(state.range(0));
+    auto sprites = create_bench_sprites(areaTiles);
+    size_t found = 0;
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < sprites.size(); i += 16)
+        {
+            const auto centre = CoordsXYZ{ sprites[i]->x, sprites[i]->y, sprites[i]->z };
+            found += litter_get_nearest(centre, BenchQueryRadius) != nullptr ? 1 : 0;
+        }
+    }
+    benchmark::DoNotOptimize(found);
+    state.SetItemsProcessed(state.iterations() * (sprites.size() / 16));
+}
+
+static int cmdline_for_bench_spatial_index(int argc, const char** argv)
+{
+    // Area sizes in tiles: a spread out park and a crowded one.
+    benchmark::RegisterBenchmark("sprite_move", BM_sprite_move)->Arg(128)->Arg(16);
+    benchmark::RegisterBenchmark("sprite_query_chain_walk", BM_sprite_query_chain_walk)->Arg(128)->Arg(16);
+    benchmark::RegisterBenchmark("sprite_query_list_scan", BM_sprite_query_list_scan)->Arg(128)->Arg(16);
+    benchmark::RegisterBenchmark("sprite_query_rect", BM_sprite_query_rect)->Arg(128)->Arg(16);
+    benchmark::RegisterBenchmark("sprite_query_radius", BM_sprite_query_radius)->Arg(128)->Arg(16);
+    benchmark::RegisterBenchmark("litter_nearest_list_scan", BM_litter_nearest_list_scan)->Arg(128)->Arg(16);
+    benchmark::RegisterBenchmark("litter_nearest", BM_litter_nearest)->Arg(128)->Arg(16);
+
+    // Google benchmark does stuff to argv. It doesn't modify the pointees,
+    // but it wants to reorder the pointers, so present a copy of them.
+    std::vector<char*> argv_for_benchmark;
+
+    // argv[0] is expected to contain the binary name. It's only for logging purposes, don't bother.
+    argv_for_benchmark.push_back(nullptr);
+    for (int i = 0; i < argc; i++)
+    {
+        argv_for_benchmark.push_back(const_cast<char*>(argv[i]));
+    }
+
+    argc = static_cast<int>(argv_for_benchmark.size());
+    ::benchmark::Initialize(&argc, &argv_for_benchmark[0]);
+    if (::benchmark::ReportUnrecognizedArguments(argc, &argv_for_benchmark[0]))
+        return -1;
+    ::benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
+
+static exitcode_t HandleBenchSpatialIndex(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    int32_t result = cmdline_for_bench_spatial_index(argc, argv);
+    if (result < 0)
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+#else
+static exitcode_t HandleBenchSpatialIndex(CommandLineArgEnumerator* argEnumerator)
+{
+    log_error("Sorry, Google benchmark not enabled in this build");
+    return EXITCODE_FAIL;
+}
+#endif // USE_BENCHMARK
+
+const CommandLineCommand CommandLine::BenchSpatialIndexCommands[]{
+#ifdef USE_BENCHMARK
+    DefineCommand(
+        "",
+        "[--benchmark_list_tests={true|false}] [--benchmark_filter=<regex>] [--benchmark_min_time=<min_time>] "
+        "[--benchmark_repetitions=<num_repetitions>] [--benchmark_report_aggregates_only={true|false}] "
+        "[--benchmark_format=<console|json|csv>] [--benchmark_out=<filename>] [--benchmark_out_format=<json|console|csv>] "
+        "[--benchmark_color={auto|true|false}] [--benchmark_counters_tabular={true|false}] [--v=<verbosity>]",
+        nullptr, HandleBenchSpatialIndex),
+    CommandTableEnd
+#else
+    DefineCommand("", "*** SORRY NOT ENABLED IN THIS BUILD ***", nullptr, HandleBenchSpatialIndex), CommandTableEnd
+#endif // USE_BENCHMARK
+};
@@ -11,13 +11,16 @@
 
 #ifdef USE_BENCHMARK
 
+#    include "BenchCommon.h"
+
 #    include "../Context.h"
 #    include "../Game.h"
-#    include "../Intro.h"
 #    include "../OpenRCT2.h"
 #    include "../audio/audio.h"
 #    include "../core/Console.hpp"
 #    include "../core/Imaging.h"
+#    include "../core/Path.hpp"
+#    include "../core/String.hpp"
 #    include "../drawing/Drawing.h"
 #    include "../interface/Viewport.h"
 #    include "../localisation/Localisation.h"
@@ -29,175 +32,238 @@
 #    include "../world/Park.h"
 #    include "../world/Surface.h"
 
+#    include <algorithm>
 #    include <benchmark/benchmark.h>
 #    include <cstdint>
 #    include <iterator>
+#    include <memory>
+#    include <string>
 #    include <vector>
 
-static void fixup_pointers(paint_session* s, size_t paint_session_entries, size_t paint_struct_entries, size_t quadrant_entries)
+static void fixup_pointers(std::vector<RecordedPaintSession>& s)
 {
-    for (size_t i = 0; i < paint_session_entries; i++)
+    for (auto& recordedSession : s)
     {
-        for (size_t j = 0; j < paint_struct_entries; j++)
+        auto& entries = recordedSession.Entries;
+        const auto paintStructsSize = entries.size();
+        for (auto& ps : entries)
         {
-            if (s[i].PaintStructs[j].basic.next_quadrant_ps == (paint_struct*)paint_struct_entries)
-            {
-                s[i].PaintStructs[j].basic.next_quadrant_ps = nullptr;
-            }
-            else
-            {
-                auto nextQuadrantPs = reinterpret_cast<uintptr_t>(s[i].PaintStructs[j].basic.next_quadrant_ps);
-                s[i].PaintStructs[j].basic.next_quadrant_ps = &s[i].PaintStructs[nextQuadrantPs].basic;
-            }
+            auto nextQuadrantPs = reinterpret_cast<size_t>(ps.basic.next_quadrant_ps);
+            ps.basic.next_quadrant_ps = nextQuadrantPs == paintStructsSize ? nullptr : &entries[nextQuadrantPs].basic;
         }
-        for (size_t j = 0; j < quadrant_entries; j++)
+        for (auto& quad : recordedSession.Session.Quadrants)
         {
-            if (s[i].Quadrants[j] == (paint_struct*)quadrant_entries)
-            {
-                s[i].Quadrants[j] = nullptr;
-            }
-            else
-            {
-                s[i].Quadrants[j] = &s[i].PaintStructs[(size_t)s[i].Quadrants[j]].basic;
-            }
+            auto quadIndex = reinterpret_cast<size_t>(quad);
+            quad = quadIndex == paintStructsSize ? nullptr : &entries[quadIndex].basic;
         }
     }
 }
 
-static std::vector<paint_session> extract_paint_session(const std::string parkFileName)
+/**
+ * Paints the whole map of the loaded park at the given zoom level and rotation, recording the sessions.
+ */
+static std::vector<RecordedPaintSession> extract_paint_session(ZoomLevel zoom, uint8_t rotation)
 {
-    core_init();
-    gOpenRCT2Headless = true;
-    auto context = OpenRCT2::CreateContext();
-    std::vector<paint_session> sessions;
-    log_info("Starting...");
-    if (context->Initialise())
-    {
-        drawing_engine_init();
-        if (!context->LoadParkFromFile(parkFileName))
-        {
-            log_error("Failed to load park!");
-            return {};
-        }
+    std::vector<RecordedPaintSession> sessions;
 
-        gIntroState = INTRO_STATE_NONE;
-        gScreenFlags = SCREEN_FLAGS_PLAYING;
+    int32_t mapSize = gMapSize;
+    int32_t viewWidth = (mapSize * 32 * 2);
+    int32_t viewHeight = (mapSize * 32 * 1);
 
-        int32_t mapSize = gMapSize;
-        int32_t resolutionWidth = (mapSize * 32 * 2);
-        int32_t resolutionHeight = (mapSize * 32 * 1);
+    viewWidth += 8;
+    viewHeight += 128;
 
-        resolutionWidth += 8;
-        resolutionHeight += 128;
+    rct_viewport viewport;
+    viewport.pos = { 0, 0 };
+    viewport.width = viewWidth / zoom;
+    viewport.height = viewHeight / zoom;
+    viewport.view_width = viewWidth;
+    viewport.view_height = viewHeight;
+    viewport.var_11 = 0;
+    viewport.flags = 0;
 
-        rct_viewport viewport;
-        viewport.pos = { 0, 0 };
-        viewport.width = resolutionWidth;
-        viewport.height = resolutionHeight;
-        viewport.view_width = viewport.width;
-        viewport.view_height = viewport.height;
-        viewport.var_11 = 0;
-        viewport.flags = 0;
+    int32_t customX = (gMapSize / 2) * 32 + 16;
+    int32_t customY = (gMapSize / 2) * 32 + 16;
+    int32_t customZ = tile_element_height({ customX, customY });
+    auto centre = translate_3d_to_2d_with_z(rotation, { customX, customY, customZ });
 
-        int32_t customX = (gMapSize / 2) * 32 + 16;
-        int32_t customY = (gMapSize / 2) * 32 + 16;
+    viewport.viewPos = { centre.x - ((viewport.view_width) / 2), centre.y - ((viewport.view_height) / 2) };
+    viewport.zoom = zoom;
+    gCurrentRotation = rotation;
 
-        int32_t x = 0, y = 0;
-        int32_t z = tile_element_height({ customX, customY });
-        x = customY - customX;
-        y = ((customX + customY) / 2) - z;
+    // Ensure sprites appear regardless of rotation
+    reset_all_sprite_quadrant_placements();
 
-        viewport.viewPos = { x - ((viewport.view_width) / 2), y - ((viewport.view_height) / 2) };
-        viewport.zoom = 0;
-        gCurrentRotation = 0;
+    rct_drawpixelinfo dpi;
+    dpi.x = 0;
+    dpi.y = 0;
+    dpi.width = viewport.width;
+    dpi.height = viewport.height;
+    dpi.pitch = 0;
+    dpi.bits = static_cast<uint8_t*>(malloc(dpi.width * dpi.height));
 
-        // Ensure sprites appear regardless of rotation
-        reset_all_sprite_quadrant_placements();
+    viewport_render(&dpi, &viewport, 0, 0, viewport.width, viewport.height, &sessions);
 
-        rct_drawpixelinfo dpi;
-        dpi.x = 0;
-        dpi.y = 0;
-        dpi.width = resolutionWidth;
-        dpi.height = resolutionHeight;
-        dpi.pitch = 0;
-        dpi.bits = static_cast<uint8_t*>(malloc(dpi.width * dpi.height));
+    free(dpi.bits);
+    return sessions;
+}
+
+/**
+ * Restores sessions to how they were recorded, copying the entries into the existing buffers so the pointers set up by
+ * fixup_pointers stay valid.
+ */
+static void restore_paint_sessions(
+    std::vector<RecordedPaintSession>& sessions, const std::vector<RecordedPaintSession>& originalSessions)
+{
+    for (size_t i = 0; i < std::size(sessions); i++)
+    {
+        sessions[i].Session = originalSessions[i].Session;
+        std::copy(originalSessions[i].Entries.cbegin(), originalSessions[i].Entries.cend(), sessions[i].Entries.begin());
+    }
+}
 
-        log_info("Obtaining sprite data...");
-        viewport_render(&dpi, &viewport, 0, 0, viewport.width, viewport.height, &sessions);
+/**
+ * Checks paint_session_arrange puts the paint structs in the same order as the reference implementation.
+ */
+static bool verify_paint_session_arrange(const std::vector<RecordedPaintSession>& inputSessions)
+{
+    std::vector<RecordedPaintSession> sessions = inputSessions;
+    std::vector<RecordedPaintSession> referenceSessions = inputSessions;
+    fixup_pointers(sessions);
+    fixup_pointers(referenceSessions);
+    for (size_t i = 0; i < std::size(sessions); i++)
+    {
+        paint_session_arrange(&sessions[i].Session);
+        paint_session_arrange_reference(&referenceSessions[i].Session);
 
-        free(dpi.bits);
-        drawing_engine_dispose();
+        const paint_struct* ps = sessions[i].Session.PaintHead.next_quadrant_ps;
+        const paint_struct* referencePs = referenceSessions[i].Session.PaintHead.next_quadrant_ps;
+        while (ps != nullptr && referencePs != nullptr)
+        {
+            auto index = reinterpret_cast<const paint_entry*>(ps) - sessions[i].Entries.data();
+            auto referenceIndex = reinterpret_cast<const paint_entry*>(referencePs) - referenceSessions[i].Entries.data();
+            if (index != referenceIndex)
+                return false;
+            ps = ps->next_quadrant_ps;
+            referencePs = referencePs->next_quadrant_ps;
+        }
+        if (ps != referencePs)
+            return false;
     }
-    log_info("Got %u paint sessions.", std::size(sessions));
-    return sessions;
+    return true;
 }
 
 // This function is based on benchgfx_render_screenshots
-static void BM_paint_session_arrange(benchmark::State& state, const std::vector<paint_session> inputSessions)
+static void BM_paint_session_arrange(
+    benchmark::State& state, const std::vector<RecordedPaintSession> inputSessions, void (*arrange)(paint_session*))
 {
-    std::vector<paint_session> sessions = inputSessions;
+    std::vector<RecordedPaintSession> sessions = inputSessions;
     // Fixing up the pointers continuously is wasteful. Fix it up once for `sessions` and store a copy.
     // Keep in mind we need bit-exact copy, as the lists use pointers.
     // Once sorted, just restore the copy with the original fixed-up version.
-    paint_session* local_s = new paint_session[std::size(sessions)];
-    fixup_pointers(&sessions[0], std::size(sessions), std::size(local_s->PaintStructs), std::size(local_s->Quadrants));
-    std::copy_n(sessions.cbegin(), std::size(sessions), local_s);
+    fixup_pointers(sessions);
+    const std::vector<RecordedPaintSession> local_s = sessions;
     for (auto _ : state)
     {
         state.PauseTiming();
-        std::copy_n(local_s, std::size(sessions), sessions.begin());
+        restore_paint_sessions(sessions, local_s);
         state.ResumeTiming();
-        paint_session_arrange(&sessions[0]);
+        for (auto& recordedSession : sessions)
+        {
+            arrange(&recordedSession.Session);
+        }
         benchmark::DoNotOptimize(sessions);
     }
     state.SetItemsProcessed(state.iterations() * std::size(sessions));
-    delete[] local_s;
+}
+
+static void register_paint_session_benchmarks(const std::string& name, const std::vector<RecordedPaintSession>& sessions)
+{
+    benchmark::RegisterBenchmark(("arrange/" + name).c_str(), BM_paint_session_arrange, sessions, paint_session_arrange);
+    benchmark::RegisterBenchmark(
+        ("arrange_reference/" + name).c_str(), BM_paint_session_arrange, sessions, paint_session_arrange_reference);
+}
+
+/**
+ * Records the paint sessions of a park at all benchmarked zoom levels and rotations and registers benchmarks for them.
+ */
+static void register_park_benchmarks(const std::string& parkFileName)
+{
+    if (!load_park(parkFileName))
+        return;
+
+    const auto parkName = Path::GetFileName(parkFileName);
+    for (int8_t zoom = 0; zoom <= 2; zoom++)
+    {
+        for (uint8_t rotation = 0; rotation < 4; rotation++)
+        {
+            log_info("Obtaining sprite data for %s at zoom %d, rotation %u...", parkName.c_str(), zoom, rotation);
+            std::vector<RecordedPaintSession> sessions = extract_paint_session(zoom, rotation);
+            if (sessions.empty())
+                continue;
+
+            log_info("Got %u paint sessions.", std::size(sessions));
+            if (!verify_paint_session_arrange(sessions))
+            {
+                log_error("paint_session_arrange differs from the reference for %s!", parkName.c_str());
+            }
+
+            auto name = String::StdFormat("%s/zoom:%d/rotation:%u", parkName.c_str(), zoom, rotation);
+            register_paint_session_benchmarks(name, sessions);
+        }
+    }
 }
 
 static int cmdline_for_bench_sprite_sort(int argc, const char** argv)
 {
     {
         // Register some basic "baseline" benchmark
-        std::vector<paint_session> sessions(1);
-        for (auto& ps : sessions[0].PaintStructs)
+        std::vector<RecordedPaintSession> sessions(1);
+        sessions[0].Entries.resize(4000);
+        for (auto& ps : sessions[0].Entries)
         {
-            ps.basic.next_quadrant_ps = (paint_struct*)(std::size(sessions[0].PaintStructs));
+            ps.basic.next_quadrant_ps = (paint_struct*)(std::size(sessions[0].Entries));
         }
-        for (auto& quad : sessions[0].Quadrants)
+        for (auto& quad : sessions[0].Session.Quadrants)
         {
-            quad = (paint_struct*)(std::size(sessions[0].Quadrants));
+            quad = (paint_struct*)(std::size(sessions[0].Entries));
         }
-        benchmark::RegisterBenchmark("baseline", BM_paint_session_arrange, sessions);
+        register_paint_session_benchmarks("baseline", sessions);
     }
 
-    // Google benchmark does stuff to argv. It doesn't modify the pointees,
-    // but it wants to reorder the pointers, so present a copy of them.
     std::vector<char*> argv_for_benchmark;
+    auto parkFiles = split_benchmark_arguments(argc, argv, argv_for_benchmark);
 
-    // argv[0] is expected to contain the binary name. It's only for logging purposes, don't bother.
-    argv_for_benchmark.push_back(nullptr);
-
-    // Extract file names from argument list. If there is no such file, consider it benchmark option.
-    for (int i = 0; i < argc; i++)
+    std::unique_ptr<OpenRCT2::IContext> context;
+    if (!parkFiles.empty())
     {
-        if (platform_file_exists(argv[i]))
+        core_init();
+        gOpenRCT2Headless = true;
+        context = OpenRCT2::CreateContext();
+        log_info("Starting...");
+        if (!context->Initialise())
         {
-            // Register benchmark for sv6 if valid
-            std::vector<paint_session> sessions = extract_paint_session(argv[i]);
-            if (!sessions.empty())
-                benchmark::RegisterBenchmark(argv[i], BM_paint_session_arrange, sessions);
+            log_error("Failed to initialise context!");
+            return -1;
         }
-        else
+        drawing_engine_init();
+        for (const auto& parkFile : parkFiles)
         {
-            argv_for_benchmark.push_back(const_cast<char*>(argv[i]));
+            register_park_benchmarks(parkFile);
         }
     }
+
     // Update argc with all the changes made
     argc = static_cast<int>(argv_for_benchmark.size());
     ::benchmark::Initialize(&argc, &argv_for_benchmark[0]);
     if (::benchmark::ReportUnrecognizedArguments(argc, &argv_for_benchmark[0]))
         return -1;
     ::benchmark::RunSpecifiedBenchmarks();
+
+    if (context != nullptr)
+    {
+        drawing_engine_dispose();
+    }
     return 0;
 }
 
@@ -225,8 +291,9 @@ const CommandLineCommand CommandLine::BenchSpriteSortCommands[]{
 #ifdef USE_BENCHMARK
     DefineCommand(
         "",
-        "[<file>]... [--benchmark_list_tests={true|false}] [--benchmark_filter=<regex>] [--benchmark_min_time=<min_time>] "
-        "[--benchmark_repetitions=<num_repetitions>] [--benchmark_report_aggregates_only={true|false}] "
+        "[<file|directory>]... [--benchmark_list_tests={true|false}] [--benchmark_filter=<regex>] "
+        "[--benchmark_min_time=<min_time>] [--benchmark_repetitions=<num_repetitions>] "
+        "[--benchmark_report_aggregates_only={true|false}] "
         "[--benchmark_format=<console|json|csv>] [--benchmark_out=<filename>] [--benchmark_out_format=<json|console|csv>] "
         "[--benchmark_color={auto|true|false}] [--benchmark_counters_tabular={true|false}] [--v=<verbosity>]",
         nullptr, HandleBenchSpriteSort),
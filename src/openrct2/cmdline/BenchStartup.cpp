@@ -0,0 +1,178 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "CommandLine.hpp"
+
+#ifdef USE_BENCHMARK
+
+#    include "../Context.h"
+#    include "../OpenRCT2.h"
+#    include "../drawing/Drawing.h"
+#    include "../drawing/Font.h"
+#    include "../platform/platform.h"
+
+#    include <algorithm>
+#    include <benchmark/benchmark.h>
+#    include <cstdio>
+#    include <vector>
+
+#    ifdef __linux__
+#        include <unistd.h>
+#    endif
+
+/**
+ * Gets how many bytes of memory the process has resident, 0 where that is not known.
+ */
+static size_t get_resident_memory()
+{
+    size_t resident = 0;
+#    ifdef __linux__
+    FILE* statm = std::fopen("/proc/self/statm", "r");
+    if (statm != nullptr)
+    {
+        unsigned long size;
+        unsigned long residentPages;
+        if (std::fscanf(statm, "%lu %lu", &size, &residentPages) == 2)
+        {
+            resident = residentPages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        }
+        std::fclose(statm);
+    }
+#    endif
+    return resident;
+}
+
+static void set_resident_counter(benchmark::State& state, size_t residentBefore)
+{
+    size_t residentAfter = get_resident_memory();
+    if (residentAfter != 0)
+    {
+        state.counters["resident_kb"] = static_cast<double>(residentAfter - std::min(residentBefore, residentAfter)) / 1024;
+    }
+}
+
+/**
+ * Creates and initialises a context the way a headless server does.
+ */
+static void BM_startup_headless(benchmark::State& state)
+{
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+    for (auto _ : state)
+    {
+        size_t residentBefore = get_resident_memory();
+        auto context = OpenRCT2::CreateContext();
+        if (!context->Initialise())
+        {
+            state.SkipWithError("Failed to initialise context!");
+            return;
+        }
+        state.PauseTiming();
+        set_resident_counter(state, residentBefore);
+        context = nullptr;
+        state.ResumeTiming();
+    }
+}
+
+/**
+ * Loads the graphics files and the font sprites, everything a client adds to the startup of a headless server.
+ */
+static void BM_startup_graphics(benchmark::State& state)
+{
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+    auto context = OpenRCT2::CreateContext();
+    if (!context->Initialise())
+    {
+        state.SkipWithError("Failed to initialise context!");
+        return;
+    }
+
+    gOpenRCT2NoGraphics = false;
+    for (auto _ : state)
+    {
+        size_t residentBefore = get_resident_memory();
+        if (!gfx_load_g1(*context->GetPlatformEnvironment()))
+        {
+            state.SkipWithError("Failed to load g1.dat!");
+            break;
+        }
+        gfx_load_g2();
+        gfx_load_csg();
+        font_sprite_initialise_characters();
+
+        state.PauseTiming();
+        set_resident_counter(state, residentBefore);
+        gfx_unload_csg();
+        gfx_unload_g2();
+        gfx_unload_g1();
+        state.ResumeTiming();
+    }
+    gOpenRCT2NoGraphics = true;
+}
+
+static int cmdline_for_bench_startup(int argc, const char** argv)
+{
+    core_init();
+    benchmark::RegisterBenchmark("startup_headless", BM_startup_headless)->Unit(benchmark::kMillisecond)->UseRealTime();
+    benchmark::RegisterBenchmark("startup_graphics", BM_startup_graphics)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+    // Google benchmark does stuff to argv. It doesn't modify the pointees,
+    // but it wants to reorder the pointers, so present a copy of them.
+    std::vector<char*> argv_for_benchmark;
+
+    // argv[0] is expected to contain the binary name. It's only for logging purposes, don't bother.
+    argv_for_benchmark.push_back(nullptr);
+    for (int i = 0; i < argc; i++)
+    {
+        argv_for_benchmark.push_back(const_cast<char*>(argv[i]));
+    }
+
+    argc = static_cast<int>(argv_for_benchmark.size());
+    ::benchmark::Initialize(&argc, &argv_for_benchmark[0]);
+    if (::benchmark::ReportUnrecognizedArguments(argc, &argv_for_benchmark[0]))
+        return -1;
+    ::benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
+
+static exitcode_t HandleBenchStartup(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    int32_t result = cmdline_for_bench_startup(argc, argv);
+    if (result < 0)
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+#else
+static exitcode_t HandleBenchStartup(CommandLineArgEnumerator* argEnumerator)
+{
+    log_error("Sorry, Google benchmark not enabled in this build");
+    return EXITCODE_FAIL;
+}
+#endif // USE_BENCHMARK
+
+const CommandLineCommand CommandLine::BenchStartupCommands[]{
+#ifdef USE_BENCHMARK
+    DefineCommand(
+        "",
+        "[--benchmark_list_tests={true|false}] [--benchmark_filter=<regex>] [--benchmark_min_time=<min_time>] "
+        "[--benchmark_repetitions=<num_repetitions>] [--benchmark_report_aggregates_only={true|false}] "
+        "[--benchmark_format=<console|json|csv>] [--benchmark_out=<filename>] [--benchmark_out_format=<json|console|csv>] "
+        "[--benchmark_color={auto|true|false}] [--benchmark_counters_tabular={true|false}] [--v=<verbosity>]",
+        nullptr, HandleBenchStartup),
+    CommandTableEnd
+#else
+    DefineCommand("", "*** SORRY NOT ENABLED IN THIS BUILD ***", nullptr, HandleBenchStartup), CommandTableEnd
+#endif // USE_BENCHMARK
+};
@@ -0,0 +1,115 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "CommandLine.hpp"
+
+#ifdef USE_BENCHMARK
+
+#    include "BenchCommon.h"
+
+#    include "../Context.h"
+#    include "../Game.h"
+#    include "../OpenRCT2.h"
+#    include "../core/Path.hpp"
+#    include "../platform/platform.h"
+#    include "../ride/Vehicle.h"
+#    include "../world/Sprite.h"
+
+#    include <benchmark/benchmark.h>
+#    include <memory>
+#    include <string>
+#    include <vector>
+
+/**
+ * Moves all the trains of a park along their tracks for a tick, reports the time each car takes.
+ */
+static void BM_vehicle_update_all(benchmark::State& state, const std::string& parkFileName)
+{
+    if (!load_park(parkFileName))
+    {
+        state.SkipWithError("Failed to load park!");
+        return;
+    }
+
+    const uint16_t numCars = gSpriteListCount[SPRITE_LIST_VEHICLE];
+    for (auto _ : state)
+    {
+        vehicle_update_all();
+    }
+    state.SetItemsProcessed(state.iterations() * numCars);
+    state.counters["cars"] = numCars;
+}
+
+static int cmdline_for_bench_track_motion(int argc, const char** argv)
+{
+    std::vector<char*> argv_for_benchmark;
+    auto parkFiles = split_benchmark_arguments(argc, argv, argv_for_benchmark);
+    if (parkFiles.empty())
+    {
+        log_error("No parks to benchmark!");
+        return -1;
+    }
+
+    core_init();
+    gOpenRCT2Headless = true;
+    auto context = OpenRCT2::CreateContext();
+    if (!context->Initialise())
+    {
+        log_error("Failed to initialise context!");
+        return -1;
+    }
+    for (const auto& parkFile : parkFiles)
+    {
+        auto name = "vehicle_update_all/" + Path::GetFileName(parkFile);
+        benchmark::RegisterBenchmark(name.c_str(), BM_vehicle_update_all, parkFile)->Unit(benchmark::kMicrosecond);
+    }
+
+    argc = static_cast<int>(argv_for_benchmark.size());
+    ::benchmark::Initialize(&argc, &argv_for_benchmark[0]);
+    if (::benchmark::ReportUnrecognizedArguments(argc, &argv_for_benchmark[0]))
+        return -1;
+    ::benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
+
+static exitcode_t HandleBenchTrackMotion(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    int32_t result = cmdline_for_bench_track_motion(argc, argv);
+    if (result < 0)
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+#else
+static exitcode_t HandleBenchTrackMotion(CommandLineArgEnumerator* argEnumerator)
+{
+    log_error("Sorry, Google benchmark not enabled in this build");
+    return EXITCODE_FAIL;
+}
+#endif // USE_BENCHMARK
+
+const CommandLineCommand CommandLine::BenchTrackMotionCommands[]{
+#ifdef USE_BENCHMARK
+    DefineCommand(
+        "",
+        "[<file|directory>]... [--benchmark_list_tests={true|false}] [--benchmark_filter=<regex>] "
+        "[--benchmark_min_time=<min_time>] [--benchmark_repetitions=<num_repetitions>] "
+        "[--benchmark_report_aggregates_only={true|false}] [--benchmark_format=<console|json|csv>] "
+        "[--benchmark_out=<filename>] [--benchmark_out_format=<json|console|csv>] [--benchmark_color={auto|true|false}] "
+        "[--benchmark_counters_tabular={true|false}] [--v=<verbosity>]",
+        nullptr, HandleBenchTrackMotion),
+    CommandTableEnd
+#else
+    DefineCommand("", "*** SORRY NOT ENABLED IN THIS BUILD ***", nullptr, HandleBenchTrackMotion), CommandTableEnd
+#endif // USE_BENCHMARK
+};
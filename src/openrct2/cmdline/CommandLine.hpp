@@ -118,6 +118,15 @@ namespace CommandLine
     extern const CommandLineCommand SpriteCommands[];
     extern const CommandLineCommand BenchGfxCommands[];
     extern const CommandLineCommand BenchSpriteSortCommands[];
+    extern const CommandLineCommand BenchSpatialIndexCommands[];
+    extern const CommandLineCommand BenchJobsCommands[];
+    extern const CommandLineCommand BenchSaveCommands[];
+    extern const CommandLineCommand BenchStartupCommands[];
+    extern const CommandLineCommand BenchMapTransferCommands[];
+    extern const CommandLineCommand BenchPacketFanOutCommands[];
+    extern const CommandLineCommand BenchServerCommands[];
+    extern const CommandLineCommand BenchTrackMotionCommands[];
+    extern const CommandLineCommand BenchRideRatingsCommands[];
     extern const CommandLineCommand SimulateCommands[];
 
     extern const CommandLineExample RootExamples[];
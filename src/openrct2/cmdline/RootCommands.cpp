@@ -140,6 +140,15 @@ const CommandLineCommand CommandLine::RootCommands[]
     DefineSubCommand("sprite",          CommandLine::SpriteCommands           ),
     DefineSubCommand("benchgfx",        CommandLine::BenchGfxCommands         ),
     DefineSubCommand("benchspritesort", CommandLine::BenchSpriteSortCommands  ),
+    DefineSubCommand("benchspatialindex", CommandLine::BenchSpatialIndexCommands),
+    DefineSubCommand("benchjobs",       CommandLine::BenchJobsCommands        ),
+    DefineSubCommand("benchsave",       CommandLine::BenchSaveCommands        ),
+    DefineSubCommand("benchstartup",    CommandLine::BenchStartupCommands     ),
+    DefineSubCommand("benchmaptransfer", CommandLine::BenchMapTransferCommands),
+    DefineSubCommand("benchpacketfanout", CommandLine::BenchPacketFanOutCommands),
+    DefineSubCommand("benchserver",     CommandLine::BenchServerCommands      ),
+    DefineSubCommand("benchtrackmotion", CommandLine::BenchTrackMotionCommands),
+    DefineSubCommand("benchratings",    CommandLine::BenchRideRatingsCommands ),
     DefineSubCommand("simulate",        CommandLine::SimulateCommands         ),
     CommandTableEnd
 };
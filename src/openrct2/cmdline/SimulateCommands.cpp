@@ -7,6 +7,7 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 
+#include "../Cheats.h"
 #include "../Context.h"
 #include "../Game.h"
 #include "../GameState.h"
@@ -14,18 +15,31 @@
 #include "../core/Console.hpp"
 #include "../network/network.h"
 #include "../platform/platform.h"
+#include "../world/FootpathGraph.h"
 #include "../world/Sprite.h"
 #include "CommandLine.hpp"
 
+#include <chrono>
 #include <cstdlib>
 #include <memory>
 
 using namespace OpenRCT2;
 
+static bool _fastPathfinding = false;
+
+// clang-format off
+static constexpr const CommandLineOptionDefinition SimulateOptions[]
+{
+    { CMDLINE_TYPE_SWITCH, &_fastPathfinding, NAC, "fast-pathfinding", "use fast guest pathfinding and report its cache" },
+    OptionTableEnd
+};
+// clang-format on
+
 static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator);
 
 const CommandLineCommand CommandLine::SimulateCommands[]{ // Main commands
-                                                          DefineCommand("", "<ticks>", nullptr, HandleSimulate), CommandTableEnd
+                                                          DefineCommand("", "<ticks>", SimulateOptions, HandleSimulate),
+                                                          CommandTableEnd
 };
 
 static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator)
@@ -58,12 +72,30 @@ static exitcode_t HandleSimulate(CommandLineArgEnumerator* argEnumerator)
             return EXITCODE_FAIL;
         }
 
+        if (_fastPathfinding)
+        {
+            gCheatsFastPathfinding = true;
+        }
+        footpath_graph_reset_cache_stats();
+
         Console::WriteLine("Running %d ticks...", ticks);
+        auto startTime = std::chrono::high_resolution_clock::now();
         for (uint32_t i = 0; i < ticks; i++)
         {
             context->GetGameState()->UpdateLogic();
         }
+        auto duration = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - startTime);
         Console::WriteLine("Completed: %s", sprite_checksum().ToString().c_str());
+        Console::WriteLine(
+            "Took %.3f seconds, %.1f ticks/sec", duration.count(), duration.count() > 0 ? ticks / duration.count() : 0.0);
+        if (gCheatsFastPathfinding)
+        {
+            auto stats = footpath_graph_get_cache_stats();
+            Console::WriteLine(
+                "Path distance cache: %llu hits, %llu misses, %.3f seconds building, an estimated %.3f seconds saved",
+                static_cast<unsigned long long>(stats.Hits), static_cast<unsigned long long>(stats.Misses),
+                stats.SecondsBuilding, stats.EstimatedSecondsSaved);
+        }
     }
     else
     {
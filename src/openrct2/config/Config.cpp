@@ -140,6 +140,7 @@ namespace Config
             model->always_show_gridlines = reader->GetBoolean("always_show_gridlines", false);
             model->autosave_frequency = reader->GetInt32("autosave", AUTOSAVE_EVERY_5MINUTES);
             model->autosave_amount = reader->GetInt32("autosave_amount", DEFAULT_NUM_AUTOSAVES_TO_KEEP);
+            model->autosave_in_background = reader->GetBoolean("autosave_in_background", true);
             model->confirmation_prompt = reader->GetBoolean("confirmation_prompt", false);
             model->currency_format = reader->GetEnum<int32_t>("currency_format", platform_get_locale_currency(), Enum_Currency);
             model->custom_currency_rate = reader->GetInt32("custom_currency_rate", 10);
@@ -157,6 +158,7 @@ namespace Config
             model->language = reader->GetEnum<int32_t>("language", platform_get_locale_language(), Enum_LanguageEnum);
             model->measurement_format = reader->GetEnum<int32_t>(
                 "measurement_format", platform_get_locale_measurement_format(), Enum_MeasurementFormat);
+            model->parallel_park_loading = reader->GetBoolean("parallel_park_loading", true);
             model->play_intro = reader->GetBoolean("play_intro", false);
             model->save_plugin_data = reader->GetBoolean("save_plugin_data", true);
             model->debugging_tools = reader->GetBoolean("debugging_tools", false);
@@ -194,6 +196,7 @@ namespace Config
             model->scale_quality = reader->GetEnum<int32_t>("scale_quality", SCALE_QUALITY_SMOOTH_NN, Enum_ScaleQuality);
             model->show_fps = reader->GetBoolean("show_fps", false);
             model->multithreading = reader->GetBoolean("multi_threading", false);
+            model->cache_paint_lists = reader->GetBoolean("cache_paint_lists", false);
             model->trap_cursor = reader->GetBoolean("trap_cursor", false);
             model->auto_open_shops = reader->GetBoolean("auto_open_shops", false);
             model->scenario_select_mode = reader->GetInt32("scenario_select_mode", SCENARIO_SELECT_MODE_ORIGIN);
@@ -222,6 +225,7 @@ namespace Config
         writer->WriteBoolean("always_show_gridlines", model->always_show_gridlines);
         writer->WriteInt32("autosave", model->autosave_frequency);
         writer->WriteInt32("autosave_amount", model->autosave_amount);
+        writer->WriteBoolean("autosave_in_background", model->autosave_in_background);
         writer->WriteBoolean("confirmation_prompt", model->confirmation_prompt);
         writer->WriteEnum<int32_t>("currency_format", model->currency_format, Enum_Currency);
         writer->WriteInt32("custom_currency_rate", model->custom_currency_rate);
@@ -237,6 +241,7 @@ namespace Config
         writer->WriteBoolean("landscape_smoothing", model->landscape_smoothing);
         writer->WriteEnum<int32_t>("language", model->language, Enum_LanguageEnum);
         writer->WriteEnum<int32_t>("measurement_format", model->measurement_format, Enum_MeasurementFormat);
+        writer->WriteBoolean("parallel_park_loading", model->parallel_park_loading);
         writer->WriteBoolean("play_intro", model->play_intro);
         writer->WriteBoolean("save_plugin_data", model->save_plugin_data);
         writer->WriteBoolean("debugging_tools", model->debugging_tools);
@@ -268,6 +273,7 @@ namespace Config
         writer->WriteEnum<int32_t>("scale_quality", model->scale_quality, Enum_ScaleQuality);
         writer->WriteBoolean("show_fps", model->show_fps);
         writer->WriteBoolean("multi_threading", model->multithreading);
+        writer->WriteBoolean("cache_paint_lists", model->cache_paint_lists);
         writer->WriteBoolean("trap_cursor", model->trap_cursor);
         writer->WriteBoolean("auto_open_shops", model->auto_open_shops);
         writer->WriteInt32("scenario_select_mode", model->scenario_select_mode);
@@ -400,6 +406,7 @@ namespace Config
             model->log_server_actions = reader->GetBoolean("log_server_actions", false);
             model->pause_server_if_no_clients = reader->GetBoolean("pause_server_if_no_clients", false);
             model->desync_debugging = reader->GetBoolean("desync_debugging", false);
+            model->map_compression_level = reader->GetInt32("map_compression_level", 6);
         }
     }
 
@@ -427,6 +434,7 @@ namespace Config
         writer->WriteBoolean("log_server_actions", model->log_server_actions);
         writer->WriteBoolean("pause_server_if_no_clients", model->pause_server_if_no_clients);
         writer->WriteBoolean("desync_debugging", model->desync_debugging);
+        writer->WriteInt32("map_compression_level", model->map_compression_level);
     }
 
     static void ReadNotifications(IIniReader* reader)
@@ -875,7 +883,7 @@ bool RCT1DataPresentAtLocation(const utf8* path)
     return Csg1datPresentAtLocation(path) && Csg1idatPresentAtLocation(path) && CsgAtLocationIsUsable(path);
 }
 
-bool CsgIsUsable(rct_gx csg)
+bool CsgIsUsable(const rct_gx& csg)
 {
     return csg.header.num_entries == RCT1_NUM_LL_CSG_ENTRIES;
 }
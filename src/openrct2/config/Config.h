@@ -34,6 +34,7 @@ struct GeneralConfiguration
     bool use_vsync;
     bool show_fps;
     bool multithreading;
+    bool cache_paint_lists;
     bool minimize_fullscreen_focus_loss;
 
     // Map rendering
@@ -72,10 +73,12 @@ struct GeneralConfiguration
     bool play_intro;
     int32_t window_snap_proximity;
     bool allow_loading_with_incorrect_checksum;
+    bool parallel_park_loading;
     bool save_plugin_data;
     bool debugging_tools;
     int32_t autosave_frequency;
     int32_t autosave_amount;
+    bool autosave_in_background;
     bool auto_staff_placement;
     bool handymen_mow_default;
     bool auto_open_shops;
@@ -150,6 +153,7 @@ struct NetworkConfiguration
     bool log_server_actions;
     bool pause_server_if_no_clients;
     bool desync_debugging;
+    int32_t map_compression_level;
 };
 
 struct NotificationConfiguration
@@ -246,5 +250,5 @@ std::string FindCsg1datAtLocation(const utf8* path);
 bool Csg1datPresentAtLocation(const utf8* path);
 std::string FindCsg1idatAtLocation(const utf8* path);
 bool Csg1idatPresentAtLocation(const utf8* path);
-bool CsgIsUsable(rct_gx csg);
+bool CsgIsUsable(const rct_gx& csg);
 bool CsgAtLocationIsUsable(const utf8* path);
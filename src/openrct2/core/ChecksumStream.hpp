@@ -0,0 +1,91 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "IStream.hpp"
+
+/**
+ * A stream that passes everything written to it on to another stream, keeping the sum of all bytes written. This is
+ * the checksum SV6 and SC6 files end with, so files can be checksummed without reading them back. As the sum only
+ * covers bytes as they are written, the stream can not seek or be read from.
+ */
+class ChecksumStream final : public IStream
+{
+private:
+    IStream* const _stream;
+    uint32_t _checksum = 0;
+
+public:
+    explicit ChecksumStream(IStream* stream)
+        : _stream(stream)
+    {
+    }
+
+    uint32_t GetChecksum() const
+    {
+        return _checksum;
+    }
+
+    bool CanRead() const override
+    {
+        return false;
+    }
+
+    bool CanWrite() const override
+    {
+        return _stream->CanWrite();
+    }
+
+    uint64_t GetLength() const override
+    {
+        return _stream->GetLength();
+    }
+
+    uint64_t GetPosition() const override
+    {
+        return _stream->GetPosition();
+    }
+
+    void SetPosition([[maybe_unused]] uint64_t position) override
+    {
+        throw IOException("Unable to seek a checksum stream.");
+    }
+
+    void Seek([[maybe_unused]] int64_t offset, [[maybe_unused]] int32_t origin) override
+    {
+        throw IOException("Unable to seek a checksum stream.");
+    }
+
+    void Read([[maybe_unused]] void* buffer, [[maybe_unused]] uint64_t length) override
+    {
+        throw IOException("Unable to read from a checksum stream.");
+    }
+
+    void Write(const void* buffer, uint64_t length) override
+    {
+        const auto* bytes = static_cast<const uint8_t*>(buffer);
+        for (uint64_t i = 0; i < length; i++)
+        {
+            _checksum += bytes[i];
+        }
+        _stream->Write(buffer, length);
+    }
+
+    uint64_t TryRead([[maybe_unused]] void* buffer, [[maybe_unused]] uint64_t length) override
+    {
+        return 0;
+    }
+
+    const void* GetData() const override
+    {
+        return nullptr;
+    }
+};
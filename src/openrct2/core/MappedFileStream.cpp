@@ -0,0 +1,244 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "MappedFileStream.h"
+
+#include "FileStream.hpp"
+#include "String.hpp"
+
+#include <cstdlib>
+
+#ifdef _WIN32
+#    define WIN32_LEAN_AND_MEAN
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+static uint8_t* map_file(const std::string& path, size_t* length)
+{
+    auto pathW = String::ToWideChar(path);
+    HANDLE file = CreateFileW(
+        pathW.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return nullptr;
+    }
+
+    uint8_t* data = nullptr;
+    LARGE_INTEGER fileSize;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0 && static_cast<uint64_t>(fileSize.QuadPart) <= SIZE_MAX)
+    {
+        // The view keeps the mapping alive, so neither handle is needed once it exists.
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+        if (mapping != nullptr)
+        {
+            data = static_cast<uint8_t*>(MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0));
+            CloseHandle(mapping);
+        }
+        *length = static_cast<size_t>(fileSize.QuadPart);
+    }
+    CloseHandle(file);
+    return data;
+}
+
+static void unmap_file(uint8_t* data, [[maybe_unused]] size_t length)
+{
+    UnmapViewOfFile(data);
+}
+
+#else
+
+static uint8_t* map_file(const std::string& path, size_t* length)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+        return nullptr;
+    }
+
+    uint8_t* data = nullptr;
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) == 0 && S_ISREG(fileStat.st_mode) && fileStat.st_size > 0)
+    {
+        // The mapping keeps the file open, so the descriptor is not needed once it exists.
+        void* mapping = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if (mapping != MAP_FAILED)
+        {
+            data = static_cast<uint8_t*>(mapping);
+            *length = static_cast<size_t>(fileStat.st_size);
+        }
+    }
+    close(fd);
+    return data;
+}
+
+static void unmap_file(uint8_t* data, size_t length)
+{
+    munmap(data, length);
+}
+
+#endif
+
+MappedFile::MappedFile(const std::string& path)
+{
+    _data = map_file(path, &_length);
+    if (_data != nullptr)
+    {
+        _mapped = true;
+        return;
+    }
+
+    // Empty files and files on systems that can not map them are read instead.
+    auto fs = FileStream(path, FILE_MODE_OPEN);
+    _length = static_cast<size_t>(fs.GetLength());
+    if (_length > 0)
+    {
+        _data = fs.ReadArray<uint8_t>(_length);
+    }
+}
+
+MappedFile::~MappedFile()
+{
+    if (_mapped)
+    {
+        unmap_file(_data, _length);
+    }
+    else
+    {
+        std::free(_data);
+    }
+}
+
+MappedFileStream::MappedFileStream(const std::string& path)
+    : _file(std::make_shared<MappedFile>(path))
+{
+}
+
+MappedFileStream::MappedFileStream(std::shared_ptr<MappedFile> file)
+    : _file(std::move(file))
+{
+}
+
+const std::shared_ptr<MappedFile>& MappedFileStream::GetMappedFile() const
+{
+    return _file;
+}
+
+uint8_t* MappedFileStream::ReadSpan(uint64_t length)
+{
+    if (length > _file->GetLength() - _position)
+    {
+        throw IOException("Attempted to read past end of file.");
+    }
+    uint8_t* span = _file->GetData() + _position;
+    _position += length;
+    return span;
+}
+
+bool MappedFileStream::CanRead() const
+{
+    return true;
+}
+
+bool MappedFileStream::CanWrite() const
+{
+    return false;
+}
+
+uint64_t MappedFileStream::GetLength() const
+{
+    return _file->GetLength();
+}
+
+uint64_t MappedFileStream::GetPosition() const
+{
+    return _position;
+}
+
+void MappedFileStream::SetPosition(uint64_t position)
+{
+    Seek(position, STREAM_SEEK_BEGIN);
+}
+
+void MappedFileStream::Seek(int64_t offset, int32_t origin)
+{
+    uint64_t newPosition;
+    switch (origin)
+    {
+        default:
+        case STREAM_SEEK_BEGIN:
+            newPosition = offset;
+            break;
+        case STREAM_SEEK_CURRENT:
+            newPosition = _position + offset;
+            break;
+        case STREAM_SEEK_END:
+            newPosition = _file->GetLength() + offset;
+            break;
+    }
+
+    if (newPosition > _file->GetLength())
+    {
+        throw IOException("New position out of bounds.");
+    }
+    _position = newPosition;
+}
+
+void MappedFileStream::Read(void* buffer, uint64_t length)
+{
+    std::memcpy(buffer, ReadSpan(length), static_cast<size_t>(length));
+}
+
+void MappedFileStream::Read1(void* buffer)
+{
+    Read<1>(buffer);
+}
+
+void MappedFileStream::Read2(void* buffer)
+{
+    Read<2>(buffer);
+}
+
+void MappedFileStream::Read4(void* buffer)
+{
+    Read<4>(buffer);
+}
+
+void MappedFileStream::Read8(void* buffer)
+{
+    Read<8>(buffer);
+}
+
+void MappedFileStream::Read16(void* buffer)
+{
+    Read<16>(buffer);
+}
+
+void MappedFileStream::Write(const void* buffer, uint64_t length)
+{
+    throw IOException("Mapped files are read only.");
+}
+
+uint64_t MappedFileStream::TryRead(void* buffer, uint64_t length)
+{
+    uint64_t bytesToRead = std::min(length, _file->GetLength() - _position);
+    Read(buffer, bytesToRead);
+    return bytesToRead;
+}
+
+const void* MappedFileStream::GetData() const
+{
+    return _file->GetData();
+}
@@ -0,0 +1,100 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "IStream.hpp"
+
+#include <cstring>
+#include <memory>
+#include <string>
+
+/**
+ * The contents of a file mapped into memory. Pages are only read from disk when they are first used and, as the file
+ * backs them, can be dropped again when memory runs low. The mapping is copy on write so changes stay private to the
+ * process. Where a file can not be mapped it is read into memory instead.
+ */
+class MappedFile final
+{
+private:
+    uint8_t* _data = nullptr;
+    size_t _length = 0;
+    bool _mapped = false;
+
+public:
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    uint8_t* GetData() const
+    {
+        return _data;
+    }
+    size_t GetLength() const
+    {
+        return _length;
+    }
+    bool IsMapped() const
+    {
+        return _mapped;
+    }
+};
+
+/**
+ * A stream for reading a mapped file. Besides copying data out like other streams, ReadSpan returns the data in place,
+ * which stays valid for as long as the MappedFile from GetMappedFile is kept.
+ */
+class MappedFileStream final : public IStream
+{
+private:
+    std::shared_ptr<MappedFile> _file;
+    uint64_t _position = 0;
+
+public:
+    explicit MappedFileStream(const std::string& path);
+    explicit MappedFileStream(std::shared_ptr<MappedFile> file);
+
+    const std::shared_ptr<MappedFile>& GetMappedFile() const;
+
+    /**
+     * Gets the next length bytes of the file without copying them and moves past them.
+     */
+    uint8_t* ReadSpan(uint64_t length);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // ISteam methods
+    ///////////////////////////////////////////////////////////////////////////
+    bool CanRead() const override;
+    bool CanWrite() const override;
+
+    uint64_t GetLength() const override;
+    uint64_t GetPosition() const override;
+    void SetPosition(uint64_t position) override;
+    void Seek(int64_t offset, int32_t origin) override;
+
+    void Read(void* buffer, uint64_t length) override;
+    void Read1(void* buffer) override;
+    void Read2(void* buffer) override;
+    void Read4(void* buffer) override;
+    void Read8(void* buffer) override;
+    void Read16(void* buffer) override;
+
+    template<size_t N> void Read(void* buffer)
+    {
+        std::memcpy(buffer, ReadSpan(N), N);
+    }
+
+    void Write(const void* buffer, uint64_t length) override;
+    uint64_t TryRead(void* buffer, uint64_t length) override;
+
+    const void* GetData() const override;
+};
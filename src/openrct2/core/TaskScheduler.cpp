@@ -0,0 +1,194 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TaskScheduler.h"
+
+#include <array>
+#include <chrono>
+
+/**
+ * A fixed size ring buffer of tasks. The owner pushes and pops at the back, thieves pop at the front. The number of
+ * queued tasks of all queues is changed under the same lock as the queue, so it never counts a task that was taken.
+ */
+struct TaskScheduler::TaskQueue
+{
+    static constexpr size_t Capacity = 1024;
+
+    std::mutex Mutex;
+    std::array<Task, Capacity> Tasks;
+    size_t Head = 0;
+    size_t Count = 0;
+
+    bool PushBack(const Task& task, std::atomic<size_t>& queuedTasks)
+    {
+        std::lock_guard<std::mutex> lock(Mutex);
+        if (Count == Capacity)
+            return false;
+        Tasks[(Head + Count) % Capacity] = task;
+        Count++;
+        queuedTasks++;
+        return true;
+    }
+
+    bool PopBack(Task& task, std::atomic<size_t>& queuedTasks)
+    {
+        std::lock_guard<std::mutex> lock(Mutex);
+        if (Count == 0)
+            return false;
+        Count--;
+        queuedTasks--;
+        task = Tasks[(Head + Count) % Capacity];
+        return true;
+    }
+
+    bool PopFront(Task& task, std::atomic<size_t>& queuedTasks)
+    {
+        std::lock_guard<std::mutex> lock(Mutex);
+        if (Count == 0)
+            return false;
+        task = Tasks[Head];
+        Head = (Head + 1) % Capacity;
+        Count--;
+        queuedTasks--;
+        return true;
+    }
+};
+
+static thread_local const TaskScheduler* _currentScheduler;
+static thread_local size_t _currentQueueIndex;
+
+TaskScheduler::TaskScheduler(size_t numWorkers)
+{
+    for (size_t i = 0; i <= numWorkers; i++)
+    {
+        _queues.push_back(std::make_unique<TaskQueue>());
+    }
+    for (size_t i = 0; i < numWorkers; i++)
+    {
+        _threads.emplace_back(&TaskScheduler::ProcessQueues, this, i);
+    }
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _shouldStop = true;
+        _condWork.notify_all();
+    }
+    for (auto& thread : _threads)
+    {
+        thread.join();
+    }
+}
+
+TaskScheduler& TaskScheduler::GetDefault()
+{
+    static TaskScheduler scheduler(std::max(std::thread::hardware_concurrency(), 1u) - 1);
+    return scheduler;
+}
+
+size_t TaskScheduler::GetWorkerCount() const
+{
+    return _threads.size();
+}
+
+size_t TaskScheduler::GetLocalQueueIndex() const
+{
+    return _currentScheduler == this ? _currentQueueIndex : _queues.size() - 1;
+}
+
+void TaskScheduler::Submit(TaskGroup& group, TaskFunction fn, void* context, size_t begin, size_t end)
+{
+    group._pending++;
+    Task task{ fn, context, begin, end, &group };
+    if (!_queues[GetLocalQueueIndex()]->PushBack(task, _queuedTasks))
+    {
+        // The queue is full, there is plenty of work for the other threads already.
+        RunTask(task);
+        return;
+    }
+
+    if (_sleepingWorkers > 0)
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _condWork.notify_one();
+    }
+}
+
+bool TaskScheduler::TryRunTask()
+{
+    const size_t numQueues = _queues.size();
+    const size_t localIndex = GetLocalQueueIndex();
+    Task task;
+    bool found = _queues[localIndex]->PopBack(task, _queuedTasks);
+    for (size_t i = 1; !found && i < numQueues; i++)
+    {
+        found = _queues[(localIndex + i) % numQueues]->PopFront(task, _queuedTasks);
+    }
+    if (!found)
+        return false;
+
+    RunTask(task);
+    return true;
+}
+
+void TaskScheduler::RunTask(const Task& task)
+{
+    task.Fn(task.Context, task.Begin, task.End);
+
+    // The group may be destroyed as soon as it is complete, waiters take the lock before returning so it has to be
+    // held until nothing touches the group anymore.
+    auto& group = *task.Group;
+    std::lock_guard<std::mutex> lock(group._mutex);
+    if (--group._pending == 0)
+    {
+        group._condComplete.notify_all();
+    }
+}
+
+void TaskScheduler::Wait(TaskGroup& group)
+{
+    WaitWithReport(group, nullptr, nullptr);
+}
+
+void TaskScheduler::WaitWithReport(TaskGroup& group, void (*report)(void*), void* reportContext)
+{
+    while (group._pending != 0)
+    {
+        if (!TryRunTask())
+        {
+            std::unique_lock<std::mutex> lock(group._mutex);
+            group._condComplete.wait_for(lock, std::chrono::milliseconds(10), [&group]() { return group._pending == 0; });
+        }
+        if (report != nullptr)
+        {
+            report(reportContext);
+        }
+    }
+    std::lock_guard<std::mutex> lock(group._mutex);
+}
+
+void TaskScheduler::ProcessQueues(size_t queueIndex)
+{
+    _currentScheduler = this;
+    _currentQueueIndex = queueIndex;
+    while (!_shouldStop)
+    {
+        if (TryRunTask())
+            continue;
+
+        _sleepingWorkers++;
+        {
+            std::unique_lock<std::mutex> lock(_sleepMutex);
+            _condWork.wait(lock, [this]() { return _shouldStop || _queuedTasks > 0; });
+        }
+        _sleepingWorkers--;
+    }
+}
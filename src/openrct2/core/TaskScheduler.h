@@ -0,0 +1,152 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * A set of tasks that can be waited on together. Must outlive the tasks submitted to it.
+ */
+class TaskGroup
+{
+    friend class TaskScheduler;
+
+private:
+    std::atomic<size_t> _pending = { 0 };
+    std::mutex _mutex;
+    std::condition_variable _condComplete;
+
+public:
+    bool IsComplete() const
+    {
+        return _pending == 0;
+    }
+};
+
+using TaskFunction = void (*)(void* context, size_t begin, size_t end);
+
+/**
+ * Runs tasks on a fixed set of worker threads. Every worker has its own queue which it takes its newest task from,
+ * idle workers steal the oldest task of other queues. Tasks are plain function pointers with a context and a range so
+ * submitting one never allocates, the caller keeps the context alive until the task group is complete. Threads waiting
+ * on a task group help out with running tasks.
+ */
+class TaskScheduler
+{
+private:
+    struct Task
+    {
+        TaskFunction Fn;
+        void* Context;
+        size_t Begin;
+        size_t End;
+        TaskGroup* Group;
+    };
+
+    struct TaskQueue;
+
+    template<typename TFunc> struct ForContext
+    {
+        TaskScheduler* Scheduler;
+        TaskGroup* Group;
+        const TFunc* Fn;
+        size_t Grain;
+    };
+
+    // One queue per worker, the last one is shared by all other threads.
+    std::vector<std::unique_ptr<TaskQueue>> _queues;
+    std::vector<std::thread> _threads;
+    std::atomic<size_t> _queuedTasks = { 0 };
+    std::atomic<size_t> _sleepingWorkers = { 0 };
+    std::atomic_bool _shouldStop = { false };
+    std::mutex _sleepMutex;
+    std::condition_variable _condWork;
+
+public:
+    explicit TaskScheduler(size_t numWorkers);
+    ~TaskScheduler();
+
+    /**
+     * The scheduler shared by the game, with one worker less than there are hardware threads as the thread waiting on
+     * a task group works as well.
+     */
+    static TaskScheduler& GetDefault();
+
+    size_t GetWorkerCount() const;
+
+    void Submit(TaskGroup& group, TaskFunction fn, void* context, size_t begin = 0, size_t end = 0);
+    void Wait(TaskGroup& group);
+
+    /**
+     * Calls fn for every index from begin up to end. The range is split in halves until the parts are no larger than
+     * grain, parts are run in parallel.
+     */
+    template<typename TFunc> void ParallelFor(size_t begin, size_t end, size_t grain, const TFunc& fn)
+    {
+        ParallelFor(begin, end, grain, fn, []() {});
+    }
+
+    /**
+     * Same as ParallelFor but calls report on the calling thread every now and then until all indices are done.
+     */
+    template<typename TFunc, typename TReport>
+    void ParallelFor(size_t begin, size_t end, size_t grain, const TFunc& fn, const TReport& report)
+    {
+        if (begin >= end)
+            return;
+
+        grain = std::max<size_t>(grain, 1);
+        if (_threads.empty() || end - begin <= grain)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                fn(i);
+            }
+            report();
+            return;
+        }
+
+        TaskGroup group;
+        ForContext<TFunc> context{ this, &group, &fn, grain };
+        Submit(group, &RunForRange<TFunc>, &context, begin, end);
+        WaitWithReport(
+            group, [](void* reportContext) { (*static_cast<const TReport*>(reportContext))(); },
+            const_cast<void*>(static_cast<const void*>(&report)));
+    }
+
+private:
+    template<typename TFunc> static void RunForRange(void* context, size_t begin, size_t end)
+    {
+        auto& forContext = *static_cast<ForContext<TFunc>*>(context);
+        while (end - begin > forContext.Grain)
+        {
+            size_t middle = begin + (end - begin) / 2;
+            forContext.Scheduler->Submit(*forContext.Group, &RunForRange<TFunc>, context, middle, end);
+            end = middle;
+        }
+        for (size_t i = begin; i < end; i++)
+        {
+            (*forContext.Fn)(i);
+        }
+    }
+
+    size_t GetLocalQueueIndex() const;
+    bool TryRunTask();
+    void RunTask(const Task& task);
+    void WaitWithReport(TaskGroup& group, void (*report)(void*), void* reportContext);
+    void ProcessQueues(size_t queueIndex);
+};
@@ -12,6 +12,7 @@
 #include "../PlatformEnvironment.h"
 #include "../config/Config.h"
 #include "../core/FileStream.hpp"
+#include "../core/MappedFileStream.h"
 #include "../core/Path.hpp"
 #include "../platform/platform.h"
 #include "../sprites.h"
@@ -21,6 +22,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <vector>
 
@@ -67,90 +69,140 @@ static inline uint32_t rctc_to_rct2_index(uint32_t image)
 }
 // clang-format on
 
-static void read_and_convert_gxdat(IStream* stream, size_t count, bool is_rctc, rct_g1_element* elements)
+static void convert_gxdat_element(const rct_g1_element_32bit& src, rct_g1_element& dst, uint8_t* data)
 {
-    auto g1Elements32 = std::make_unique<rct_g1_element_32bit[]>(count);
-    stream->Read(g1Elements32.get(), count * sizeof(rct_g1_element_32bit));
-    if (is_rctc)
-    {
-        // Process RCTC's g1.dat file
-        uint32_t rctc = 0;
-        for (size_t i = 0; i < SPR_G1_END; ++i)
-        {
-            // RCTC's g1.dat has a number of additional elements
-            // added between the RCT2 elements. This switch
-            // statement skips over the elements we don't want.
-            switch (i)
-            {
-                case 1542:
-                    rctc += 32;
-                    break;
-                case 23761:
-                case 24627:
-                    rctc += 4;
-                    break;
-                case 4951:
-                    rctc += 3;
-                    break;
-                case 17154:
-                case 18084:
-                case 28197:
-                    rctc += 2;
-                    break;
-            }
-
-            const rct_g1_element_32bit& src = g1Elements32[rctc];
-
-            // Double cast to silence compiler warning about casting to
-            // pointer from integer of mismatched length.
-            elements[i].offset = reinterpret_cast<uint8_t*>(static_cast<uintptr_t>(src.offset));
-            elements[i].width = src.width;
-            elements[i].height = src.height;
-            elements[i].x_offset = src.x_offset;
-            elements[i].y_offset = src.y_offset;
-            elements[i].flags = src.flags;
+    dst.offset = data + src.offset;
+    dst.width = src.width;
+    dst.height = src.height;
+    dst.x_offset = src.x_offset;
+    dst.y_offset = src.y_offset;
+    dst.flags = src.flags;
+    dst.zoomed_offset = src.zoomed_offset;
+}
 
-            if (src.flags & G1_FLAG_HAS_ZOOM_SPRITE)
-            {
-                elements[i].zoomed_offset = static_cast<int32_t>(i - rctc_to_rct2_index(rctc - src.zoomed_offset));
-            }
-            else
-            {
-                elements[i].zoomed_offset = src.zoomed_offset;
-            }
+/**
+ * Converts all elements of RCTC's g1.dat up front, as they have to be moved to where they are in RCT2's g1.dat. Data
+ * has to be set before.
+ */
+static void convert_rctc_gxdat(rct_gx& gx)
+{
+    const rct_g1_element_32bit* g1Elements32 = gx.file_elements;
+    rct_g1_element* elements = gx.elements.get();
+    uint8_t* data = static_cast<uint8_t*>(gx.data);
+    std::fill_n(elements, gx.header.num_entries, rct_g1_element{});
+
+    uint32_t rctc = 0;
+    for (size_t i = 0; i < SPR_G1_END; ++i)
+    {
+        // RCTC's g1.dat has a number of additional elements
+        // added between the RCT2 elements. This switch
+        // statement skips over the elements we don't want.
+        switch (i)
+        {
+            case 1542:
+                rctc += 32;
+                break;
+            case 23761:
+            case 24627:
+                rctc += 4;
+                break;
+            case 4951:
+                rctc += 3;
+                break;
+            case 17154:
+            case 18084:
+            case 28197:
+                rctc += 2;
+                break;
+        }
 
-            ++rctc;
+        const rct_g1_element_32bit& src = g1Elements32[rctc];
+        convert_gxdat_element(src, elements[i], data);
+        if (src.flags & G1_FLAG_HAS_ZOOM_SPRITE)
+        {
+            elements[i].zoomed_offset = static_cast<int32_t>(i - rctc_to_rct2_index(rctc - src.zoomed_offset));
         }
 
-        // The pincer graphic for picking up peeps is different in
-        // RCTC, and the sprites have different offsets to accommodate
-        // the change. This reverts the offsets to their RCT2 values.
-        for (const auto& animation : sprite_peep_pickup_starts)
+        ++rctc;
+    }
+
+    // The pincer graphic for picking up peeps is different in
+    // RCTC, and the sprites have different offsets to accommodate
+    // the change. This reverts the offsets to their RCT2 values.
+    for (const auto& animation : sprite_peep_pickup_starts)
+    {
+        for (int i = 0; i < SPR_PEEP_PICKUP_COUNT; ++i)
         {
-            for (int i = 0; i < SPR_PEEP_PICKUP_COUNT; ++i)
-            {
-                elements[animation.start + i].x_offset -= animation.x_offset;
-                elements[animation.start + i].y_offset -= animation.y_offset;
-            }
+            elements[animation.start + i].x_offset -= animation.x_offset;
+            elements[animation.start + i].y_offset -= animation.y_offset;
         }
     }
-    else
+
+    size_t numBlocks = (gx.header.num_entries + G1_ELEMENT_BLOCK_SIZE - 1) / G1_ELEMENT_BLOCK_SIZE;
+    for (size_t i = 0; i < numBlocks; i++)
     {
-        for (size_t i = 0; i < count; i++)
+        gx.converted_blocks[i] = true;
+    }
+}
+
+/**
+ * Uses the element headers from the file in place, they are converted when they are first used.
+ */
+static void map_gxdat_elements(rct_gx& gx, MappedFileStream& stream)
+{
+    size_t count = gx.header.num_entries;
+    gx.file_elements = reinterpret_cast<const rct_g1_element_32bit*>(
+        stream.ReadSpan(count * sizeof(rct_g1_element_32bit)));
+    gx.mapped_elements = stream.GetMappedFile();
+
+    // Left uninitialised, so the pages of blocks that are never used are never touched either.
+    gx.elements = std::unique_ptr<rct_g1_element[]>(new rct_g1_element[count]);
+    gx.converted_blocks = std::make_unique<std::atomic_bool[]>(
+        (count + G1_ELEMENT_BLOCK_SIZE - 1) / G1_ELEMENT_BLOCK_SIZE);
+}
+
+static std::mutex _gxConvertMutex;
+
+/**
+ * Gets an element of a graphics file, converting its block first if it is the first one used. Safe to call from
+ * multiple threads at once.
+ */
+static rct_g1_element* get_gxdat_element(rct_gx& gx, size_t idx)
+{
+    size_t block = idx / G1_ELEMENT_BLOCK_SIZE;
+    if (!gx.converted_blocks[block].load(std::memory_order_acquire))
+    {
+        std::lock_guard<std::mutex> lock(_gxConvertMutex);
+        if (!gx.converted_blocks[block].load(std::memory_order_relaxed))
         {
-            const rct_g1_element_32bit& src = g1Elements32[i];
-
-            // Double cast to silence compiler warning about casting to
-            // pointer from integer of mismatched length.
-            elements[i].offset = reinterpret_cast<uint8_t*>(static_cast<uintptr_t>(src.offset));
-            elements[i].width = src.width;
-            elements[i].height = src.height;
-            elements[i].x_offset = src.x_offset;
-            elements[i].y_offset = src.y_offset;
-            elements[i].flags = src.flags;
-            elements[i].zoomed_offset = src.zoomed_offset;
+            uint8_t* data = static_cast<uint8_t*>(gx.data);
+            size_t begin = block * G1_ELEMENT_BLOCK_SIZE;
+            size_t end = std::min<size_t>(begin + G1_ELEMENT_BLOCK_SIZE, gx.header.num_entries);
+            for (size_t i = begin; i < end; i++)
+            {
+                auto& element = gx.elements[i];
+                convert_gxdat_element(gx.file_elements[i], element, data);
+                if (gx.absolute_zoomed_offsets && (element.flags & G1_FLAG_HAS_ZOOM_SPRITE))
+                {
+                    element.zoomed_offset = static_cast<int32_t>(i - element.zoomed_offset);
+                }
+            }
+            gx.converted_blocks[block].store(true, std::memory_order_release);
         }
     }
+    return &gx.elements[idx];
+}
+
+static void unload_gxdat(rct_gx& gx)
+{
+    gx.header = {};
+    gx.elements.reset();
+    gx.converted_blocks.reset();
+    gx.file_elements = nullptr;
+    gx.data = nullptr;
+    gx.absolute_zoomed_offsets = false;
+    gx.mapped_elements.reset();
+    gx.mapped_file.reset();
 }
 
 void mask_scalar(
@@ -196,7 +248,7 @@ bool gfx_load_g1(const IPlatformEnvironment& env)
     try
     {
         auto path = Path::Combine(env.GetDirectoryPath(DIRBASE::RCT2, DIRID::DATA), "g1.dat");
-        auto fs = FileStream(path, FILE_MODE_OPEN);
+        auto fs = MappedFileStream(path);
         _g1.header = fs.ReadValue<rct_g1_header>();
 
         log_verbose("g1.dat, number of entries: %u", _g1.header.num_entries);
@@ -206,26 +258,21 @@ bool gfx_load_g1(const IPlatformEnvironment& env)
             throw std::runtime_error("Not enough elements in g1.dat");
         }
 
-        // Read element headers
+        // Element headers and data are used straight from the file
         bool is_rctc = _g1.header.num_entries == SPR_RCTC_G1_END;
-        _g1.elements.resize(_g1.header.num_entries);
-        read_and_convert_gxdat(&fs, _g1.header.num_entries, is_rctc, _g1.elements.data());
-        gTinyFontAntiAliased = is_rctc;
-
-        // Read element data
-        _g1.data = fs.ReadArray<uint8_t>(_g1.header.total_size);
-
-        // Fix entry data offsets
-        for (uint32_t i = 0; i < _g1.header.num_entries; i++)
+        map_gxdat_elements(_g1, fs);
+        _g1.data = fs.ReadSpan(_g1.header.total_size);
+        _g1.mapped_file = fs.GetMappedFile();
+        if (is_rctc)
         {
-            _g1.elements[i].offset += reinterpret_cast<uintptr_t>(_g1.data);
+            convert_rctc_gxdat(_g1);
         }
+        gTinyFontAntiAliased = is_rctc;
         return true;
     }
     catch (const std::exception&)
     {
-        _g1.elements.clear();
-        _g1.elements.shrink_to_fit();
+        unload_gxdat(_g1);
 
         log_fatal("Unable to load g1 graphics");
         if (!gOpenRCT2Headless)
@@ -239,23 +286,17 @@ bool gfx_load_g1(const IPlatformEnvironment& env)
 
 void gfx_unload_g1()
 {
-    SafeFree(_g1.data);
-    _g1.elements.clear();
-    _g1.elements.shrink_to_fit();
+    unload_gxdat(_g1);
 }
 
 void gfx_unload_g2()
 {
-    SafeFree(_g2.data);
-    _g2.elements.clear();
-    _g2.elements.shrink_to_fit();
+    unload_gxdat(_g2);
 }
 
 void gfx_unload_csg()
 {
-    SafeFree(_csg.data);
-    _csg.elements.clear();
-    _csg.elements.shrink_to_fit();
+    unload_gxdat(_csg);
 }
 
 bool gfx_load_g2()
@@ -268,27 +309,18 @@ bool gfx_load_g2()
     safe_strcat_path(path, "g2.dat", MAX_PATH);
     try
     {
-        auto fs = FileStream(path, FILE_MODE_OPEN);
+        auto fs = MappedFileStream(path);
         _g2.header = fs.ReadValue<rct_g1_header>();
 
-        // Read element headers
-        _g2.elements.resize(_g2.header.num_entries);
-        read_and_convert_gxdat(&fs, _g2.header.num_entries, false, _g2.elements.data());
-
-        // Read element data
-        _g2.data = fs.ReadArray<uint8_t>(_g2.header.total_size);
-
-        // Fix entry data offsets
-        for (uint32_t i = 0; i < _g2.header.num_entries; i++)
-        {
-            _g2.elements[i].offset += reinterpret_cast<uintptr_t>(_g2.data);
-        }
+        // Element headers and data are used straight from the file
+        map_gxdat_elements(_g2, fs);
+        _g2.data = fs.ReadSpan(_g2.header.total_size);
+        _g2.mapped_file = fs.GetMappedFile();
         return true;
     }
     catch (const std::exception&)
     {
-        _g2.elements.clear();
-        _g2.elements.shrink_to_fit();
+        unload_gxdat(_g2);
 
         log_fatal("Unable to load g2 graphics");
         if (!gOpenRCT2Headless)
@@ -314,8 +346,8 @@ bool gfx_load_csg()
     auto pathDataPath = FindCsg1datAtLocation(gConfigGeneral.rct1_path);
     try
     {
-        auto fileHeader = FileStream(pathHeaderPath, FILE_MODE_OPEN);
-        auto fileData = FileStream(pathDataPath, FILE_MODE_OPEN);
+        auto fileHeader = MappedFileStream(pathHeaderPath);
+        auto fileData = MappedFileStream(pathDataPath);
         size_t fileHeaderSize = fileHeader.GetLength();
         size_t fileDataSize = fileData.GetLength();
 
@@ -328,30 +360,17 @@ bool gfx_load_csg()
             return false;
         }
 
-        // Read element headers
-        _csg.elements.resize(_csg.header.num_entries);
-        read_and_convert_gxdat(&fileHeader, _csg.header.num_entries, false, _csg.elements.data());
-
-        // Read element data
-        _csg.data = fileData.ReadArray<uint8_t>(_csg.header.total_size);
-
-        // Fix entry data offsets
-        for (uint32_t i = 0; i < _csg.header.num_entries; i++)
-        {
-            _csg.elements[i].offset += reinterpret_cast<uintptr_t>(_csg.data);
-            // RCT1 used zoomed offsets that counted from the beginning of the file, rather than from the current sprite.
-            if (_csg.elements[i].flags & G1_FLAG_HAS_ZOOM_SPRITE)
-            {
-                _csg.elements[i].zoomed_offset = i - _csg.elements[i].zoomed_offset;
-            }
-        }
+        // Element headers and data are used straight from the files
+        map_gxdat_elements(_csg, fileHeader);
+        _csg.data = fileData.ReadSpan(_csg.header.total_size);
+        _csg.mapped_file = fileData.GetMappedFile();
+        _csg.absolute_zoomed_offsets = true;
         _csgLoaded = true;
         return true;
     }
     catch (const std::exception&)
     {
-        _csg.elements.clear();
-        _csg.elements.shrink_to_fit();
+        unload_gxdat(_csg);
 
         log_error("Unable to load csg graphics");
         return false;
@@ -665,9 +684,9 @@ const rct_g1_element* gfx_get_g1_element(int32_t image_id)
     }
     else if (offset < SPR_RCTC_G1_END)
     {
-        if (offset < _g1.elements.size())
+        if (offset < _g1.header.num_entries)
         {
-            return &_g1.elements[offset];
+            return get_gxdat_element(_g1, offset);
         }
     }
     else if (offset < SPR_G2_END)
@@ -675,7 +694,7 @@ const rct_g1_element* gfx_get_g1_element(int32_t image_id)
         size_t idx = offset - SPR_G2_BEGIN;
         if (idx < _g2.header.num_entries)
         {
-            return &_g2.elements[idx];
+            return get_gxdat_element(_g2, idx);
         }
         else
         {
@@ -689,7 +708,7 @@ const rct_g1_element* gfx_get_g1_element(int32_t image_id)
             size_t idx = offset - SPR_CSG_BEGIN;
             if (idx < _csg.header.num_entries)
             {
-                return &_csg.elements[idx];
+                return get_gxdat_element(_csg, idx);
             }
             else
             {
@@ -730,9 +749,10 @@ void gfx_set_g1_element(int32_t imageId, const rct_g1_element* g1)
         {
             if (imageId < SPR_RCTC_G1_END)
             {
-                if (imageId < static_cast<int32_t>(_g1.elements.size()))
+                if (imageId < static_cast<int32_t>(_g1.header.num_entries))
                 {
-                    _g1.elements[imageId] = *g1;
+                    // Convert the block first so the element is not converted over later.
+                    *get_gxdat_element(_g1, imageId) = *g1;
                 }
             }
             else
@@ -14,6 +14,7 @@
 #include "../common.h"
 #include "../core/Guard.hpp"
 #include "../object/Object.h"
+#include "../paint/PaintCache.h"
 #include "../platform/platform.h"
 #include "../sprites.h"
 #include "../util/Util.h"
@@ -663,6 +664,7 @@ void load_palette()
  */
 void gfx_invalidate_screen()
 {
+    paint_cache_invalidate_all();
     gfx_set_dirty_blocks(0, 0, context_get_width(), context_get_height());
 }
 
@@ -14,11 +14,14 @@
 #include "../interface/Colour.h"
 #include "../interface/ZoomLevel.hpp"
 
+#include <atomic>
+#include <memory>
 #include <optional>
 #include <vector>
 struct ScreenCoordsXY;
 
 struct ScreenCoordsXY;
+class MappedFile;
 namespace OpenRCT2
 {
     interface IPlatformEnvironment;
@@ -90,13 +93,6 @@ struct rct_g1_header
 assert_struct_size(rct_g1_header, 8);
 #pragma pack(pop)
 
-struct rct_gx
-{
-    rct_g1_header header;
-    std::vector<rct_g1_element> elements;
-    void* data;
-};
-
 struct rct_drawpixelinfo
 {
     uint8_t* bits{};
@@ -122,6 +118,26 @@ struct rct_g1_element_32bit
 };
 assert_struct_size(rct_g1_element_32bit, 0x10);
 
+/**
+ * A graphics file. The elements are converted from the ones in the file the first time they are used, in blocks of
+ * G1_ELEMENT_BLOCK_SIZE, see gfx_get_g1_element.
+ */
+struct rct_gx
+{
+    rct_g1_header header;
+    std::unique_ptr<rct_g1_element[]> elements;
+    std::unique_ptr<std::atomic_bool[]> converted_blocks;
+    const rct_g1_element_32bit* file_elements;
+    void* data;
+    // RCT1 used zoomed offsets that counted from the beginning of the file, rather than from the current sprite.
+    bool absolute_zoomed_offsets;
+    // Own file_elements and data, which point into the mapped graphics files.
+    std::shared_ptr<MappedFile> mapped_elements;
+    std::shared_ptr<MappedFile> mapped_file;
+};
+
+constexpr size_t G1_ELEMENT_BLOCK_SIZE = 256;
+
 enum
 {
     G1_FLAG_BMP = (1 << 0), // Image data is encoded as raw pixels (no transparency)
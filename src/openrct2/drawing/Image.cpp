@@ -10,6 +10,7 @@
 #include "../OpenRCT2.h"
 #include "../core/Console.hpp"
 #include "../core/Guard.hpp"
+#include "../paint/PaintCache.h"
 #include "../sprites.h"
 #include "Drawing.h"
 
@@ -227,6 +228,9 @@ void gfx_object_free_images(uint32_t baseImageId, uint32_t count)
         }
 
         FreeImageList(baseImageId, count);
+
+        // Cached paint lists may refer to the freed images.
+        paint_cache_invalidate_all();
     }
 }
 
@@ -39,6 +39,8 @@
 #include "../object/ObjectList.h"
 #include "../object/ObjectManager.h"
 #include "../object/ObjectRepository.h"
+#include "../paint/Paint.h"
+#include "../paint/PaintCache.h"
 #include "../peep/Staff.h"
 #include "../platform/platform.h"
 #include "../ride/Ride.h"
@@ -52,6 +54,7 @@
 #include "Viewport.h"
 
 #include <algorithm>
+#include <cinttypes>
 #include <cmath>
 #include <cstdarg>
 #include <cstdlib>
@@ -1257,6 +1260,39 @@ static int32_t cc_show_limits(InteractiveConsole& console, [[maybe_unused]] cons
     return 0;
 }
 
+static int32_t cc_paint_stats(InteractiveConsole& console, [[maybe_unused]] const arguments_t& argv)
+{
+    auto stats = paint_session_get_stats();
+    console.WriteFormatLine("Columns painted: %u", stats.Sessions);
+    console.WriteFormatLine("Peak paint structs per column: %u", stats.PeakPaintStructs);
+    if (stats.Sessions > 0)
+    {
+        auto average = static_cast<uint32_t>(stats.TotalPaintStructs / stats.Sessions);
+        console.WriteFormatLine("Average paint structs per column: %u", average);
+    }
+    console.WriteFormatLine("Reserved paint structs: %zu", stats.ReservedPaintStructs);
+    paint_session_reset_stats();
+
+    auto cacheStats = paint_cache_get_stats();
+    console.WriteFormatLine(
+        "Paint cache: %" PRIu64 " hits, %" PRIu64 " misses, %zu cells", cacheStats.Hits, cacheStats.Misses, cacheStats.Cells);
+    paint_cache_reset_stats();
+    return 0;
+}
+
+static int32_t cc_autosave_stats(InteractiveConsole& console, [[maybe_unused]] const arguments_t& argv)
+{
+    auto stats = game_autosave_get_stats();
+    console.WriteFormatLine("Autosaves: %u (%u in the background)", stats.Autosaves, stats.BackgroundAutosaves);
+    if (stats.Autosaves > 0)
+    {
+        console.WriteFormatLine("Last stall: %.1f ms", stats.LastStallSeconds * 1000.0);
+        console.WriteFormatLine("Longest stall: %.1f ms", stats.MaxStallSeconds * 1000.0);
+        console.WriteFormatLine("Average stall: %.1f ms", stats.TotalStallSeconds * 1000.0 / stats.Autosaves);
+    }
+    return 0;
+}
+
 static int32_t cc_for_date([[maybe_unused]] InteractiveConsole& console, [[maybe_unused]] const arguments_t& argv)
 {
     int32_t year = 0;
@@ -1745,6 +1781,7 @@ static constexpr const console_command console_command_table[] = {
     { "abort", cc_abort, "Calls std::abort(), for testing purposes only.", "abort" },
     { "add_news_item", cc_add_news_item, "Inserts a news item", "add_news_item [<type> <message> <assoc>]" },
     { "assert", cc_assert, "Triggers assertion failure, for testing purposes only", "assert" },
+    { "autosave_stats", cc_autosave_stats, "Shows how long autosaves held up the game.", "autosave_stats" },
     { "clear", cc_clear, "Clears the console.", "clear" },
     { "close", cc_close, "Closes the console.", "close" },
     { "date", cc_for_date, "Sets the date to a given date.", "Format <year>[ <month>[ <day>]]." },
@@ -1761,6 +1798,7 @@ static constexpr const console_command console_command_table[] = {
     { "load_park", cc_load_park, "Load park from save directory or by absolute path", "load_park <filename>" },
     { "object_count", cc_object_count, "Shows the number of objects of each type in the scenario.", "object_count" },
     { "open", cc_open, "Opens the window with the give name.", "open <window>." },
+    { "paint_stats", cc_paint_stats, "Shows how many paint structs were used per column since the last call.", "paint_stats" },
     { "quit", cc_close, "Closes the console.", "quit" },
     { "remove_park_fences", cc_remove_park_fences, "Removes all park fences from the surface", "remove_park_fences" },
     { "remove_unused_objects", cc_remove_unused_objects, "Removes all the unused objects from the object selection.", "remove_unused_objects" },
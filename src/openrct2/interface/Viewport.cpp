@@ -15,9 +15,10 @@
 #include "../OpenRCT2.h"
 #include "../config/Config.h"
 #include "../core/Guard.hpp"
-#include "../core/JobPool.hpp"
+#include "../core/TaskScheduler.h"
 #include "../drawing/Drawing.h"
 #include "../paint/Paint.h"
+#include "../paint/PaintCache.h"
 #include "../peep/Staff.h"
 #include "../ride/Ride.h"
 #include "../ride/TrackDesign.h"
@@ -43,8 +44,6 @@ uint8_t gShowConstuctionRightsRefCount;
 rct_viewport g_viewport_list[MAX_VIEWPORT_COUNT];
 rct_viewport* g_music_tracking_viewport;
 
-static std::unique_ptr<JobPool> _paintJobs;
-
 ScreenCoordsXY gSavedView;
 ZoomLevel gSavedViewZoom;
 uint8_t gSavedViewRotation;
@@ -60,6 +59,8 @@ InteractionInfo::InteractionInfo(const paint_struct* ps)
 {
 }
 static void viewport_paint_weather_gloom(rct_drawpixelinfo* dpi);
+static void viewport_paint_cached(
+    const rct_viewport* viewport, rct_drawpixelinfo* dpi, int16_t left, int16_t top, int16_t right, int16_t bottom);
 
 /**
  * This is not a viewport function. It is used to setup many variables for
@@ -775,7 +776,7 @@ void viewport_update_smart_vehicle_follow(rct_window* window)
  */
 void viewport_render(
     rct_drawpixelinfo* dpi, const rct_viewport* viewport, int32_t left, int32_t top, int32_t right, int32_t bottom,
-    std::vector<paint_session>* sessions)
+    std::vector<RecordedPaintSession>* sessions)
 {
     if (right <= viewport->pos.x)
         return;
@@ -805,7 +806,15 @@ void viewport_render(
     top += viewport->viewPos.y;
     bottom += viewport->viewPos.y;
 
-    viewport_paint(viewport, dpi, left, top, right, bottom, sessions);
+    // Map changes do not invalidate the cache while running headless, so headless screenshots always paint afresh.
+    if (gConfigGeneral.cache_paint_lists && sessions == nullptr && !gPaintBoundingBoxes && !gOpenRCT2Headless)
+    {
+        viewport_paint_cached(viewport, dpi, left, top, right, bottom);
+    }
+    else
+    {
+        viewport_paint(viewport, dpi, left, top, right, bottom, sessions);
+    }
 
 #ifdef DEBUG_SHOW_DIRTY_BOX
     if (viewport != g_viewport_list)
@@ -816,30 +825,38 @@ void viewport_render(
 #endif
 }
 
-static void record_session(const paint_session* session, std::vector<paint_session>* recorded_sessions, size_t record_index)
+static void record_session(
+    const paint_session* session, std::vector<RecordedPaintSession>* recorded_sessions, size_t record_index)
 {
     // Perform a deep copy of the paint session, use relative offsets.
     // This is done to extract the session for benchmark.
     // Place the copied session at provided record_index, so the caller can decide which columns/paint sessions to copy; there
     // is no column information embedded in the session itself.
-    (*recorded_sessions)[record_index] = (*session);
-    paint_session* session_copy = &recorded_sessions->at(record_index);
+    const auto& arena = *session->PaintStructArena;
+    const size_t paintStructCount = arena.GetUsedCount(*session);
+    auto& recorded_session = recorded_sessions->at(record_index);
+    recorded_session.Session = *session;
+    recorded_session.Session.PaintStructArena = nullptr;
+    recorded_session.Entries.resize(paintStructCount);
+    for (size_t i = 0; i < paintStructCount; i++)
+    {
+        recorded_session.Entries[i] = arena.GetEntry(i);
+    }
 
-    // Mind the offset needs to be calculated against the original `session`, not `session_copy`
-    for (auto& ps : session_copy->PaintStructs)
+    // Mind the offset needs to be calculated against the original `session`, not the copy
+    for (auto& ps : recorded_session.Entries)
     {
         ps.basic.next_quadrant_ps = reinterpret_cast<paint_struct*>(
-            ps.basic.next_quadrant_ps ? int(ps.basic.next_quadrant_ps - &session->PaintStructs[0].basic)
-                                      : std::size(session->PaintStructs));
+            ps.basic.next_quadrant_ps ? arena.IndexOf(*session, ps.basic.next_quadrant_ps) : paintStructCount);
     }
-    for (auto& quad : session_copy->Quadrants)
+    for (auto& quad : recorded_session.Session.Quadrants)
     {
-        quad = reinterpret_cast<paint_struct*>(
-            quad ? int(quad - &session->PaintStructs[0].basic) : std::size(session->Quadrants));
+        quad = reinterpret_cast<paint_struct*>(quad ? arena.IndexOf(*session, quad) : paintStructCount);
     }
 }
 
-static void viewport_fill_column(paint_session* session, std::vector<paint_session>* recorded_sessions, size_t record_index)
+static void viewport_fill_column(
+    paint_session* session, std::vector<RecordedPaintSession>* recorded_sessions, size_t record_index)
 {
     paint_session_generate(session);
     if (recorded_sessions != nullptr)
@@ -849,52 +866,52 @@ static void viewport_fill_column(paint_session* session, std::vector<paint_sessi
     paint_session_arrange(session);
 }
 
-static void viewport_paint_column(paint_session* session)
+static void viewport_paint_column_background(rct_drawpixelinfo* dpi, uint32_t viewFlags)
 {
-    if (session->ViewFlags
+    if (viewFlags
             & (VIEWPORT_FLAG_HIDE_VERTICAL | VIEWPORT_FLAG_HIDE_BASE | VIEWPORT_FLAG_UNDERGROUND_INSIDE
                | VIEWPORT_FLAG_CLIP_VIEW)
-        && (~session->ViewFlags & VIEWPORT_FLAG_TRANSPARENT_BACKGROUND))
+        && (~viewFlags & VIEWPORT_FLAG_TRANSPARENT_BACKGROUND))
     {
         uint8_t colour = COLOUR_AQUAMARINE;
-        if (session->ViewFlags & VIEWPORT_FLAG_INVISIBLE_SPRITES)
+        if (viewFlags & VIEWPORT_FLAG_INVISIBLE_SPRITES)
         {
             colour = COLOUR_BLACK;
         }
-        gfx_clear(&session->DPI, colour);
+        gfx_clear(dpi, colour);
     }
+}
 
-    paint_draw_structs(session);
-
-    if (gConfigGeneral.render_weather_gloom && !gTrackDesignSaveMode && !(session->ViewFlags & VIEWPORT_FLAG_INVISIBLE_SPRITES)
-        && !(session->ViewFlags & VIEWPORT_FLAG_HIGHLIGHT_PATH_ISSUES))
+static void viewport_paint_column_foreground(
+    rct_drawpixelinfo* dpi, uint32_t viewFlags, const paint_string_struct* psStringHead)
+{
+    if (gConfigGeneral.render_weather_gloom && !gTrackDesignSaveMode && !(viewFlags & VIEWPORT_FLAG_INVISIBLE_SPRITES)
+        && !(viewFlags & VIEWPORT_FLAG_HIGHLIGHT_PATH_ISSUES))
     {
-        viewport_paint_weather_gloom(&session->DPI);
+        viewport_paint_weather_gloom(dpi);
     }
 
-    if (session->PSStringHead != nullptr)
+    if (psStringHead != nullptr)
     {
-        paint_draw_money_structs(&session->DPI, session->PSStringHead);
+        paint_draw_money_structs(dpi, psStringHead);
     }
+}
 
+static void viewport_paint_column(paint_session* session)
+{
+    viewport_paint_column_background(&session->DPI, session->ViewFlags);
+    paint_draw_structs(session);
+    viewport_paint_column_foreground(&session->DPI, session->ViewFlags, session->PSStringHead);
     paint_session_free(session);
 }
 
 /**
- *
- *  rct2: 0x00685CBF
- *  eax: left
- *  ebx: top
- *  edx: right
- *  esi: viewport
- *  edi: dpi
- *  ebp: bottom
+ * Gets the part of dpi the area from left, top to right, bottom of the viewport is drawn to, the area is in view
+ * coordinates.
  */
-void viewport_paint(
-    const rct_viewport* viewport, rct_drawpixelinfo* dpi, int16_t left, int16_t top, int16_t right, int16_t bottom,
-    std::vector<paint_session>* recorded_sessions)
+static rct_drawpixelinfo viewport_get_paint_dpi(
+    const rct_viewport* viewport, const rct_drawpixelinfo* dpi, int16_t left, int16_t top, int16_t right, int16_t bottom)
 {
-    uint32_t viewFlags = viewport->flags;
     uint16_t width = right - left;
     uint16_t height = bottom - top;
     uint16_t bitmask = viewport->zoom >= 0 ? 0xFFFF & (0xFFFF * viewport->zoom) : 0xFFFF;
@@ -903,8 +920,6 @@ void viewport_paint(
     height &= bitmask;
     left &= bitmask;
     top &= bitmask;
-    right = left + width;
-    bottom = top + height;
 
     int16_t x = static_cast<int16_t>(left - static_cast<int16_t>(viewport->viewPos.x & bitmask));
     x = x / viewport->zoom;
@@ -922,6 +937,26 @@ void viewport_paint(
     dpi1.height = height;
     dpi1.pitch = (dpi->width + dpi->pitch) - (width / viewport->zoom);
     dpi1.zoom_level = viewport->zoom;
+    return dpi1;
+}
+
+/**
+ *
+ *  rct2: 0x00685CBF
+ *  eax: left
+ *  ebx: top
+ *  edx: right
+ *  esi: viewport
+ *  edi: dpi
+ *  ebp: bottom
+ */
+void viewport_paint(
+    const rct_viewport* viewport, rct_drawpixelinfo* dpi, int16_t left, int16_t top, int16_t right, int16_t bottom,
+    std::vector<RecordedPaintSession>* recorded_sessions)
+{
+    uint32_t viewFlags = viewport->flags;
+    rct_drawpixelinfo dpi1 = viewport_get_paint_dpi(viewport, dpi, left, top, right, bottom);
+    int16_t x;
 
     // make sure, the compare operation is done in int16_t to avoid the loop becoming an infiniteloop.
     // this as well as the [x += 32] in the loop causes signed integer overflow -> undefined behaviour.
@@ -930,18 +965,7 @@ void viewport_paint(
 
     std::vector<paint_session*> columns;
 
-    bool useMultithreading = gConfigGeneral.multithreading;
-    if (useMultithreading && _paintJobs == nullptr)
-    {
-        _paintJobs = std::make_unique<JobPool>();
-    }
-    else if (useMultithreading == false && _paintJobs != nullptr)
-    {
-        _paintJobs.reset();
-    }
-
-    // Create space to record sessions and keep track which index is being drawn
-    size_t index = 0;
+    // Create space to record sessions
     if (recorded_sessions != nullptr)
     {
         const uint16_t columnSize = rightBorder - alignedX;
@@ -949,8 +973,8 @@ void viewport_paint(
         recorded_sessions->resize(columnCount);
     }
 
-    // Splits the area into 32 pixel columns and renders them
-    for (x = alignedX; x < rightBorder; x += 32, index++)
+    // Splits the area into 32 pixel columns, which are filled in parallel
+    for (x = alignedX; x < rightBorder; x += 32)
     {
         paint_session* session = paint_session_alloc(&dpi1, viewFlags);
         columns.push_back(session);
@@ -973,26 +997,136 @@ void viewport_paint(
             dpi2.pitch += rightPitch / dpi2.zoom_level;
         }
         dpi2.width = paintRight - dpi2.x;
+    }
 
-        if (useMultithreading)
+    if (gConfigGeneral.multithreading)
+    {
+        TaskScheduler::GetDefault().ParallelFor(
+            0, columns.size(), 1, [&columns, recorded_sessions](size_t i) -> void {
+                viewport_fill_column(columns[i], recorded_sessions, i);
+            });
+    }
+    else
+    {
+        for (size_t i = 0; i < columns.size(); i++)
         {
-            _paintJobs->AddTask(
-                [session, recorded_sessions, index]() -> void { viewport_fill_column(session, recorded_sessions, index); });
+            viewport_fill_column(columns[i], recorded_sessions, i);
         }
-        else
+    }
+
+    for (auto&& column : columns)
+    {
+        viewport_paint_column(column);
+    }
+}
+
+/**
+ * Paints the area from left, top to right, bottom of the viewport in cells, cells that have not changed since they
+ * were last painted are drawn from the paint cache. Cells are only painted for the cache, they are drawn clipped to
+ * the area.
+ */
+static void viewport_paint_cached(
+    const rct_viewport* viewport, rct_drawpixelinfo* dpi, int16_t left, int16_t top, int16_t right, int16_t bottom)
+{
+    struct PaintCell
+    {
+        rct_drawpixelinfo DPI;
+        CoordsXY Position;
+        const PaintDrawList* DrawList;
+    };
+
+    const uint32_t viewFlags = viewport->flags;
+    const uint8_t rotation = get_current_rotation();
+    const rct_drawpixelinfo dpi1 = viewport_get_paint_dpi(viewport, dpi, left, top, right, bottom);
+    const int32_t stride = dpi1.width / dpi1.zoom_level + dpi1.pitch;
+    const int32_t cellHeight = paint_cache_get_cell_height(dpi1.zoom_level);
+    const int32_t rightBorder = dpi1.x + dpi1.width;
+    const int32_t bottomBorder = dpi1.y + dpi1.height;
+
+    paint_cache_trim();
+
+    std::vector<PaintCell> cells;
+    std::vector<size_t> misses;
+    for (int32_t x = floor2(dpi1.x, PAINT_CACHE_CELL_WIDTH); x < rightBorder; x += PAINT_CACHE_CELL_WIDTH)
+    {
+        for (int32_t y = floor2(dpi1.y, cellHeight); y < bottomBorder; y += cellHeight)
         {
-            viewport_fill_column(session, recorded_sessions, index);
+            PaintCell cell{};
+            cell.Position = { x, y };
+
+            // The part of the cell inside the area.
+            const int32_t drawLeft = std::max<int32_t>(x, dpi1.x);
+            const int32_t drawTop = std::max<int32_t>(y, dpi1.y);
+            const int32_t drawRight = std::min(x + PAINT_CACHE_CELL_WIDTH, rightBorder);
+            const int32_t drawBottom = std::min(y + cellHeight, bottomBorder);
+            cell.DPI = dpi1;
+            cell.DPI.bits += (drawLeft - dpi1.x) / dpi1.zoom_level + ((drawTop - dpi1.y) / dpi1.zoom_level) * stride;
+            cell.DPI.x = drawLeft;
+            cell.DPI.y = drawTop;
+            cell.DPI.width = drawRight - drawLeft;
+            cell.DPI.height = drawBottom - drawTop;
+            cell.DPI.pitch = stride - cell.DPI.width / dpi1.zoom_level;
+
+            cell.DrawList = paint_cache_get(cell.Position, dpi1.zoom_level, viewFlags, rotation);
+            if (cell.DrawList == nullptr)
+            {
+                misses.push_back(cells.size());
+            }
+            cells.push_back(cell);
         }
     }
 
-    if (useMultithreading)
+    // Cells are painted in batches so only a limited number of paint sessions is needed when all cells are missing.
+    constexpr size_t MaxSessions = 64;
+    std::vector<paint_session*> sessions;
+    for (size_t batchBegin = 0; batchBegin < misses.size(); batchBegin += MaxSessions)
     {
-        _paintJobs->Join();
+        const size_t batchEnd = std::min(batchBegin + MaxSessions, misses.size());
+        sessions.clear();
+        for (size_t i = batchBegin; i < batchEnd; i++)
+        {
+            const auto& cell = cells[misses[i]];
+            rct_drawpixelinfo paintDpi = dpi1;
+            paintDpi.bits = nullptr;
+            paintDpi.x = cell.Position.x;
+            paintDpi.y = cell.Position.y;
+            paintDpi.width = PAINT_CACHE_CELL_WIDTH;
+            paintDpi.height = cellHeight;
+            paintDpi.pitch = 0;
+            sessions.push_back(paint_session_alloc(&paintDpi, viewFlags));
+        }
+
+        if (gConfigGeneral.multithreading)
+        {
+            TaskScheduler::GetDefault().ParallelFor(
+                0, sessions.size(), 1, [&sessions](size_t i) -> void { viewport_fill_column(sessions[i], nullptr, 0); });
+        }
+        else
+        {
+            for (auto session : sessions)
+            {
+                viewport_fill_column(session, nullptr, 0);
+            }
+        }
+
+        for (size_t i = batchBegin; i < batchEnd; i++)
+        {
+            auto& cell = cells[misses[i]];
+            auto session = sessions[i - batchBegin];
+            auto& drawList = paint_cache_insert(cell.Position, dpi1.zoom_level, viewFlags, rotation);
+            paint_session_record(session, drawList);
+            paint_session_free(session);
+            cell.DrawList = &drawList;
+        }
     }
 
-    for (auto&& column : columns)
+    for (const auto& cell : cells)
     {
-        viewport_paint_column(column);
+        auto cellDpi = cell.DPI;
+        viewport_paint_column_background(&cellDpi, viewFlags);
+        paint_draw_list(&cellDpi, *cell.DrawList);
+        viewport_paint_column_foreground(
+            &cellDpi, viewFlags, cell.DrawList->Strings.empty() ? nullptr : &cell.DrawList->Strings[0]);
     }
 }
 
@@ -32,7 +32,7 @@
 // This string specifies which version of network stream current build uses.
 // It is used for making sure only compatible builds get connected, even within
 // single OpenRCT2 version.
-#define NETWORK_STREAM_VERSION "18"
+#define NETWORK_STREAM_VERSION "21"
 #define NETWORK_STREAM_ID OPENRCT2_VERSION "-" NETWORK_STREAM_VERSION
 
 static Peep* _pickup_peep = nullptr;
@@ -70,6 +70,7 @@ static constexpr uint32_t CHUNK_SIZE = 1024 * 63;
 #    include "NetworkConnection.h"
 #    include "NetworkGroup.h"
 #    include "NetworkKey.h"
+#    include "NetworkMap.h"
 #    include "NetworkPacket.h"
 #    include "NetworkPlayer.h"
 #    include "NetworkServerAdvertiser.h"
@@ -257,6 +258,9 @@ private:
     bool wsa_initialized = false;
     bool _clientMapLoaded = false;
     std::unique_ptr<ITcpSocket> _listenSocket;
+    // Which of the listening socket and client sockets are ready, so the others can be skipped.
+    std::unique_ptr<ISocketPoller> _socketPoller;
+    std::vector<SocketPollEvent> _socketEvents;
     std::unique_ptr<NetworkConnection> _serverConnection;
     std::unique_ptr<INetworkServerAdvertiser> _advertiser;
     uint16_t listening_port = 0;
@@ -265,6 +269,10 @@ private:
     uint8_t player_id = 0;
     std::list<std::unique_ptr<NetworkConnection>> client_connection_list;
     std::vector<uint8_t> chunk_buffer;
+    NetworkMapCache _mapCache;
+    // The last map received from a server, kept after disconnecting so reconnecting can be sent only what changed.
+    std::vector<uint8_t> _lastMap;
+    NetworkMapHash _lastMapHash{};
     std::string _host;
     uint16_t _port = 0;
     std::string _password;
@@ -315,7 +323,7 @@ private:
     void Client_Handle_GAMESTATE(NetworkConnection& connection, NetworkPacket& packet);
     void Server_Handle_OBJECTS(NetworkConnection& connection, NetworkPacket& packet);
 
-    uint8_t* save_for_network(size_t& out_size, const std::vector<const ObjectRepositoryItem*>& objects) const;
+    std::shared_ptr<NetworkMap> save_for_network(const std::vector<const ObjectRepositoryItem*>& objects) const;
 
     std::ofstream _chat_log_fs;
     std::ofstream _server_log_fs;
@@ -425,6 +433,7 @@ void Network::Close()
         _serverTickData.clear();
         _pendingPlayerLists.clear();
         _pendingPlayerInfo.clear();
+        _mapCache.Clear();
 
         gfx_invalidate_screen();
 
@@ -455,6 +464,7 @@ void Network::CloseConnection()
     }
     else if (mode == NETWORK_MODE_SERVER)
     {
+        _socketPoller.reset();
         _listenSocket.reset();
         _advertiser.reset();
     }
@@ -585,6 +595,8 @@ bool Network::BeginServer(uint16_t port, const std::string& address)
     try
     {
         _listenSocket->Listen(address, port);
+        _socketPoller = CreateSocketPoller();
+        _socketPoller->Add(*_listenSocket, nullptr, SOCKET_EVENT_READ);
     }
     catch (const std::exception& ex)
     {
@@ -727,6 +739,20 @@ void Network::Flush()
 
 void Network::UpdateServer()
 {
+    bool canAccept = false;
+    _socketPoller->Wait(_socketEvents, 0);
+    for (const auto& event : _socketEvents)
+    {
+        if (event.Tag == nullptr)
+        {
+            canAccept = true;
+        }
+        else
+        {
+            static_cast<NetworkConnection*>(event.Tag)->ReadyEvents |= event.Events;
+        }
+    }
+
     for (auto& connection : client_connection_list)
     {
         // This can be called multiple times before the connection is removed.
@@ -740,9 +766,26 @@ void Network::UpdateServer()
         else
         {
             DecayCooldown(connection->Player);
+
+            // Packets still queued mean the socket is full, they are sent when the poller says there is space again.
+            // Otherwise it is taken to have space, so packets queued before the next update are sent straight away.
+            uint32_t events = SOCKET_EVENT_READ;
+            if (connection->HasQueuedPackets())
+            {
+                events |= SOCKET_EVENT_WRITE;
+                connection->ReadyEvents = 0;
+            }
+            else
+            {
+                connection->ReadyEvents = SOCKET_EVENT_WRITE;
+            }
+            _socketPoller->Modify(*connection->Socket, connection.get(), events);
         }
     }
 
+    // The game state can change before the next update, a map saved now can not be sent to clients joining later.
+    _mapCache.ReleaseCurrent();
+
     uint32_t ticks = platform_get_ticks();
     if (ticks > last_ping_sent_time + 3000)
     {
@@ -755,10 +798,13 @@ void Network::UpdateServer()
         _advertiser->Update();
     }
 
-    std::unique_ptr<ITcpSocket> tcpSocket = _listenSocket->Accept();
-    if (tcpSocket != nullptr)
+    if (canAccept)
     {
-        AddClient(std::move(tcpSocket));
+        std::unique_ptr<ITcpSocket> tcpSocket;
+        while ((tcpSocket = _listenSocket->Accept()) != nullptr)
+        {
+            AddClient(std::move(tcpSocket));
+        }
     }
 }
 
@@ -954,7 +1000,7 @@ void Network::SendPacketToClients(NetworkPacket& packet, bool front, bool gameCm
                 continue;
             }
         }
-        client_connection->QueuePacket(NetworkPacket::Duplicate(packet), front);
+        client_connection->QueuePacket(packet, front);
     }
 }
 
@@ -1459,6 +1505,11 @@ void Network::Client_Send_OBJECTS(const std::vector<std::string>& objects)
         log_verbose("client requests object %s", object.c_str());
         packet->Write(reinterpret_cast<const uint8_t*>(object.c_str()), 8);
     }
+    // Servers that still have the last map we received send only what changed since.
+    if (!_lastMap.empty())
+    {
+        packet->Write(_lastMapHash.data(), _lastMapHash.size());
+    }
     _serverConnection->QueuePacket(std::move(packet));
 }
 
@@ -1577,24 +1628,52 @@ void Network::Server_Send_MAP(NetworkConnection* connection)
         objects = objManager.GetPackableObjects();
     }
 
-    size_t out_size;
-    uint8_t* header = save_for_network(out_size, objects);
-    if (header == nullptr)
+    // Clients joining at the same time get the same map, compressed once.
+    const int32_t level = std::clamp(gConfigNetwork.map_compression_level, 1, 9);
+    std::shared_ptr<const NetworkMap> map;
+    if (connection != nullptr)
     {
-        if (connection)
+        map = _mapCache.GetCurrent(objects);
+    }
+    if (map == nullptr)
+    {
+        map = save_for_network(objects);
+        if (map == nullptr)
         {
-            connection->SetLastDisconnectReason(STR_MULTIPLAYER_CONNECTION_CLOSED);
-            connection->Socket->Disconnect();
+            if (connection)
+            {
+                connection->SetLastDisconnectReason(STR_MULTIPLAYER_CONNECTION_CLOSED);
+                connection->Socket->Disconnect();
+            }
+            return;
+        }
+        _mapCache.Add(map);
+    }
+
+    const std::vector<uint8_t>* payload = &map->Payload;
+    std::vector<uint8_t> delta;
+    if (connection != nullptr && connection->HeldMapHash.has_value())
+    {
+        auto heldMap = _mapCache.Find(*connection->HeldMapHash);
+        if (heldMap != nullptr)
+        {
+            delta = network_map_create_delta(*heldMap, *map, level);
+            if (!delta.empty() && delta.size() < payload->size())
+            {
+                log_verbose("Sending difference to the map held by the client, %u bytes", static_cast<uint32_t>(delta.size()));
+                payload = &delta;
+            }
         }
-        return;
     }
+
+    const size_t out_size = payload->size();
     size_t chunksize = CHUNK_SIZE;
     for (size_t i = 0; i < out_size; i += chunksize)
     {
         size_t datasize = std::min(chunksize, out_size - i);
         std::unique_ptr<NetworkPacket> packet(NetworkPacket::Allocate());
         *packet << static_cast<uint32_t>(NETWORK_COMMAND_MAP) << static_cast<uint32_t>(out_size) << static_cast<uint32_t>(i);
-        packet->Write(&header[i], datasize);
+        packet->Write(&(*payload)[i], datasize);
         if (connection)
         {
             connection->QueuePacket(std::move(packet));
@@ -1604,13 +1683,10 @@ void Network::Server_Send_MAP(NetworkConnection* connection)
             SendPacketToClients(*packet);
         }
     }
-    free(header);
 }
 
-uint8_t* Network::save_for_network(size_t& out_size, const std::vector<const ObjectRepositoryItem*>& objects) const
+std::shared_ptr<NetworkMap> Network::save_for_network(const std::vector<const ObjectRepositoryItem*>& objects) const
 {
-    uint8_t* header = nullptr;
-    out_size = 0;
     bool RLEState = gUseRLE;
     gUseRLE = false;
 
@@ -1622,42 +1698,9 @@ uint8_t* Network::save_for_network(size_t& out_size, const std::vector<const Obj
     }
     gUseRLE = RLEState;
 
-    const void* data = ms.GetData();
-    int32_t size = ms.GetLength();
-
-    uint8_t* compressed = util_zlib_deflate(static_cast<const uint8_t*>(data), size, &out_size);
-    if (compressed != nullptr)
-    {
-        header = reinterpret_cast<uint8_t*>(_strdup("open2_sv6_zlib"));
-        size_t header_len = strlen(reinterpret_cast<char*>(header)) + 1; // account for null terminator
-        header = static_cast<uint8_t*>(realloc(header, header_len + out_size));
-        if (header == nullptr)
-        {
-            log_error("Failed to allocate %u bytes.", header_len + out_size);
-        }
-        else
-        {
-            std::memcpy(&header[header_len], compressed, out_size);
-            out_size += header_len;
-            log_verbose("Sending map of size %u bytes, compressed to %u bytes", size, out_size);
-        }
-        free(compressed);
-    }
-    else
-    {
-        log_warning("Failed to compress the data, falling back to non-compressed sv6.");
-        header = static_cast<uint8_t*>(malloc(size));
-        if (header == nullptr)
-        {
-            log_error("Failed to allocate %u bytes.", size);
-        }
-        else
-        {
-            out_size = size;
-            std::memcpy(header, data, size);
-        }
-    }
-    return header;
+    const uint8_t* data = static_cast<const uint8_t*>(ms.GetData());
+    return network_map_create(
+        std::vector<uint8_t>(data, data + ms.GetLength()), objects, std::clamp(gConfigNetwork.map_compression_level, 1, 9));
 }
 
 void Network::Client_Send_CHAT(const char* text)
@@ -1686,7 +1729,7 @@ void Network::Server_Send_CHAT(const char* text, const std::vector<uint8_t>& pla
             auto conn = GetPlayerConnection(playerId);
             if (conn != nullptr && !conn->IsDisconnected)
             {
-                conn->QueuePacket(NetworkPacket::Duplicate(*packet));
+                conn->QueuePacket(*packet);
             }
         }
     }
@@ -1889,9 +1932,13 @@ void Network::Server_Send_EVENT_PLAYER_DISCONNECTED(const char* playerName, cons
 
 bool Network::ProcessConnection(NetworkConnection& connection)
 {
-    int32_t packetStatus;
+    int32_t packetStatus = NETWORK_READPACKET_NO_DATA;
     do
     {
+        if (!(connection.ReadyEvents & SOCKET_EVENT_READ))
+        {
+            break;
+        }
         packetStatus = connection.ReadPacket();
         switch (packetStatus)
         {
@@ -1918,7 +1965,10 @@ bool Network::ProcessConnection(NetworkConnection& connection)
                 break;
         }
     } while (packetStatus == NETWORK_READPACKET_MORE_DATA || packetStatus == NETWORK_READPACKET_SUCCESS);
-    connection.SendQueuedPackets();
+    if (connection.ReadyEvents & SOCKET_EVENT_WRITE)
+    {
+        connection.SendQueuedPackets();
+    }
     if (!connection.ReceivedPacketRecently())
     {
         if (!connection.GetLastDisconnectReason())
@@ -2165,6 +2215,10 @@ void Network::ProcessDisconnectedClients()
         {
             ServerClientDisconnected(connection);
             RemovePlayer(connection);
+            if (connection->Socket != nullptr)
+            {
+                _socketPoller->Remove(*connection->Socket);
+            }
 
             it = client_connection_list.erase(it);
         }
@@ -2185,6 +2239,8 @@ void Network::AddClient(std::unique_ptr<ITcpSocket>&& socket)
     // Store connection
     auto connection = std::make_unique<NetworkConnection>();
     connection->Socket = std::move(socket);
+    connection->ReadyEvents = SOCKET_EVENT_WRITE;
+    _socketPoller->Add(*connection->Socket, connection.get(), SOCKET_EVENT_READ);
 
     client_connection_list.push_back(std::move(connection));
 }
@@ -2697,6 +2753,14 @@ void Network::Server_Handle_OBJECTS(NetworkConnection& connection, NetworkPacket
         }
     }
 
+    NetworkMapHash heldMapHash;
+    const uint8_t* heldMapHashData = packet.Read(heldMapHash.size());
+    if (heldMapHashData != nullptr)
+    {
+        std::copy_n(heldMapHashData, heldMapHash.size(), heldMapHash.begin());
+        connection.HeldMapHash = heldMapHash;
+    }
+
     const char* player_name = static_cast<const char*>(connection.Player->Name.c_str());
     Server_Send_MAP(&connection);
     Server_Send_EVENT_PLAYER_JOINED(player_name);
@@ -2859,29 +2923,19 @@ void Network::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connection,
         GameActions::ResumeQueue();
 
         context_force_close_window_by_class(WC_NETWORK_STATUS);
-        bool has_to_free = false;
-        uint8_t* data = &chunk_buffer[0];
-        size_t data_size = size;
-        // zlib-compressed
-        if (strcmp("open2_sv6_zlib", reinterpret_cast<char*>(&chunk_buffer[0])) == 0)
+        std::vector<uint8_t> map;
+        try
         {
-            log_verbose("Received zlib-compressed sv6 map");
-            has_to_free = true;
-            size_t header_len = strlen("open2_sv6_zlib") + 1;
-            data = util_zlib_inflate(&chunk_buffer[header_len], size - header_len, &data_size);
-            if (data == nullptr)
-            {
-                log_warning("Failed to decompress data sent from server.");
-                Close();
-                return;
-            }
+            map = network_map_decode(chunk_buffer.data(), size, _lastMap, _lastMapHash);
         }
-        else
+        catch (const std::exception& e)
         {
-            log_verbose("Assuming received map is in plain sv6 format");
+            log_warning("Failed to decode map sent from server: %s", e.what());
+            Close();
+            return;
         }
 
-        auto ms = MemoryStream(data, data_size);
+        auto ms = MemoryStream(map.data(), map.size());
         if (LoadMap(&ms))
         {
             game_load_init();
@@ -2897,6 +2951,9 @@ void Network::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connection,
 
             // Fix invalid vehicle sprite sizes, thus preventing visual corruption of sprites
             fix_invalid_vehicle_sprite_sizes();
+
+            _lastMapHash = Crypt::SHA1(map.data(), map.size());
+            _lastMap = std::move(map);
         }
         else
         {
@@ -2904,10 +2961,6 @@ void Network::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connection,
             auto loadOrQuitAction = LoadOrQuitAction(LoadOrQuitModes::OpenSavePrompt, PM_SAVE_BEFORE_QUIT);
             GameActions::Execute(&loadOrQuitAction);
         }
-        if (has_to_free)
-        {
-            free(data);
-        }
     }
 }
 
@@ -2956,6 +3009,8 @@ bool Network::LoadMap(IStream* stream)
         gCheatsDisableRideValueAging = stream->ReadValue<uint8_t>() != 0;
         gConfigGeneral.show_real_names_of_guests = stream->ReadValue<uint8_t>() != 0;
         gCheatsIgnoreResearchStatus = stream->ReadValue<uint8_t>() != 0;
+        gCheatsFastPathfinding = stream->ReadValue<uint8_t>() != 0;
+        gCheatsFastRideRatings = stream->ReadValue<uint8_t>() != 0;
 
         gLastAutoSaveUpdate = AUTOSAVE_PAUSE;
         result = true;
@@ -3005,6 +3060,8 @@ bool Network::SaveMap(IStream* stream, const std::vector<const ObjectRepositoryI
         stream->WriteValue<uint8_t>(gCheatsDisableRideValueAging);
         stream->WriteValue<uint8_t>(gConfigGeneral.show_real_names_of_guests);
         stream->WriteValue<uint8_t>(gCheatsIgnoreResearchStatus);
+        stream->WriteValue<uint8_t>(gCheatsFastPathfinding);
+        stream->WriteValue<uint8_t>(gCheatsFastRideRatings);
 
         result = true;
     }
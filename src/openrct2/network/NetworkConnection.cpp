@@ -17,7 +17,13 @@
 #    include "Socket.h"
 #    include "network.h"
 
+#    include <algorithm>
+#    include <cstring>
+
 constexpr size_t NETWORK_DISCONNECT_REASON_BUFFER_SIZE = 256;
+// Packets are small, sending several in one go saves a call into the system for each.
+constexpr size_t MAX_PACKETS_PER_SEND = 32;
+constexpr size_t RECEIVE_BUFFER_SIZE = 16 * 1024;
 
 NetworkConnection::NetworkConnection()
 {
@@ -31,115 +37,169 @@ NetworkConnection::~NetworkConnection()
 
 int32_t NetworkConnection::ReadPacket()
 {
-    if (InboundPacket.BytesTransferred < sizeof(InboundPacket.Size))
+    const size_t headerSize = sizeof(InboundPacket.Size);
+    if (_receiveBufferOffset == _receiveBufferLength)
     {
-        // read packet size
-        void* buffer = &(reinterpret_cast<char*>(&InboundPacket.Size))[InboundPacket.BytesTransferred];
-        size_t bufferLength = sizeof(InboundPacket.Size) - InboundPacket.BytesTransferred;
         size_t readBytes;
-        NETWORK_READPACKET status = Socket->ReceiveData(buffer, bufferLength, &readBytes);
-        if (status != NETWORK_READPACKET_SUCCESS)
+        NETWORK_READPACKET status;
+        size_t remaining = headerSize + InboundPacket.Size - InboundPacket.BytesTransferred;
+        if (InboundPacket.BytesTransferred >= headerSize && remaining >= RECEIVE_BUFFER_SIZE)
         {
-            return status;
-        }
-
-        InboundPacket.BytesTransferred += readBytes;
-        if (InboundPacket.BytesTransferred == sizeof(InboundPacket.Size))
-        {
-            InboundPacket.Size = Convert::NetworkToHost(InboundPacket.Size);
-            if (InboundPacket.Size == 0) // Can't have a size 0 packet
+            // The rest of large packets is read straight into the packet.
+            status = Socket->ReceiveData(
+                &InboundPacket.GetData()[InboundPacket.BytesTransferred - headerSize], remaining, &readBytes);
+            if (status != NETWORK_READPACKET_SUCCESS)
             {
-                return NETWORK_READPACKET_DISCONNECTED;
+                return status;
             }
-            InboundPacket.Data->resize(InboundPacket.Size);
+            InboundPacket.BytesTransferred += readBytes;
         }
-    }
-    else
-    {
-        // read packet data
-        if (InboundPacket.Data->capacity() > 0)
+        else
         {
-            void* buffer = &InboundPacket.GetData()[InboundPacket.BytesTransferred - sizeof(InboundPacket.Size)];
-            size_t bufferLength = sizeof(InboundPacket.Size) + InboundPacket.Size - InboundPacket.BytesTransferred;
-            size_t readBytes;
-            NETWORK_READPACKET status = Socket->ReceiveData(buffer, bufferLength, &readBytes);
+            _receiveBuffer.resize(RECEIVE_BUFFER_SIZE);
+            status = Socket->ReceiveData(_receiveBuffer.data(), _receiveBuffer.size(), &readBytes);
             if (status != NETWORK_READPACKET_SUCCESS)
             {
                 return status;
             }
-
-            InboundPacket.BytesTransferred += readBytes;
+            _receiveBufferOffset = 0;
+            _receiveBufferLength = readBytes;
         }
-        if (InboundPacket.BytesTransferred == sizeof(InboundPacket.Size) + InboundPacket.Size)
-        {
-            _lastPacketTime = platform_get_ticks();
+    }
 
-            RecordPacketStats(InboundPacket, false);
+    if (InboundPacket.BytesTransferred < headerSize)
+    {
+        // read packet size
+        size_t readBytes = std::min(headerSize - InboundPacket.BytesTransferred, _receiveBufferLength - _receiveBufferOffset);
+        std::memcpy(
+            &(reinterpret_cast<uint8_t*>(&InboundPacket.Size))[InboundPacket.BytesTransferred],
+            &_receiveBuffer[_receiveBufferOffset], readBytes);
+        _receiveBufferOffset += readBytes;
+        InboundPacket.BytesTransferred += readBytes;
+        if (InboundPacket.BytesTransferred < headerSize)
+        {
+            return NETWORK_READPACKET_MORE_DATA;
+        }
 
-            return NETWORK_READPACKET_SUCCESS;
+        InboundPacket.Size = Convert::NetworkToHost(InboundPacket.Size);
+        if (InboundPacket.Size == 0) // Can't have a size 0 packet
+        {
+            return NETWORK_READPACKET_DISCONNECTED;
         }
+        InboundPacket.Data->resize(InboundPacket.Size);
     }
-    return NETWORK_READPACKET_MORE_DATA;
-}
 
-bool NetworkConnection::SendPacket(NetworkPacket& packet)
-{
-    uint16_t sizen = Convert::HostToNetwork(packet.Size);
-    std::vector<uint8_t> tosend;
-    tosend.reserve(sizeof(sizen) + packet.Size);
-    tosend.insert(tosend.end(), reinterpret_cast<uint8_t*>(&sizen), reinterpret_cast<uint8_t*>(&sizen) + sizeof(sizen));
-    tosend.insert(tosend.end(), packet.Data->begin(), packet.Data->end());
-
-    const void* buffer = &tosend[packet.BytesTransferred];
-    size_t bufferSize = tosend.size() - packet.BytesTransferred;
-    size_t sent = Socket->SendData(buffer, bufferSize);
-    if (sent > 0)
+    // read packet data
+    size_t remaining = headerSize + InboundPacket.Size - InboundPacket.BytesTransferred;
+    size_t readBytes = std::min(remaining, _receiveBufferLength - _receiveBufferOffset);
+    if (readBytes > 0)
     {
-        packet.BytesTransferred += sent;
+        std::memcpy(
+            &InboundPacket.GetData()[InboundPacket.BytesTransferred - headerSize], &_receiveBuffer[_receiveBufferOffset],
+            readBytes);
+        _receiveBufferOffset += readBytes;
+        InboundPacket.BytesTransferred += readBytes;
     }
-
-    bool sendComplete = packet.BytesTransferred == tosend.size();
-    if (sendComplete)
+    if (InboundPacket.BytesTransferred == headerSize + InboundPacket.Size)
     {
-        RecordPacketStats(packet, true);
+        _lastPacketTime = platform_get_ticks();
+
+        RecordPacketStats(InboundPacket, false);
+
+        return NETWORK_READPACKET_SUCCESS;
     }
-    return sendComplete;
+    return NETWORK_READPACKET_MORE_DATA;
 }
 
 void NetworkConnection::QueuePacket(std::unique_ptr<NetworkPacket> packet, bool front)
 {
-    if (AuthStatus == NETWORK_AUTH_OK || !packet->CommandRequiresAuth())
+    QueuePacket(*packet, front);
+}
+
+void NetworkConnection::QueuePacket(const NetworkPacket& packet, bool front)
+{
+    if (AuthStatus == NETWORK_AUTH_OK || !packet.CommandRequiresAuth())
     {
-        packet->Size = static_cast<uint16_t>(packet->Data->size());
+        // Only the data is shared, the size and progress of sending are per connection.
+        NetworkPacket queued;
+        queued.Data = packet.Data;
+        queued.Size = static_cast<uint16_t>(packet.Data->size());
         if (front)
         {
             // If the first packet was already partially sent add new packet to second position
-            if (!_outboundPackets.empty() && _outboundPackets.front()->BytesTransferred > 0)
+            if (!_outboundPackets.empty() && _outboundPackets.front().BytesTransferred > 0)
             {
-                auto it = _outboundPackets.begin();
-                it++; // Second position
-                _outboundPackets.insert(it, std::move(packet));
+                _outboundPackets.insert(_outboundPackets.begin() + 1, std::move(queued));
             }
             else
             {
-                _outboundPackets.push_front(std::move(packet));
+                _outboundPackets.push_front(std::move(queued));
             }
         }
         else
         {
-            _outboundPackets.push_back(std::move(packet));
+            _outboundPackets.push_back(std::move(queued));
         }
     }
 }
 
 void NetworkConnection::SendQueuedPackets()
 {
-    while (!_outboundPackets.empty() && SendPacket(*_outboundPackets.front()))
+    // Each packet is sent as its size followed by its data, the sizes need to outlive the send.
+    SocketBuffer buffers[MAX_PACKETS_PER_SEND * 2];
+    uint16_t sizes[MAX_PACKETS_PER_SEND];
+    while (!_outboundPackets.empty())
     {
-        _outboundPackets.remove(_outboundPackets.front());
+        size_t numPackets = std::min(_outboundPackets.size(), MAX_PACKETS_PER_SEND);
+        size_t numBuffers = 0;
+        size_t bufferSize = 0;
+        for (size_t i = 0; i < numPackets; i++)
+        {
+            const auto& packet = _outboundPackets[i];
+            sizes[i] = Convert::HostToNetwork(packet.Size);
+            size_t skip = packet.BytesTransferred;
+            if (skip < sizeof(sizes[i]))
+            {
+                buffers[numBuffers++] = { reinterpret_cast<uint8_t*>(&sizes[i]) + skip, sizeof(sizes[i]) - skip };
+                skip = 0;
+            }
+            else
+            {
+                skip -= sizeof(sizes[i]);
+            }
+            buffers[numBuffers++] = { packet.Data->data() + skip, packet.Data->size() - skip };
+            bufferSize += sizeof(sizes[i]) + packet.Data->size() - packet.BytesTransferred;
+        }
+
+        const size_t totalSent = Socket->SendData(buffers, numBuffers);
+        size_t sent = totalSent;
+        while (sent > 0)
+        {
+            auto& packet = _outboundPackets.front();
+            size_t remaining = sizeof(uint16_t) + packet.Size - packet.BytesTransferred;
+            if (sent < remaining)
+            {
+                packet.BytesTransferred += sent;
+                break;
+            }
+            packet.BytesTransferred += remaining;
+            sent -= remaining;
+            RecordPacketStats(packet, true);
+            _outboundPackets.pop_front();
+        }
+        if (totalSent < bufferSize)
+        {
+            // The socket is not taking any more for now.
+            break;
+        }
     }
 }
 
+bool NetworkConnection::HasQueuedPackets() const
+{
+    return !_outboundPackets.empty();
+}
+
 void NetworkConnection::ResetLastPacketTime()
 {
     _lastPacketTime = platform_get_ticks();
@@ -12,12 +12,14 @@
 #ifndef DISABLE_NETWORK
 #    include "../common.h"
 #    include "NetworkKey.h"
+#    include "NetworkMap.h"
 #    include "NetworkPacket.h"
 #    include "NetworkTypes.h"
 #    include "Socket.h"
 
-#    include <list>
+#    include <deque>
 #    include <memory>
+#    include <optional>
 #    include <vector>
 
 class NetworkPlayer;
@@ -35,14 +37,23 @@ public:
     NetworkKey Key;
     std::vector<uint8_t> Challenge;
     std::vector<const ObjectRepositoryItem*> RequestedObjects;
+    // The map the client received last, if it still has one.
+    std::optional<NetworkMapHash> HeldMapHash;
     bool IsDisconnected = false;
+    // What the socket is ready for, SOCKET_EVENT flags. Without a poller saying otherwise it is ready for everything.
+    uint32_t ReadyEvents = SOCKET_EVENT_READ | SOCKET_EVENT_WRITE;
 
     NetworkConnection();
     ~NetworkConnection();
 
     int32_t ReadPacket();
     void QueuePacket(std::unique_ptr<NetworkPacket> packet, bool front = false);
+    /**
+     * Queues a packet that shares its data with the given one, for sending the same packet to many connections.
+     */
+    void QueuePacket(const NetworkPacket& packet, bool front = false);
     void SendQueuedPackets();
+    bool HasQueuedPackets() const;
     void ResetLastPacketTime();
     bool ReceivedPacketRecently();
 
@@ -51,12 +62,16 @@ public:
     void SetLastDisconnectReason(const rct_string_id string_id, void* args = nullptr);
 
 private:
-    std::list<std::unique_ptr<NetworkPacket>> _outboundPackets;
+    // Packets are sent from the front, as many as the socket takes at a time.
+    std::deque<NetworkPacket> _outboundPackets;
+    // Data received but not yet read into a packet, so small packets do not take a call into the system each.
+    std::vector<uint8_t> _receiveBuffer;
+    size_t _receiveBufferOffset = 0;
+    size_t _receiveBufferLength = 0;
     uint32_t _lastPacketTime = 0;
     utf8* _lastDisconnectReason = nullptr;
 
     void RecordPacketStats(const NetworkPacket& packet, bool sending);
-    bool SendPacket(NetworkPacket& packet);
 };
 
 #endif // DISABLE_NETWORK
@@ -0,0 +1,174 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifndef DISABLE_NETWORK
+
+#    include "NetworkMap.h"
+
+#    include "../Diagnostic.h"
+#    include "../util/Util.h"
+
+#    include <algorithm>
+#    include <cstdlib>
+#    include <cstring>
+#    include <stdexcept>
+
+// Headers are null terminated. Payloads without either header are plain maps.
+static constexpr const char* MAP_HEADER_ZLIB = "open2_sv6_zlib";
+static constexpr const char* MAP_HEADER_DELTA = "open2_sv6_delta";
+
+static void append_header(std::vector<uint8_t>& payload, const char* header)
+{
+    payload.insert(payload.end(), header, header + std::strlen(header) + 1);
+}
+
+static bool has_header(const uint8_t* payload, size_t size, const char* header)
+{
+    const size_t headerLength = std::strlen(header) + 1;
+    return size >= headerLength && std::memcmp(payload, header, headerLength) == 0;
+}
+
+static bool append_compressed(std::vector<uint8_t>& payload, const uint8_t* data, size_t size, int32_t level)
+{
+    size_t compressedSize = 0;
+    uint8_t* compressed = util_zlib_deflate(data, size, &compressedSize, level);
+    if (compressed == nullptr)
+    {
+        return false;
+    }
+    payload.insert(payload.end(), compressed, compressed + compressedSize);
+    free(compressed);
+    return true;
+}
+
+static std::vector<uint8_t> decompress(const uint8_t* data, size_t size, size_t sizeHint)
+{
+    size_t decompressedSize = sizeHint;
+    uint8_t* decompressed = util_zlib_inflate(const_cast<uint8_t*>(data), size, &decompressedSize);
+    if (decompressed == nullptr)
+    {
+        throw std::runtime_error("Failed to decompress map.");
+    }
+    std::vector<uint8_t> result(decompressed, decompressed + decompressedSize);
+    free(decompressed);
+    return result;
+}
+
+/**
+ * Xors data with base in place, base is taken to be zero past its end.
+ */
+static void xor_with_base(std::vector<uint8_t>& data, const std::vector<uint8_t>& base)
+{
+    const size_t length = std::min(data.size(), base.size());
+    uint8_t* dst = data.data();
+    const uint8_t* src = base.data();
+    for (size_t i = 0; i < length; i++)
+    {
+        dst[i] ^= src[i];
+    }
+}
+
+std::shared_ptr<NetworkMap> network_map_create(
+    std::vector<uint8_t> data, const std::vector<const ObjectRepositoryItem*>& objects, int32_t level)
+{
+    auto map = std::make_shared<NetworkMap>();
+    map->Objects = objects;
+    map->Data = std::move(data);
+    map->Hash = Crypt::SHA1(map->Data.data(), map->Data.size());
+
+    append_header(map->Payload, MAP_HEADER_ZLIB);
+    if (!append_compressed(map->Payload, map->Data.data(), map->Data.size(), level))
+    {
+        log_warning("Failed to compress the data, falling back to non-compressed sv6.");
+        map->Payload = map->Data;
+    }
+    log_verbose(
+        "Sending map of size %u bytes, compressed to %u bytes", static_cast<uint32_t>(map->Data.size()),
+        static_cast<uint32_t>(map->Payload.size()));
+    return map;
+}
+
+std::vector<uint8_t> network_map_create_delta(const NetworkMap& base, const NetworkMap& map, int32_t level)
+{
+    // Maps a few ticks apart mostly have the same bytes in the same places, which xor to long runs of zeros.
+    std::vector<uint8_t> delta = map.Data;
+    xor_with_base(delta, base.Data);
+
+    std::vector<uint8_t> payload;
+    append_header(payload, MAP_HEADER_DELTA);
+    payload.insert(payload.end(), base.Hash.begin(), base.Hash.end());
+    if (!append_compressed(payload, delta.data(), delta.size(), level))
+    {
+        return {};
+    }
+    return payload;
+}
+
+std::vector<uint8_t> network_map_decode(
+    const uint8_t* payload, size_t size, const std::vector<uint8_t>& base, const NetworkMapHash& baseHash)
+{
+    if (has_header(payload, size, MAP_HEADER_ZLIB))
+    {
+        log_verbose("Received zlib-compressed sv6 map");
+        const size_t headerLength = std::strlen(MAP_HEADER_ZLIB) + 1;
+        return decompress(payload + headerLength, size - headerLength, 0);
+    }
+    if (has_header(payload, size, MAP_HEADER_DELTA))
+    {
+        log_verbose("Received difference to the last map");
+        const size_t headerLength = std::strlen(MAP_HEADER_DELTA) + 1 + baseHash.size();
+        if (size < headerLength || std::memcmp(payload + headerLength - baseHash.size(), baseHash.data(), baseHash.size()) != 0)
+        {
+            throw std::runtime_error("Received difference to a map that is not the last one.");
+        }
+        auto data = decompress(payload + headerLength, size - headerLength, base.size());
+        xor_with_base(data, base);
+        return data;
+    }
+    log_verbose("Assuming received map is in plain sv6 format");
+    return std::vector<uint8_t>(payload, payload + size);
+}
+
+std::shared_ptr<const NetworkMap> NetworkMapCache::GetCurrent(const std::vector<const ObjectRepositoryItem*>& objects) const
+{
+    if (_current != nullptr && _current->Objects == objects)
+    {
+        return _current;
+    }
+    return nullptr;
+}
+
+std::shared_ptr<const NetworkMap> NetworkMapCache::Find(const NetworkMapHash& hash) const
+{
+    auto it = std::find_if(_maps.begin(), _maps.end(), [&hash](const auto& map) { return map->Hash == hash; });
+    return it != _maps.end() ? *it : nullptr;
+}
+
+void NetworkMapCache::Add(std::shared_ptr<const NetworkMap> map)
+{
+    _current = map;
+    _maps.push_back(std::move(map));
+    if (_maps.size() > MaxMaps)
+    {
+        _maps.pop_front();
+    }
+}
+
+void NetworkMapCache::ReleaseCurrent()
+{
+    _current = nullptr;
+}
+
+void NetworkMapCache::Clear()
+{
+    _current = nullptr;
+    _maps.clear();
+}
+
+#endif // DISABLE_NETWORK
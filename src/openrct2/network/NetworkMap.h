@@ -0,0 +1,79 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#ifndef DISABLE_NETWORK
+
+#    include "../common.h"
+#    include "../core/Crypt.h"
+
+#    include <deque>
+#    include <memory>
+#    include <vector>
+
+struct ObjectRepositoryItem;
+
+using NetworkMapHash = Crypt::Sha1Algorithm::Result;
+
+/**
+ * A saved map as it is sent to clients that join.
+ */
+struct NetworkMap
+{
+    // The objects packed into the map.
+    std::vector<const ObjectRepositoryItem*> Objects;
+    std::vector<uint8_t> Data;
+    NetworkMapHash Hash{};
+    // Data compressed, with a header in front telling the client how.
+    std::vector<uint8_t> Payload;
+};
+
+/**
+ * Creates a map to send from saved map data, level is the zlib compression level.
+ */
+std::shared_ptr<NetworkMap> network_map_create(
+    std::vector<uint8_t> data, const std::vector<const ObjectRepositoryItem*>& objects, int32_t level);
+
+/**
+ * Creates a payload with the difference between base and map, for clients that still have base.
+ */
+std::vector<uint8_t> network_map_create_delta(const NetworkMap& base, const NetworkMap& map, int32_t level);
+
+/**
+ * Gets the map data from a payload, base is the last map received, which is used for payloads that are a difference to
+ * it. Throws if the payload can not be decoded.
+ */
+std::vector<uint8_t> network_map_decode(
+    const uint8_t* payload, size_t size, const std::vector<uint8_t>& base, const NetworkMapHash& baseHash);
+
+/**
+ * The maps sent most recently. The newest one is sent to every client that joins until it is released, it is released
+ * after every network update as the game state can change after that. Older ones are kept for sending differences.
+ */
+class NetworkMapCache final
+{
+private:
+    static constexpr size_t MaxMaps = 4;
+
+    std::shared_ptr<const NetworkMap> _current;
+    std::deque<std::shared_ptr<const NetworkMap>> _maps;
+
+public:
+    /**
+     * Gets the current map if it packs the given objects, nullptr otherwise.
+     */
+    std::shared_ptr<const NetworkMap> GetCurrent(const std::vector<const ObjectRepositoryItem*>& objects) const;
+    std::shared_ptr<const NetworkMap> Find(const NetworkMapHash& hash) const;
+    void Add(std::shared_ptr<const NetworkMap> map);
+    void ReleaseCurrent();
+    void Clear();
+};
+
+#endif // DISABLE_NETWORK
@@ -20,11 +20,6 @@ std::unique_ptr<NetworkPacket> NetworkPacket::Allocate()
     return std::make_unique<NetworkPacket>();
 }
 
-std::unique_ptr<NetworkPacket> NetworkPacket::Duplicate(NetworkPacket& packet)
-{
-    return std::make_unique<NetworkPacket>(packet);
-}
-
 uint8_t* NetworkPacket::GetData()
 {
     return &(*Data)[0];
@@ -49,7 +44,7 @@ void NetworkPacket::Clear()
     Data->clear();
 }
 
-bool NetworkPacket::CommandRequiresAuth()
+bool NetworkPacket::CommandRequiresAuth() const
 {
     switch (GetCommand())
     {
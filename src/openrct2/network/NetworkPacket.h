@@ -20,18 +20,18 @@ class NetworkPacket final
 {
 public:
     uint16_t Size = 0;
+    // Queued packets share their data between connections, it must not be written to after queuing.
     std::shared_ptr<std::vector<uint8_t>> Data = std::make_shared<std::vector<uint8_t>>();
     size_t BytesTransferred = 0;
     size_t BytesRead = 0;
 
     static std::unique_ptr<NetworkPacket> Allocate();
-    static std::unique_ptr<NetworkPacket> Duplicate(NetworkPacket& packet);
 
     uint8_t* GetData();
     int32_t GetCommand() const;
 
     void Clear();
-    bool CommandRequiresAuth();
+    bool CommandRequiresAuth() const;
 
     const uint8_t* Read(size_t size);
     const utf8* ReadString();
@@ -9,6 +9,7 @@
 
 #ifndef DISABLE_NETWORK
 
+#    include <algorithm>
 #    include <atomic>
 #    include <chrono>
 #    include <cmath>
@@ -16,6 +17,7 @@
 #    include <future>
 #    include <string>
 #    include <thread>
+#    include <unordered_map>
 
 // clang-format off
 // MSVC: include <math.h> here otherwise PI gets defined twice
@@ -46,7 +48,11 @@
     #include <netinet/tcp.h>
     #include <sys/ioctl.h>
     #include <sys/socket.h>
+    #include <sys/uio.h>
     #include "../common.h"
+    #if defined(__linux__)
+        #include <sys/epoll.h>
+    #endif // defined(__linux__)
     using SOCKET = int32_t;
     #define SOCKET_ERROR -1
     #define INVALID_SOCKET -1
@@ -197,6 +203,9 @@ private:
 class TcpSocket final : public ITcpSocket, protected Socket
 {
 private:
+    // Well below the limit of buffers a single send can take on every platform.
+    static constexpr size_t MAX_SEND_BUFFERS = 64;
+
     std::atomic<SOCKET_STATUS> _status = ATOMIC_VAR_INIT(SOCKET_STATUS_CLOSED);
     uint16_t _listeningPort = 0;
     SOCKET _socket = INVALID_SOCKET;
@@ -209,6 +218,11 @@ private:
 public:
     TcpSocket() = default;
 
+    SOCKET GetSocket() const
+    {
+        return _socket;
+    }
+
     ~TcpSocket() override
     {
         if (_connectFuture.valid())
@@ -492,6 +506,71 @@ public:
         return totalSent;
     }
 
+    size_t SendData(const SocketBuffer* buffers, size_t count) override
+    {
+        if (_status != SOCKET_STATUS_CONNECTED)
+        {
+            throw std::runtime_error("Socket not connected.");
+        }
+
+        // Sends as many buffers as fit in one call at a time, index and offset are where the data not yet sent starts.
+        size_t totalSent = 0;
+        size_t index = 0;
+        size_t offset = 0;
+        while (index < count)
+        {
+#    ifdef _WIN32
+            WSABUF sendBuffers[MAX_SEND_BUFFERS];
+#    else
+            iovec sendBuffers[MAX_SEND_BUFFERS];
+#    endif
+            size_t numSendBuffers = 0;
+            for (size_t i = index; i < count && numSendBuffers < MAX_SEND_BUFFERS; i++)
+            {
+                const size_t skip = i == index ? offset : 0;
+#    ifdef _WIN32
+                sendBuffers[numSendBuffers].buf = const_cast<CHAR*>(static_cast<const CHAR*>(buffers[i].Data) + skip);
+                sendBuffers[numSendBuffers].len = static_cast<ULONG>(buffers[i].Size - skip);
+#    else
+                sendBuffers[numSendBuffers].iov_base = const_cast<uint8_t*>(
+                    static_cast<const uint8_t*>(buffers[i].Data) + skip);
+                sendBuffers[numSendBuffers].iov_len = buffers[i].Size - skip;
+#    endif
+                numSendBuffers++;
+            }
+
+            size_t sentBytes;
+#    ifdef _WIN32
+            DWORD sent = 0;
+            if (WSASend(_socket, sendBuffers, static_cast<DWORD>(numSendBuffers), &sent, 0, nullptr, nullptr) == SOCKET_ERROR)
+            {
+                return totalSent;
+            }
+            sentBytes = sent;
+#    else
+            msghdr message{};
+            message.msg_iov = sendBuffers;
+            message.msg_iovlen = numSendBuffers;
+            ssize_t sent = sendmsg(_socket, &message, FLAG_NO_PIPE);
+            if (sent == SOCKET_ERROR)
+            {
+                return totalSent;
+            }
+            sentBytes = static_cast<size_t>(sent);
+#    endif
+            totalSent += sentBytes;
+
+            while (index < count && sentBytes >= buffers[index].Size - offset)
+            {
+                sentBytes -= buffers[index].Size - offset;
+                offset = 0;
+                index++;
+            }
+            offset += sentBytes;
+        }
+        return totalSent;
+    }
+
     NETWORK_READPACKET ReceiveData(void* buffer, size_t size, size_t* sizeReceived) override
     {
         if (_status != SOCKET_STATUS_CONNECTED)
@@ -809,6 +888,158 @@ private:
     }
 };
 
+#    if defined(__linux__)
+
+class EpollSocketPoller final : public ISocketPoller
+{
+private:
+    int _epoll = -1;
+    std::unordered_map<SOCKET, uint32_t> _socketEvents;
+    std::vector<epoll_event> _readyEvents;
+
+public:
+    EpollSocketPoller()
+    {
+        _epoll = epoll_create1(EPOLL_CLOEXEC);
+        if (_epoll == -1)
+        {
+            throw SocketException("Unable to create epoll instance.");
+        }
+    }
+
+    ~EpollSocketPoller() override
+    {
+        close(_epoll);
+    }
+
+    void Add(const ITcpSocket& socket, void* tag, uint32_t events) override
+    {
+        SOCKET fd = GetSocket(socket);
+        epoll_event event = CreateEvent(tag, events);
+        if (epoll_ctl(_epoll, EPOLL_CTL_ADD, fd, &event) == -1)
+        {
+            throw SocketException("Unable to add socket to epoll instance.");
+        }
+        _socketEvents[fd] = events;
+    }
+
+    void Modify(const ITcpSocket& socket, void* tag, uint32_t events) override
+    {
+        SOCKET fd = GetSocket(socket);
+        auto it = _socketEvents.find(fd);
+        if (it == _socketEvents.end() || it->second == events)
+        {
+            return;
+        }
+        epoll_event event = CreateEvent(tag, events);
+        if (epoll_ctl(_epoll, EPOLL_CTL_MOD, fd, &event) == -1)
+        {
+            throw SocketException("Unable to modify socket in epoll instance.");
+        }
+        it->second = events;
+    }
+
+    void Remove(const ITcpSocket& socket) override
+    {
+        SOCKET fd = GetSocket(socket);
+        if (_socketEvents.erase(fd) > 0)
+        {
+            epoll_ctl(_epoll, EPOLL_CTL_DEL, fd, nullptr);
+        }
+    }
+
+    void Wait(std::vector<SocketPollEvent>& events, int32_t timeout) override
+    {
+        events.clear();
+        _readyEvents.resize(std::max<size_t>(_socketEvents.size(), 1));
+        int32_t numReady = epoll_wait(_epoll, _readyEvents.data(), static_cast<int>(_readyEvents.size()), timeout);
+        for (int32_t i = 0; i < numReady; i++)
+        {
+            const auto& readyEvent = _readyEvents[i];
+            uint32_t ready = 0;
+            // Errors and hang ups are found out about by reading.
+            if (readyEvent.events & (EPOLLIN | EPOLLERR | EPOLLHUP | EPOLLRDHUP))
+            {
+                ready |= SOCKET_EVENT_READ;
+            }
+            if (readyEvent.events & EPOLLOUT)
+            {
+                ready |= SOCKET_EVENT_WRITE;
+            }
+            events.push_back({ readyEvent.data.ptr, ready });
+        }
+    }
+
+private:
+    static SOCKET GetSocket(const ITcpSocket& socket)
+    {
+        return static_cast<const TcpSocket&>(socket).GetSocket();
+    }
+
+    static epoll_event CreateEvent(void* tag, uint32_t events)
+    {
+        epoll_event event{};
+        event.data.ptr = tag;
+        event.events = EPOLLRDHUP;
+        if (events & SOCKET_EVENT_READ)
+        {
+            event.events |= EPOLLIN;
+        }
+        if (events & SOCKET_EVENT_WRITE)
+        {
+            event.events |= EPOLLOUT;
+        }
+        return event;
+    }
+};
+
+#    else
+
+/**
+ * Reports every socket as ready, for systems without epoll.
+ */
+class AlwaysReadySocketPoller final : public ISocketPoller
+{
+private:
+    std::vector<std::pair<const ITcpSocket*, void*>> _sockets;
+
+public:
+    void Add(const ITcpSocket& socket, void* tag, [[maybe_unused]] uint32_t events) override
+    {
+        _sockets.emplace_back(&socket, tag);
+    }
+
+    void Modify(const ITcpSocket& socket, void* tag, [[maybe_unused]] uint32_t events) override
+    {
+        for (auto& entry : _sockets)
+        {
+            if (entry.first == &socket)
+            {
+                entry.second = tag;
+            }
+        }
+    }
+
+    void Remove(const ITcpSocket& socket) override
+    {
+        _sockets.erase(
+            std::remove_if(
+                _sockets.begin(), _sockets.end(), [&socket](const auto& entry) { return entry.first == &socket; }),
+            _sockets.end());
+    }
+
+    void Wait(std::vector<SocketPollEvent>& events, [[maybe_unused]] int32_t timeout) override
+    {
+        events.clear();
+        for (const auto& entry : _sockets)
+        {
+            events.push_back({ entry.second, SOCKET_EVENT_READ | SOCKET_EVENT_WRITE });
+        }
+    }
+};
+
+#    endif // defined(__linux__)
+
 bool InitialiseWSA()
 {
 #    ifdef _WIN32
@@ -850,6 +1081,15 @@ std::unique_ptr<IUdpSocket> CreateUdpSocket()
     return std::make_unique<UdpSocket>();
 }
 
+std::unique_ptr<ISocketPoller> CreateSocketPoller()
+{
+#    if defined(__linux__)
+    return std::make_unique<EpollSocketPoller>();
+#    else
+    return std::make_unique<AlwaysReadySocketPoller>();
+#    endif
+}
+
 #    ifdef _WIN32
 static std::vector<INTERFACE_INFO> GetNetworkInterfaces()
 {
@@ -32,6 +32,21 @@ enum NETWORK_READPACKET
     NETWORK_READPACKET_DISCONNECTED
 };
 
+enum SOCKET_EVENT
+{
+    SOCKET_EVENT_READ = 1 << 0,
+    SOCKET_EVENT_WRITE = 1 << 1,
+};
+
+/**
+ * A buffer of data to send, part of a list that is sent in one go.
+ */
+struct SocketBuffer
+{
+    const void* Data;
+    size_t Size;
+};
+
 /**
  * Represents an address and port.
  */
@@ -65,6 +80,7 @@ public:
     virtual void ConnectAsync(const std::string& address, uint16_t port) abstract;
 
     virtual size_t SendData(const void* buffer, size_t size) abstract;
+    virtual size_t SendData(const SocketBuffer* buffers, size_t count) abstract;
     virtual NETWORK_READPACKET ReceiveData(void* buffer, size_t size, size_t* sizeReceived) abstract;
 
     virtual void Disconnect() abstract;
@@ -94,10 +110,36 @@ public:
     virtual void Close() abstract;
 };
 
+/**
+ * A socket that is ready to read from or write to, tag is what the socket was added with.
+ */
+struct SocketPollEvent
+{
+    void* Tag;
+    uint32_t Events;
+};
+
+/**
+ * Tells which of a set of TCP sockets are ready, so only those need to be read from or written to. Where the system has
+ * no way to do that every socket is reported as ready for everything.
+ */
+interface ISocketPoller
+{
+public:
+    virtual ~ISocketPoller() = default;
+
+    virtual void Add(const ITcpSocket& socket, void* tag, uint32_t events) abstract;
+    virtual void Modify(const ITcpSocket& socket, void* tag, uint32_t events) abstract;
+    virtual void Remove(const ITcpSocket& socket) abstract;
+    // Fills events with the sockets that are ready, waiting up to timeout milliseconds for one.
+    virtual void Wait(std::vector<SocketPollEvent>& events, int32_t timeout) abstract;
+};
+
 bool InitialiseWSA();
 void DisposeWSA();
 std::unique_ptr<ITcpSocket> CreateTcpSocket();
 std::unique_ptr<IUdpSocket> CreateUdpSocket();
+std::unique_ptr<ISocketPoller> CreateSocketPoller();
 std::vector<std::unique_ptr<INetworkEndpoint>> GetBroadcastAddresses();
 
 namespace Convert
@@ -22,6 +22,8 @@
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <functional>
+#include <vector>
 
 using namespace OpenRCT2;
 
@@ -50,12 +52,99 @@ bool gShowDirtyVisuals;
 bool gPaintBoundingBoxes;
 bool gPaintBlockedTiles;
 
-static void paint_attached_ps(rct_drawpixelinfo* dpi, paint_struct* ps, uint32_t viewFlags);
 static void paint_ps_image_with_bounding_boxes(
-    rct_drawpixelinfo* dpi, paint_struct* ps, uint32_t imageId, int16_t x, int16_t y);
-static void paint_ps_image(rct_drawpixelinfo* dpi, paint_struct* ps, uint32_t imageId, int16_t x, int16_t y);
+    rct_drawpixelinfo* dpi, const paint_struct* ps, uint32_t imageId, int16_t x, int16_t y);
+static void paint_ps_image(rct_drawpixelinfo* dpi, const paint_struct* ps, uint32_t imageId, int16_t x, int16_t y);
 static uint32_t paint_ps_colourify_image(uint32_t imageId, uint8_t spriteType, uint32_t viewFlags);
 
+void PaintEntryArena::Reset(paint_session& session)
+{
+    _currentChunk = 0;
+    if (_chunks.empty())
+    {
+        session.NextFreePaintStruct = nullptr;
+        session.EndOfPaintStructArray = nullptr;
+    }
+    else
+    {
+        session.NextFreePaintStruct = _chunks[0].get();
+        session.EndOfPaintStructArray = _chunks[0].get() + ChunkSize;
+    }
+}
+
+/**
+ * Moves the session on to the next chunk, called once the current one is full.
+ */
+void PaintEntryArena::Grow(paint_session& session)
+{
+    if (session.NextFreePaintStruct != nullptr)
+    {
+        _currentChunk++;
+    }
+    if (_currentChunk == _chunks.size())
+    {
+        _chunks.push_back(std::make_unique<paint_entry[]>(ChunkSize));
+    }
+    session.NextFreePaintStruct = _chunks[_currentChunk].get();
+    session.EndOfPaintStructArray = _chunks[_currentChunk].get() + ChunkSize;
+}
+
+size_t PaintEntryArena::GetUsedCount(const paint_session& session) const
+{
+    if (session.NextFreePaintStruct == nullptr)
+        return 0;
+    return _currentChunk * ChunkSize + (session.NextFreePaintStruct - _chunks[_currentChunk].get());
+}
+
+size_t PaintEntryArena::GetReservedCount() const
+{
+    return _chunks.size() * ChunkSize;
+}
+
+const paint_entry& PaintEntryArena::GetEntry(size_t index) const
+{
+    return _chunks[index / ChunkSize][index % ChunkSize];
+}
+
+size_t PaintEntryArena::IndexOf(const paint_session& session, const void* entry) const
+{
+    const size_t usedCount = GetUsedCount(session);
+    const std::less<const void*> less;
+    for (size_t i = 0; i * ChunkSize < usedCount; i++)
+    {
+        const paint_entry* chunk = _chunks[i].get();
+        if (!less(entry, chunk) && less(entry, chunk + ChunkSize))
+        {
+            const size_t index = i * ChunkSize + (static_cast<const paint_entry*>(entry) - chunk);
+            return std::min(index, usedCount);
+        }
+    }
+    return usedCount;
+}
+
+// Sessions that are not from the painter's pool, such as the global one testpaint uses, take their entries from here.
+// They are used one at a time and start over from the first entry when PaintStructArena is cleared.
+static PaintEntryArena _defaultPaintEntryArena;
+
+/**
+ * Makes sure NextFreePaintStruct points at an entry that can be used.
+ */
+static bool paint_session_reserve_entry(paint_session* session)
+{
+    if (session->NextFreePaintStruct < session->EndOfPaintStructArray)
+        return true;
+    if (session->PaintStructArena == nullptr)
+    {
+        session->PaintStructArena = &_defaultPaintEntryArena;
+        _defaultPaintEntryArena.Reset(*session);
+        if (session->NextFreePaintStruct != nullptr)
+            return true;
+    }
+
+    session->PaintStructArena->Grow(*session);
+    return true;
+}
+
 static void paint_session_add_ps_to_quadrant(paint_session* session, paint_struct* ps, int32_t positionHash)
 {
     uint32_t paintQuadrantIndex = std::clamp(positionHash / 32, 0, MAX_PAINT_QUADRANTS - 1);
@@ -73,7 +162,7 @@ static void paint_session_add_ps_to_quadrant(paint_session* session, paint_struc
 static paint_struct* sub_9819_c(
     paint_session* session, uint32_t image_id, const CoordsXYZ& offset, CoordsXYZ boundBoxSize, CoordsXYZ boundBoxOffset)
 {
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray)
+    if (!paint_session_reserve_entry(session))
         return nullptr;
     auto g1 = gfx_get_g1_element(image_id & 0x7FFFF);
     if (g1 == nullptr)
@@ -416,10 +505,12 @@ static paint_struct* paint_arrange_structs_helper(paint_struct* ps_next, uint16_
 }
 
 /**
+ * Arranges the paint structs by walking their linked list, this is how it was done originally. Kept as a reference
+ * for paint_session_arrange which has to produce the same order.
  *
  *  rct2: 0x00688217
  */
-void paint_session_arrange(paint_session* session)
+void paint_session_arrange_reference(paint_session* session)
 {
     paint_struct* psHead = &session->PaintHead;
 
@@ -455,9 +546,222 @@ void paint_session_arrange(paint_session* session)
     }
 }
 
-static void paint_draw_struct(paint_session* session, paint_struct* ps)
+/**
+ * The paint structs of a session copied into arrays while they are arranged, indexed by their position in the list at
+ * the start. Index 0 is the paint head, as nothing links back to it a next index of 0 ends the list. Bounding boxes
+ * are split up by coordinate so comparing them only touches the coordinates that are needed.
+ */
+struct PaintArrangeBuffer
+{
+    std::vector<paint_struct*> Structs;
+    std::vector<uint32_t> Next;
+    std::vector<uint16_t> QuadrantIndex;
+    std::vector<uint8_t> QuadrantFlags;
+    std::vector<uint16_t> X;
+    std::vector<uint16_t> Y;
+    std::vector<uint16_t> Z;
+    std::vector<uint16_t> XEnd;
+    std::vector<uint16_t> YEnd;
+    std::vector<uint16_t> ZEnd;
+
+    void Clear()
+    {
+        Structs.clear();
+        Next.clear();
+        QuadrantIndex.clear();
+        QuadrantFlags.clear();
+        X.clear();
+        Y.clear();
+        Z.clear();
+        XEnd.clear();
+        YEnd.clear();
+        ZEnd.clear();
+    }
+
+    void Add(paint_struct* ps)
+    {
+        const auto index = static_cast<uint32_t>(Structs.size());
+        if (index != 0)
+        {
+            Next.back() = index;
+        }
+        Structs.push_back(ps);
+        Next.push_back(0);
+        QuadrantIndex.push_back(ps->quadrant_index);
+        QuadrantFlags.push_back(0);
+        X.push_back(ps->bounds.x);
+        Y.push_back(ps->bounds.y);
+        Z.push_back(ps->bounds.z);
+        XEnd.push_back(ps->bounds.x_end);
+        YEnd.push_back(ps->bounds.y_end);
+        ZEnd.push_back(ps->bounds.z_end);
+    }
+
+    paint_struct_bound_box GetBounds(uint32_t index) const
+    {
+        return { X[index], Y[index], Z[index], XEnd[index], YEnd[index], ZEnd[index] };
+    }
+};
+
+// Sessions are arranged on the thread that generated them, every thread keeps its buffer to avoid allocating.
+static thread_local PaintArrangeBuffer _arrangeBuffer;
+
+/**
+ * Same as paint_arrange_structs_helper_rotation, working on indices into the arrange buffer.
+ */
+template<uint8_t _TRotation>
+static uint32_t paint_arrange_indices_helper_rotation(
+    PaintArrangeBuffer& buffer, uint32_t psNext, uint16_t quadrantIndex, uint8_t flag)
 {
-    rct_drawpixelinfo* dpi = &session->DPI;
+    uint32_t* next = buffer.Next.data();
+    const uint16_t* quadrants = buffer.QuadrantIndex.data();
+    uint8_t* flags = buffer.QuadrantFlags.data();
+
+    uint32_t ps;
+    do
+    {
+        ps = psNext;
+        psNext = next[psNext];
+        if (psNext == 0)
+            return ps;
+    } while (quadrantIndex > quadrants[psNext]);
+
+    // Cache the last visited node so we don't have to walk the whole list again
+    const uint32_t psCache = ps;
+
+    uint32_t psTemp = ps;
+    do
+    {
+        ps = next[ps];
+        if (ps == 0)
+            break;
+
+        if (quadrants[ps] > quadrantIndex + 1)
+        {
+            flags[ps] = PAINT_QUADRANT_FLAG_BIGGER;
+        }
+        else if (quadrants[ps] == quadrantIndex + 1)
+        {
+            flags[ps] = PAINT_QUADRANT_FLAG_NEXT | PAINT_QUADRANT_FLAG_IDENTICAL;
+        }
+        else if (quadrants[ps] == quadrantIndex)
+        {
+            flags[ps] = flag | PAINT_QUADRANT_FLAG_IDENTICAL;
+        }
+    } while (quadrants[ps] <= quadrantIndex + 1);
+    ps = psTemp;
+
+    while (true)
+    {
+        while (true)
+        {
+            psNext = next[ps];
+            if (psNext == 0)
+                return psCache;
+            if (flags[psNext] & PAINT_QUADRANT_FLAG_BIGGER)
+                return psCache;
+            if (flags[psNext] & PAINT_QUADRANT_FLAG_IDENTICAL)
+                break;
+            ps = psNext;
+        }
+
+        flags[psNext] &= ~PAINT_QUADRANT_FLAG_IDENTICAL;
+        psTemp = ps;
+
+        const paint_struct_bound_box initialBBox = buffer.GetBounds(psNext);
+
+        while (true)
+        {
+            ps = psNext;
+            psNext = next[psNext];
+            if (psNext == 0)
+                break;
+            if (flags[psNext] & PAINT_QUADRANT_FLAG_BIGGER)
+                break;
+            if (!(flags[psNext] & PAINT_QUADRANT_FLAG_NEXT))
+                continue;
+
+            if (check_bounding_box<_TRotation>(initialBBox, buffer.GetBounds(psNext)))
+            {
+                next[ps] = next[psNext];
+                next[psNext] = next[psTemp];
+                next[psTemp] = psNext;
+                psNext = ps;
+            }
+        }
+
+        ps = psTemp;
+    }
+}
+
+template<uint8_t _TRotation>
+static void paint_arrange_indices(PaintArrangeBuffer& buffer, uint32_t backIndex, uint32_t frontIndex)
+{
+    uint32_t psCache = paint_arrange_indices_helper_rotation<_TRotation>(
+        buffer, 0, backIndex & 0xFFFF, PAINT_QUADRANT_FLAG_NEXT);
+    for (uint32_t quadrantIndex = backIndex + 1; quadrantIndex < frontIndex; quadrantIndex++)
+    {
+        psCache = paint_arrange_indices_helper_rotation<_TRotation>(buffer, psCache, quadrantIndex & 0xFFFF, 0);
+    }
+}
+
+/**
+ * Sorts the paint structs into the order they are drawn in, the resulting list starts at PaintHead. Produces the same
+ * order as paint_session_arrange_reference.
+ *
+ *  rct2: 0x00688217
+ */
+void paint_session_arrange(paint_session* session)
+{
+    session->PaintHead.next_quadrant_ps = nullptr;
+    if (session->QuadrantBackIndex == UINT32_MAX)
+        return;
+
+    auto& buffer = _arrangeBuffer;
+    buffer.Clear();
+    buffer.Add(&session->PaintHead);
+    for (uint32_t quadrantIndex = session->QuadrantBackIndex; quadrantIndex <= session->QuadrantFrontIndex; quadrantIndex++)
+    {
+        for (paint_struct* ps = session->Quadrants[quadrantIndex]; ps != nullptr; ps = ps->next_quadrant_ps)
+        {
+            buffer.Add(ps);
+        }
+    }
+
+    switch (session->CurrentRotation)
+    {
+        case 0:
+            paint_arrange_indices<0>(buffer, session->QuadrantBackIndex, session->QuadrantFrontIndex);
+            break;
+        case 1:
+            paint_arrange_indices<1>(buffer, session->QuadrantBackIndex, session->QuadrantFrontIndex);
+            break;
+        case 2:
+            paint_arrange_indices<2>(buffer, session->QuadrantBackIndex, session->QuadrantFrontIndex);
+            break;
+        case 3:
+            paint_arrange_indices<3>(buffer, session->QuadrantBackIndex, session->QuadrantFrontIndex);
+            break;
+    }
+
+    // Link up the paint structs in their new order.
+    uint32_t index = 0;
+    do
+    {
+        const uint32_t next = buffer.Next[index];
+        buffer.Structs[index]->next_quadrant_ps = next == 0 ? nullptr : buffer.Structs[next];
+        index = next;
+    } while (index != 0);
+}
+
+/**
+ * Works out the images to draw for a paint struct, its children and attached paint structs. drawImage is called with
+ * the paint struct for its own image and with nullptr for attached images.
+ */
+template<typename TDrawImage>
+static void paint_visit_struct(const paint_session* session, const paint_struct* ps, const TDrawImage& drawImage)
+{
+    const rct_drawpixelinfo* dpi = &session->DPI;
 
     int16_t x = ps->x;
     int16_t y = ps->y;
@@ -477,22 +781,42 @@ static void paint_draw_struct(paint_session* session, paint_struct* ps)
     }
 
     uint32_t imageId = paint_ps_colourify_image(ps->image_id, ps->sprite_type, session->ViewFlags);
-    if (gPaintBoundingBoxes && dpi->zoom_level == 0)
+    drawImage(ps, imageId, x, y, (ps->flags & PAINT_STRUCT_FLAG_IS_MASKED) != 0, ps->tertiary_colour);
+
+    if (ps->children != nullptr)
     {
-        paint_ps_image_with_bounding_boxes(dpi, ps, imageId, x, y);
+        paint_visit_struct(session, ps->children, drawImage);
     }
     else
     {
-        paint_ps_image(dpi, ps, imageId, x, y);
+        for (const attached_paint_struct* attached_ps = ps->attached_ps; attached_ps; attached_ps = attached_ps->next)
+        {
+            int16_t attachedX = attached_ps->x + ps->x;
+            int16_t attachedY = attached_ps->y + ps->y;
+
+            uint32_t attachedImageId = paint_ps_colourify_image(attached_ps->image_id, ps->sprite_type, session->ViewFlags);
+            if (attached_ps->flags & PAINT_STRUCT_FLAG_IS_MASKED)
+            {
+                drawImage(nullptr, attachedImageId, attachedX, attachedY, true, attached_ps->colour_image_id);
+            }
+            else
+            {
+                drawImage(nullptr, attachedImageId, attachedX, attachedY, false, ps->tertiary_colour);
+            }
+        }
     }
+}
 
-    if (ps->children != nullptr)
+static void paint_draw_image(
+    rct_drawpixelinfo* dpi, uint32_t imageId, int16_t x, int16_t y, bool isMasked, uint32_t colourImageIdOrTertiaryColour)
+{
+    if (isMasked)
     {
-        paint_draw_struct(session, ps->children);
+        gfx_draw_sprite_raw_masked(dpi, x, y, imageId, colourImageIdOrTertiaryColour);
     }
     else
     {
-        paint_attached_ps(dpi, ps, session->ViewFlags);
+        gfx_draw_sprite(dpi, imageId, x, y, colourImageIdOrTertiaryColour);
     }
 }
 
@@ -502,42 +826,62 @@ static void paint_draw_struct(paint_session* session, paint_struct* ps)
  */
 void paint_draw_structs(paint_session* session)
 {
-    paint_struct* ps = &session->PaintHead;
+    rct_drawpixelinfo* dpi = &session->DPI;
+    const bool drawBoundingBoxes = gPaintBoundingBoxes && dpi->zoom_level == 0;
+    auto drawImage = [dpi, drawBoundingBoxes](
+                         const paint_struct* ps, uint32_t imageId, int16_t x, int16_t y, bool isMasked, uint32_t colour) {
+        if (ps != nullptr && drawBoundingBoxes)
+        {
+            paint_ps_image_with_bounding_boxes(dpi, ps, imageId, x, y);
+        }
+        else
+        {
+            paint_draw_image(dpi, imageId, x, y, isMasked, colour);
+        }
+    };
 
-    for (ps = ps->next_quadrant_ps; ps;)
+    for (const paint_struct* ps = session->PaintHead.next_quadrant_ps; ps != nullptr; ps = ps->next_quadrant_ps)
     {
-        paint_draw_struct(session, ps);
-
-        ps = ps->next_quadrant_ps;
+        paint_visit_struct(session, ps, drawImage);
     }
 }
 
 /**
- *
- *  rct2: 0x00688596
- *  Part of 0x688485
+ * Stores the images an arranged paint session draws so they can be drawn again without painting the session again.
  */
-static void paint_attached_ps(rct_drawpixelinfo* dpi, paint_struct* ps, uint32_t viewFlags)
+void paint_session_record(const paint_session* session, PaintDrawList& drawList)
 {
-    attached_paint_struct* attached_ps = ps->attached_ps;
-    for (; attached_ps; attached_ps = attached_ps->next)
+    drawList.Commands.clear();
+    auto recordImage = [&drawList](
+                           const paint_struct*, uint32_t imageId, int16_t x, int16_t y, bool isMasked, uint32_t colour) {
+        drawList.Commands.push_back({ imageId, colour, x, y, isMasked });
+    };
+    for (const paint_struct* ps = session->PaintHead.next_quadrant_ps; ps != nullptr; ps = ps->next_quadrant_ps)
     {
-        int16_t x = attached_ps->x + ps->x;
-        int16_t y = attached_ps->y + ps->y;
+        paint_visit_struct(session, ps, recordImage);
+    }
 
-        uint32_t imageId = paint_ps_colourify_image(attached_ps->image_id, ps->sprite_type, viewFlags);
-        if (attached_ps->flags & PAINT_STRUCT_FLAG_IS_MASKED)
-        {
-            gfx_draw_sprite_raw_masked(dpi, x, y, imageId, attached_ps->colour_image_id);
-        }
-        else
-        {
-            gfx_draw_sprite(dpi, imageId, x, y, ps->tertiary_colour);
-        }
+    drawList.Strings.clear();
+    for (const paint_string_struct* ps = session->PSStringHead; ps != nullptr; ps = ps->next)
+    {
+        drawList.Strings.push_back(*ps);
+    }
+    for (size_t i = 0; i < drawList.Strings.size(); i++)
+    {
+        drawList.Strings[i].next = i + 1 < drawList.Strings.size() ? &drawList.Strings[i + 1] : nullptr;
     }
 }
 
-static void paint_ps_image_with_bounding_boxes(rct_drawpixelinfo* dpi, paint_struct* ps, uint32_t imageId, int16_t x, int16_t y)
+void paint_draw_list(rct_drawpixelinfo* dpi, const PaintDrawList& drawList)
+{
+    for (const auto& command : drawList.Commands)
+    {
+        paint_draw_image(dpi, command.ImageId, command.X, command.Y, command.IsMasked, command.Colour);
+    }
+}
+
+static void paint_ps_image_with_bounding_boxes(
+    rct_drawpixelinfo* dpi, const paint_struct* ps, uint32_t imageId, int16_t x, int16_t y)
 {
     const uint8_t colour = BoundBoxDebugColours[ps->sprite_type];
     const uint8_t rotation = get_current_rotation();
@@ -629,7 +973,7 @@ static void paint_ps_image_with_bounding_boxes(rct_drawpixelinfo* dpi, paint_str
     gfx_draw_line(dpi, screenCoordFrontTop.x, screenCoordFrontTop.y, screenCoordRightTop.x, screenCoordRightTop.y, colour);
 }
 
-static void paint_ps_image(rct_drawpixelinfo* dpi, paint_struct* ps, uint32_t imageId, int16_t x, int16_t y)
+static void paint_ps_image(rct_drawpixelinfo* dpi, const paint_struct* ps, uint32_t imageId, int16_t x, int16_t y)
 {
     if (ps->flags & PAINT_STRUCT_FLAG_IS_MASKED)
     {
@@ -698,6 +1042,16 @@ void paint_session_free([[maybe_unused]] paint_session* session)
     GetContext()->GetPainter()->ReleaseSession(session);
 }
 
+PaintSessionStats paint_session_get_stats()
+{
+    return GetContext()->GetPainter()->GetSessionStats();
+}
+
+void paint_session_reset_stats()
+{
+    GetContext()->GetPainter()->ResetSessionStats();
+}
+
 /**
  *  rct2: 0x006861AC, 0x00686337, 0x006864D0, 0x0068666B, 0x0098196C
  *
@@ -720,7 +1074,7 @@ paint_struct* sub_98196C(
     session->LastRootPS = nullptr;
     session->UnkF1AD2C = nullptr;
 
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray)
+    if (!paint_session_reserve_entry(session))
     {
         return nullptr;
     }
@@ -1008,7 +1362,7 @@ bool paint_attach_to_previous_attach(paint_session* session, uint32_t image_id,
         return paint_attach_to_previous_ps(session, image_id, x, y);
     }
 
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray)
+    if (!paint_session_reserve_entry(session))
     {
         return false;
     }
@@ -1040,7 +1394,7 @@ bool paint_attach_to_previous_attach(paint_session* session, uint32_t image_id,
  */
 bool paint_attach_to_previous_ps(paint_session* session, uint32_t image_id, uint16_t x, uint16_t y)
 {
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray)
+    if (!paint_session_reserve_entry(session))
     {
         return false;
     }
@@ -1083,7 +1437,7 @@ void paint_floating_money_effect(
     paint_session* session, money32 amount, rct_string_id string_id, int16_t y, int16_t z, int8_t y_offsets[], int16_t offset_x,
     uint32_t rotation)
 {
-    if (session->NextFreePaintStruct >= session->EndOfPaintStructArray)
+    if (!paint_session_reserve_entry(session))
     {
         return;
     }
@@ -1135,7 +1489,7 @@ static rct_drawpixelinfo draw_pixel_info_crop_by_zoom(const rct_drawpixelinfo& d
  *
  *  rct2: 0x006860C3
  */
-void paint_draw_money_structs(rct_drawpixelinfo* dpi, paint_string_struct* ps)
+void paint_draw_money_structs(rct_drawpixelinfo* dpi, const paint_string_struct* ps)
 {
     auto dpi2 = draw_pixel_info_crop_by_zoom(*dpi);
     do
@@ -14,6 +14,9 @@
 #include "../interface/Colour.h"
 #include "../world/Location.hpp"
 
+#include <memory>
+#include <vector>
+
 struct TileElement;
 
 #pragma pack(push, 1)
@@ -133,10 +136,36 @@ struct tunnel_entry
 #define MAX_PAINT_QUADRANTS 512
 #define TUNNEL_MAX_COUNT 65
 
+struct paint_session;
+
+/**
+ * Holds the paint structs of a paint session. Entries are handed out from fixed size chunks so they never move, when
+ * a chunk is used up the next one is taken, allocating it if there is none yet. Resetting keeps all chunks, so a
+ * session that is reused every frame stops allocating once it has grown to fit its column.
+ */
+class PaintEntryArena
+{
+public:
+    static constexpr size_t ChunkSize = 1024;
+
+private:
+    std::vector<std::unique_ptr<paint_entry[]>> _chunks;
+    size_t _currentChunk = 0;
+
+public:
+    void Reset(paint_session& session);
+    void Grow(paint_session& session);
+    size_t GetUsedCount(const paint_session& session) const;
+    size_t GetReservedCount() const;
+    const paint_entry& GetEntry(size_t index) const;
+    // Gets the index of a used entry, or the used count if it does not belong to the session.
+    size_t IndexOf(const paint_session& session, const void* entry) const;
+};
+
 struct paint_session
 {
     rct_drawpixelinfo DPI;
-    paint_entry PaintStructs[4000];
+    PaintEntryArena* PaintStructArena;
     paint_struct* Quadrants[MAX_PAINT_QUADRANTS];
     paint_struct PaintHead;
     uint32_t ViewFlags;
@@ -170,6 +199,45 @@ struct paint_session
     uint32_t TrackColours[4];
 };
 
+/**
+ * A copy of a paint session for benchmarking, its paint structs are stored in order and pointers to them are replaced
+ * by their index. Entries.size() stands for nullptr.
+ */
+struct RecordedPaintSession
+{
+    paint_session Session;
+    std::vector<paint_entry> Entries;
+};
+
+struct PaintDrawCommand
+{
+    uint32_t ImageId;
+    // The colour image for masked images, the tertiary colour otherwise.
+    uint32_t Colour;
+    int16_t X;
+    int16_t Y;
+    bool IsMasked;
+};
+
+/**
+ * The images an arranged paint session draws, in order, and its money strings.
+ */
+struct PaintDrawList
+{
+    std::vector<PaintDrawCommand> Commands;
+    std::vector<paint_string_struct> Strings;
+};
+
+struct PaintSessionStats
+{
+    // Paint sessions released since the stats were reset, one for each column painted.
+    uint32_t Sessions;
+    uint32_t PeakPaintStructs;
+    uint64_t TotalPaintStructs;
+    // Paint structs currently allocated by all pooled sessions.
+    size_t ReservedPaintStructs;
+};
+
 extern paint_session gPaintSession;
 
 // Globals for paint clipping
@@ -222,10 +290,15 @@ void paint_floating_money_effect(
 
 paint_session* paint_session_alloc(rct_drawpixelinfo* dpi, uint32_t viewFlags);
 void paint_session_free(paint_session* session);
+PaintSessionStats paint_session_get_stats();
+void paint_session_reset_stats();
 void paint_session_generate(paint_session* session);
 void paint_session_arrange(paint_session* session);
+void paint_session_arrange_reference(paint_session* session);
 void paint_draw_structs(paint_session* session);
-void paint_draw_money_structs(rct_drawpixelinfo* dpi, paint_string_struct* ps);
+void paint_session_record(const paint_session* session, PaintDrawList& drawList);
+void paint_draw_list(rct_drawpixelinfo* dpi, const PaintDrawList& drawList);
+void paint_draw_money_structs(rct_drawpixelinfo* dpi, const paint_string_struct* ps);
 
 // TESTING
 #ifdef __TESTPAINT__
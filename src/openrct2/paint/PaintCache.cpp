@@ -0,0 +1,194 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "PaintCache.h"
+
+#include <array>
+#include <cassert>
+#include <unordered_map>
+
+// The draw lists of every cell that has been painted since it was last invalidated. A cell is identified by its top
+// left corner in view coordinates and the zoom level, the view flags and rotation it was painted with are checked on
+// lookup so a cell painted differently is painted again.
+struct PaintCacheCell
+{
+    CoordsXY Position;
+    ZoomLevel Zoom;
+    uint32_t ViewFlags;
+    uint8_t Rotation;
+    PaintDrawList DrawList;
+};
+
+// Enough for all zoom levels from ZoomLevel::min() up to ZoomLevel::max().
+constexpr size_t NUM_ZOOM_LEVELS = 8;
+
+// Painting more cells than this clears the cache before the next viewport is painted.
+constexpr size_t MAX_CELLS = 16384;
+
+static std::unordered_map<uint64_t, PaintCacheCell> _cells;
+static std::array<size_t, NUM_ZOOM_LEVELS> _cellsPerZoom;
+static PaintCacheStats _stats;
+
+static size_t GetZoomIndex(ZoomLevel zoom)
+{
+    const size_t index = static_cast<int8_t>(zoom) - static_cast<int8_t>(ZoomLevel::min());
+    assert(index < NUM_ZOOM_LEVELS);
+    return index;
+}
+
+static int32_t FloorDiv(int32_t value, int32_t divisor)
+{
+    return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+}
+
+static uint64_t GetCellKey(int32_t cellX, int32_t cellY, ZoomLevel zoom)
+{
+    return (static_cast<uint64_t>(GetZoomIndex(zoom)) << 56) | ((static_cast<uint64_t>(cellX) & 0xFFFFFFF) << 28)
+        | (static_cast<uint64_t>(cellY) & 0xFFFFFFF);
+}
+
+static uint64_t GetCellKey(const CoordsXY& cell, ZoomLevel zoom)
+{
+    return GetCellKey(
+        FloorDiv(cell.x, PAINT_CACHE_CELL_WIDTH), FloorDiv(cell.y, paint_cache_get_cell_height(zoom)), zoom);
+}
+
+static void RemoveCell(std::unordered_map<uint64_t, PaintCacheCell>::iterator it)
+{
+    _cellsPerZoom[GetZoomIndex(it->second.Zoom)]--;
+    _cells.erase(it);
+}
+
+/**
+ * Gets the height of a cell in view coordinates.
+ */
+int32_t paint_cache_get_cell_height(ZoomLevel zoom)
+{
+    return PAINT_CACHE_CELL_HEIGHT * zoom;
+}
+
+/**
+ * Drops all cells once there are too many. Draw lists returned by the cache stay valid until this is called or the
+ * cache is invalidated, so it is only called before painting a viewport.
+ */
+void paint_cache_trim()
+{
+    if (_cells.size() > MAX_CELLS)
+    {
+        paint_cache_invalidate_all();
+    }
+}
+
+const PaintDrawList* paint_cache_get(const CoordsXY& cell, ZoomLevel zoom, uint32_t viewFlags, uint8_t rotation)
+{
+    auto it = _cells.find(GetCellKey(cell, zoom));
+    if (it == _cells.end() || it->second.ViewFlags != viewFlags || it->second.Rotation != rotation)
+    {
+        _stats.Misses++;
+        return nullptr;
+    }
+    _stats.Hits++;
+    return &it->second.DrawList;
+}
+
+PaintDrawList& paint_cache_insert(const CoordsXY& cell, ZoomLevel zoom, uint32_t viewFlags, uint8_t rotation)
+{
+    auto result = _cells.try_emplace(GetCellKey(cell, zoom));
+    auto& cacheCell = result.first->second;
+    if (result.second)
+    {
+        _cellsPerZoom[GetZoomIndex(zoom)]++;
+    }
+    cacheCell.Position = cell;
+    cacheCell.Zoom = zoom;
+    cacheCell.ViewFlags = viewFlags;
+    cacheCell.Rotation = rotation;
+    return cacheCell.DrawList;
+}
+
+/**
+ * Whether no cells are cached, which is always the case while caching paint lists is disabled.
+ */
+bool paint_cache_is_empty()
+{
+    return _cells.empty();
+}
+
+/**
+ * Drops all cells that overlap the given area. Left, top, right and bottom are view coordinates, the same as for
+ * viewport_invalidate.
+ */
+void paint_cache_invalidate(int32_t left, int32_t top, int32_t right, int32_t bottom)
+{
+    if (_cells.empty())
+        return;
+
+    for (ZoomLevel zoom = ZoomLevel::min(); zoom <= ZoomLevel::max(); zoom++)
+    {
+        if (_cellsPerZoom[GetZoomIndex(zoom)] == 0)
+            continue;
+
+        const int32_t cellHeight = paint_cache_get_cell_height(zoom);
+        const int32_t cellLeft = FloorDiv(left, PAINT_CACHE_CELL_WIDTH);
+        const int32_t cellTop = FloorDiv(top, cellHeight);
+        const int32_t cellRight = FloorDiv(right, PAINT_CACHE_CELL_WIDTH);
+        const int32_t cellBottom = FloorDiv(bottom, cellHeight);
+        const int64_t numCells = static_cast<int64_t>(cellRight - cellLeft + 1) * (cellBottom - cellTop + 1);
+        if (numCells > static_cast<int64_t>(_cellsPerZoom[GetZoomIndex(zoom)]))
+        {
+            // Large areas, look at the cells there are instead.
+            for (auto it = _cells.begin(); it != _cells.end();)
+            {
+                const auto& cell = it->second;
+                const int32_t cellX = FloorDiv(cell.Position.x, PAINT_CACHE_CELL_WIDTH);
+                const int32_t cellY = FloorDiv(cell.Position.y, cellHeight);
+                if (cell.Zoom == zoom && cellX >= cellLeft && cellX <= cellRight && cellY >= cellTop && cellY <= cellBottom)
+                {
+                    _cellsPerZoom[GetZoomIndex(zoom)]--;
+                    it = _cells.erase(it);
+                }
+                else
+                {
+                    it++;
+                }
+            }
+            continue;
+        }
+
+        for (int32_t cellX = cellLeft; cellX <= cellRight; cellX++)
+        {
+            for (int32_t cellY = cellTop; cellY <= cellBottom; cellY++)
+            {
+                auto it = _cells.find(GetCellKey(cellX, cellY, zoom));
+                if (it != _cells.end())
+                {
+                    RemoveCell(it);
+                }
+            }
+        }
+    }
+}
+
+void paint_cache_invalidate_all()
+{
+    _cells.clear();
+    _cellsPerZoom.fill(0);
+}
+
+PaintCacheStats paint_cache_get_stats()
+{
+    PaintCacheStats stats = _stats;
+    stats.Cells = _cells.size();
+    return stats;
+}
+
+void paint_cache_reset_stats()
+{
+    _stats = {};
+}
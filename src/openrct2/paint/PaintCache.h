@@ -0,0 +1,36 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "../interface/ZoomLevel.hpp"
+#include "Paint.h"
+
+// Cells are as wide as the columns viewport_paint splits the viewport into, in view coordinates.
+constexpr int32_t PAINT_CACHE_CELL_WIDTH = 32;
+// Cells are this many pixels high at any zoom level.
+constexpr int32_t PAINT_CACHE_CELL_HEIGHT = 64;
+
+struct PaintCacheStats
+{
+    uint64_t Hits;
+    uint64_t Misses;
+    size_t Cells;
+};
+
+int32_t paint_cache_get_cell_height(ZoomLevel zoom);
+void paint_cache_trim();
+const PaintDrawList* paint_cache_get(const CoordsXY& cell, ZoomLevel zoom, uint32_t viewFlags, uint8_t rotation);
+PaintDrawList& paint_cache_insert(const CoordsXY& cell, ZoomLevel zoom, uint32_t viewFlags, uint8_t rotation);
+bool paint_cache_is_empty();
+void paint_cache_invalidate(int32_t left, int32_t top, int32_t right, int32_t bottom);
+void paint_cache_invalidate_all();
+PaintCacheStats paint_cache_get_stats();
+void paint_cache_reset_stats();
@@ -157,18 +157,22 @@ paint_session* Painter::CreateSession(rct_drawpixelinfo* dpi, uint32_t viewFlags
     {
         // Create new one in pool.
         _paintSessionPool.emplace_back(std::make_unique<paint_session>());
+        _paintEntryArenas.emplace_back(std::make_unique<PaintEntryArena>());
         session = _paintSessionPool.back().get();
+        session->PaintStructArena = _paintEntryArenas.back().get();
+        session->QuadrantBackIndex = std::numeric_limits<uint32_t>::max();
+        session->QuadrantFrontIndex = 0;
     }
 
     session->DPI = *dpi;
-    session->EndOfPaintStructArray = &session->PaintStructs[4000 - 1];
-    session->NextFreePaintStruct = session->PaintStructs;
+    session->PaintStructArena->Reset(*session);
     session->LastRootPS = nullptr;
     session->UnkF1AD2C = nullptr;
     session->ViewFlags = viewFlags;
-    for (auto& quadrant : session->Quadrants)
+    // Only the quadrants between the back and front index can have been used since the session was last reset.
+    for (uint32_t i = session->QuadrantBackIndex; i <= session->QuadrantFrontIndex; i++)
     {
-        quadrant = nullptr;
+        session->Quadrants[i] = nullptr;
     }
     session->QuadrantBackIndex = std::numeric_limits<uint32_t>::max();
     session->QuadrantFrontIndex = 0;
@@ -183,5 +187,26 @@ paint_session* Painter::CreateSession(rct_drawpixelinfo* dpi, uint32_t viewFlags
 
 void Painter::ReleaseSession(paint_session* session)
 {
+    const auto paintStructCount = static_cast<uint32_t>(session->PaintStructArena->GetUsedCount(*session));
+    _sessionStats.Sessions++;
+    _sessionStats.PeakPaintStructs = std::max(_sessionStats.PeakPaintStructs, paintStructCount);
+    _sessionStats.TotalPaintStructs += paintStructCount;
+
     _freePaintSessions.push_back(session);
 }
+
+PaintSessionStats Painter::GetSessionStats() const
+{
+    PaintSessionStats stats = _sessionStats;
+    stats.ReservedPaintStructs = 0;
+    for (const auto& arena : _paintEntryArenas)
+    {
+        stats.ReservedPaintStructs += arena->GetReservedCount();
+    }
+    return stats;
+}
+
+void Painter::ResetSessionStats()
+{
+    _sessionStats = {};
+}
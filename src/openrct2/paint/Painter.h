@@ -37,7 +37,9 @@ namespace OpenRCT2
         private:
             std::shared_ptr<Ui::IUiContext> const _uiContext;
             std::vector<std::unique_ptr<paint_session>> _paintSessionPool;
+            std::vector<std::unique_ptr<PaintEntryArena>> _paintEntryArenas;
             std::vector<paint_session*> _freePaintSessions;
+            PaintSessionStats _sessionStats = {};
             time_t _lastSecond = 0;
             int32_t _currentFPS = 0;
             int32_t _frames = 0;
@@ -48,6 +50,8 @@ namespace OpenRCT2
 
             paint_session* CreateSession(rct_drawpixelinfo * dpi, uint32_t viewFlags);
             void ReleaseSession(paint_session * session);
+            PaintSessionStats GetSessionStats() const;
+            void ResetSessionStats();
 
         private:
             void PaintReplayNotice(rct_drawpixelinfo * dpi, const char* text);
@@ -21,6 +21,7 @@
 #include "../network/network.h"
 #include "../ride/Ride.h"
 #include "../ride/RideData.h"
+#include "../ride/RideProximity.h"
 #include "../ride/ShopItem.h"
 #include "../ride/Station.h"
 #include "../ride/Track.h"
@@ -1875,6 +1876,44 @@ void Guest::PickRideToGoOn()
     }
 }
 
+static std::bitset<MAX_RIDES> _tallRides;
+static bool _tallRidesCached;
+
+/**
+ * Rides that every guest takes into consideration, realistic as you can usually see them from anywhere in the park.
+ */
+static std::bitset<MAX_RIDES> guest_get_tall_rides()
+{
+    if (_tallRidesCached)
+        return _tallRides;
+
+    std::bitset<MAX_RIDES> tallRides;
+    for (auto& ride : GetRideManager())
+    {
+        if (ride.highest_drop_height > 66 || ride.excitement >= RIDE_RATING(8, 00))
+        {
+            tallRides[ride.id] = true;
+        }
+    }
+    return tallRides;
+}
+
+/**
+ * Rides and their ratings are not changed while peeps update, so the tall rides and the rides near each tile only need
+ * to be found once a tick.
+ */
+void guest_cache_rides_to_consider()
+{
+    _tallRides = guest_get_tall_rides();
+    _tallRidesCached = true;
+    ride_proximity_update();
+}
+
+void guest_clear_rides_to_consider()
+{
+    _tallRidesCached = false;
+}
+
 Ride* Guest::FindBestRideToGoOn()
 {
     // Pick the most exciting ride
@@ -1920,39 +1959,8 @@ std::bitset<MAX_RIDES> Guest::FindRidesToGoOn()
     else
     {
         // Take nearby rides into consideration
-        constexpr auto radius = 10 * 32;
-        int32_t cx = floor2(x, 32);
-        int32_t cy = floor2(y, 32);
-        for (int32_t tileX = cx - radius; tileX <= cx + radius; tileX += COORDS_XY_STEP)
-        {
-            for (int32_t tileY = cy - radius; tileY <= cy + radius; tileY += COORDS_XY_STEP)
-            {
-                if (map_is_location_valid({ tileX, tileY }))
-                {
-                    auto tileElement = map_get_first_element_at({ tileX, tileY });
-                    if (tileElement != nullptr)
-                    {
-                        do
-                        {
-                            if (tileElement->GetType() == TILE_ELEMENT_TYPE_TRACK)
-                            {
-                                auto rideIndex = tileElement->AsTrack()->GetRideIndex();
-                                rideConsideration[rideIndex] = true;
-                            }
-                        } while (!(tileElement++)->IsLastForTile());
-                    }
-                }
-            }
-        }
-
-        // Always take the tall rides into consideration (realistic as you can usually see them from anywhere in the park)
-        for (auto& ride : GetRideManager())
-        {
-            if (ride.highest_drop_height > 66 || ride.excitement >= RIDE_RATING(8, 00))
-            {
-                rideConsideration[ride.id] = true;
-            }
-        }
+        rideConsideration = ride_proximity_get_nearby_rides({ x, y });
+        rideConsideration |= guest_get_tall_rides();
     }
 
     return rideConsideration;
@@ -3012,18 +3020,7 @@ static PeepThoughtType peep_assess_surroundings(int16_t centre_x, int16_t centre
         }
     }
 
-    Litter* litter;
-    for (uint16_t sprite_idx = gSpriteListHead[SPRITE_LIST_LITTER]; sprite_idx != SPRITE_INDEX_NULL; sprite_idx = litter->next)
-    {
-        litter = &(get_sprite(sprite_idx)->litter);
-
-        int16_t dist_x = abs(litter->x - centre_x);
-        int16_t dist_y = abs(litter->y - centre_y);
-        if (std::max(dist_x, dist_y) <= 160)
-        {
-            num_rubbish++;
-        }
-    }
+    num_rubbish += litter_count_in_range({ centre_x - 160, centre_y - 160, centre_x + 160, centre_y + 160 });
 
     if (num_fountains >= 5 && num_rubbish < 20)
         return PEEP_THOUGHT_TYPE_FOUNTAINS;
@@ -6270,21 +6267,14 @@ static void peep_update_walking_break_scenery(Peep* peep)
         return;
     }
 
-    Peep* inner_peep;
-    uint16_t sprite_index;
-
-    FOR_ALL_STAFF (sprite_index, inner_peep)
+    // Check if there is a security guard nearby
+    for (auto spriteIndex : sprite_query_rect({ peep->x - 223, peep->y - 223, peep->x + 223, peep->y + 223 }))
     {
-        if (inner_peep->StaffType != STAFF_TYPE_SECURITY)
+        auto inner_peep = get_sprite(spriteIndex)->generic.As<Peep>();
+        if (inner_peep == nullptr || inner_peep->AssignedPeepType != PEEP_TYPE_STAFF)
             continue;
 
-        if (inner_peep->x == LOCATION_NULL)
-            continue;
-
-        int32_t x_diff = abs(inner_peep->x - peep->x);
-        int32_t y_diff = abs(inner_peep->y - peep->y);
-
-        if (std::max(x_diff, y_diff) < 224)
+        if (inner_peep->StaffType == STAFF_TYPE_SECURITY)
             return;
     }
 
@@ -7,6 +7,7 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 
+#include "../Cheats.h"
 #include "../core/Guard.hpp"
 #include "../ride/RideData.h"
 #include "../ride/Station.h"
@@ -15,6 +16,7 @@
 #include "../util/Util.h"
 #include "../world/Entrance.h"
 #include "../world/Footpath.h"
+#include "../world/FootpathGraph.h"
 #include "Peep.h"
 #include "Staff.h"
 
@@ -1236,6 +1238,19 @@ Direction peep_pathfind_choose_direction(const TileCoordsXYZ& loc, Peep* peep)
         return INVALID_DIRECTION;
 
     permitted_edges &= 0xF;
+
+    /* With fast pathfinding guests take the shortest route over the
+     * footpath graph instead. The heuristic search below is only used
+     * when the graph cannot reach the goal, so nothing changes while the
+     * cheat is off. */
+    if (gCheatsFastPathfinding && !_peepPathFindIsStaff && bitcount(permitted_edges) > 1)
+    {
+        Direction direction = footpath_graph_choose_direction(
+            loc, permitted_edges, goal, gPeepPathFindQueueRideIndex, gPeepPathFindIgnoreForeignQueues);
+        if (direction != INVALID_DIRECTION)
+            return direction;
+    }
+
     uint8_t edges = permitted_edges;
     if (isThin && peep->PathfindGoal.x == goal.x && peep->PathfindGoal.y == goal.y && peep->PathfindGoal.z == goal.z)
     {
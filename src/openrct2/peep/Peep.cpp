@@ -409,6 +409,8 @@ void peep_update_all()
     if (gScreenFlags & SCREEN_FLAGS_EDITOR)
         return;
 
+    guest_cache_rides_to_consider();
+
     // Do not use the FOR_ALL_PEEPS macro for this as next sprite index
     // will be fetched on a delted peep if peep leaves the park.
     for (spriteIndex = gSpriteListHead[SPRITE_LIST_PEEP]; spriteIndex != SPRITE_INDEX_NULL;)
@@ -431,6 +433,8 @@ void peep_update_all()
 
         i++;
     }
+
+    guest_clear_rides_to_consider();
 }
 
 /**
@@ -1030,6 +1030,8 @@ Peep* try_get_guest(uint16_t spriteIndex);
 int32_t peep_get_staff_count();
 bool peep_can_be_picked_up(Peep* peep);
 void peep_update_all();
+void guest_cache_rides_to_consider();
+void guest_clear_rides_to_consider();
 void peep_problem_warnings_update();
 void peep_stop_crowd_noise();
 void peep_update_crowd_noise();
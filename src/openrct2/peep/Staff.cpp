@@ -441,24 +441,8 @@ void staff_toggle_patrol_area(int32_t staffIndex, int32_t x, int32_t y)
  */
 static uint8_t staff_handyman_direction_to_nearest_litter(Peep* peep)
 {
-    uint16_t nearestLitterDist = 0xFFFF;
-    Litter* nearestLitter = nullptr;
-    Litter* litter = nullptr;
-
-    for (uint16_t litterIndex = gSpriteListHead[SPRITE_LIST_LITTER]; litterIndex != 0xFFFF; litterIndex = litter->next)
-    {
-        litter = &get_sprite(litterIndex)->litter;
-
-        uint16_t distance = abs(litter->x - peep->x) + abs(litter->y - peep->y) + abs(litter->z - peep->z) * 4;
-
-        if (distance < nearestLitterDist)
-        {
-            nearestLitterDist = distance;
-            nearestLitter = litter;
-        }
-    }
-
-    if (nearestLitterDist > 0x60)
+    Litter* nearestLitter = litter_get_nearest({ peep->x, peep->y, peep->z }, 0x60);
+    if (nearestLitter == nullptr)
     {
         return INVALID_DIRECTION;
     }
@@ -1018,27 +1002,19 @@ bool Staff::DoMiscPathFinding()
  */
 static void staff_entertainer_update_nearby_peeps(Peep* peep)
 {
-    uint16_t spriteIndex;
-    Peep* guest;
+    if (peep->x == LOCATION_NULL)
+        return;
 
-    FOR_ALL_GUESTS (spriteIndex, guest)
+    for (auto spriteIndex : sprite_query_rect({ peep->x - 96, peep->y - 96, peep->x + 96, peep->y + 96 }))
     {
-        if (guest->x == LOCATION_NULL)
+        auto guest = get_sprite(spriteIndex)->generic.As<Peep>();
+        if (guest == nullptr || guest->AssignedPeepType != PEEP_TYPE_GUEST)
             continue;
 
         int16_t z_dist = abs(peep->z - guest->z);
         if (z_dist > 48)
             continue;
 
-        int16_t x_dist = abs(peep->x - guest->x);
-        int16_t y_dist = abs(peep->y - guest->y);
-
-        if (x_dist > 96)
-            continue;
-
-        if (y_dist > 96)
-            continue;
-
         if (peep->State == PEEP_STATE_WALKING)
         {
             peep->HappinessTarget = std::min(peep->HappinessTarget + 4, PEEP_MAX_HAPPINESS);
@@ -10,6 +10,9 @@
 #include "SawyerChunkReader.h"
 
 #include "../core/IStream.hpp"
+#include "../core/TaskScheduler.h"
+
+#include <exception>
 
 // malloc is very slow for large allocations in MSVC debug builds as it allocates
 // memory on a special debug heap and then initialises all the memory to 0xCC.
@@ -163,6 +166,119 @@ void SawyerChunkReader::ReadChunk(void* dst, size_t length)
     }
 }
 
+void SawyerChunkReader::ReadChunks(const std::vector<SawyerChunkDestination>& destinations)
+{
+    uint64_t originalPosition = _stream->GetPosition();
+    try
+    {
+        // Find where the chunks are so all of their data can be read at once.
+        std::vector<sawyercoding_chunk_header> headers;
+        std::vector<size_t> offsets;
+        uint64_t position = originalPosition;
+        for (size_t i = 0; i < destinations.size(); i++)
+        {
+            auto header = _stream->ReadValue<sawyercoding_chunk_header>();
+            if (header.length >= MAX_UNCOMPRESSED_CHUNK_SIZE)
+                throw SawyerChunkException(EXCEPTION_MSG_CORRUPT_CHUNK_SIZE);
+            if (header.encoding > CHUNK_ENCODING_ROTATE)
+                throw SawyerChunkException(EXCEPTION_MSG_INVALID_CHUNK_ENCODING);
+
+            position += sizeof(sawyercoding_chunk_header);
+            if (position + header.length > _stream->GetLength())
+                throw SawyerChunkException(EXCEPTION_MSG_CORRUPT_CHUNK_SIZE);
+
+            headers.push_back(header);
+            offsets.push_back(static_cast<size_t>(position - originalPosition));
+            position += header.length;
+            _stream->SetPosition(position);
+        }
+
+        // Streams that are in memory already, such as mapped files, are decoded in place.
+        const size_t dataLength = static_cast<size_t>(position - originalPosition);
+        std::unique_ptr<uint8_t[]> dataCopy;
+        const uint8_t* data = static_cast<const uint8_t*>(_stream->GetData());
+        if (data != nullptr)
+        {
+            data += originalPosition;
+        }
+        else
+        {
+            dataCopy.reset(new uint8_t[dataLength]);
+            _stream->SetPosition(originalPosition);
+            if (_stream->TryRead(dataCopy.get(), dataLength) != dataLength)
+            {
+                throw SawyerChunkException(EXCEPTION_MSG_CORRUPT_CHUNK_SIZE);
+            }
+            data = dataCopy.get();
+        }
+
+        std::vector<std::exception_ptr> errors(destinations.size());
+        TaskScheduler::GetDefault().ParallelFor(0, destinations.size(), 1, [&](size_t i) {
+            try
+            {
+                DecodeChunkTo(destinations[i], data + offsets[i], headers[i]);
+            }
+            catch (const std::exception&)
+            {
+                errors[i] = std::current_exception();
+            }
+        });
+        for (const auto& error : errors)
+        {
+            if (error != nullptr)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+    }
+    catch (const std::exception&)
+    {
+        // Rewind stream back to original position
+        _stream->SetPosition(originalPosition);
+        throw;
+    }
+}
+
+/**
+ * Decodes a chunk into its destination the same way ReadChunk(void*, size_t) does.
+ */
+void SawyerChunkReader::DecodeChunkTo(
+    const SawyerChunkDestination& destination, const void* src, const sawyercoding_chunk_header& header)
+{
+    auto dst = static_cast<uint8_t*>(destination.Data);
+    size_t length = 0;
+    try
+    {
+        // Chunks of valid parks always fit their destination, so they can skip the temporary buffer.
+        length = DecodeChunk(dst, destination.Length, src, header);
+    }
+    catch (const SawyerChunkException&)
+    {
+        // Larger chunks are cut off, decode it again in full to tell them apart from corrupt ones.
+        auto buffer = static_cast<uint8_t*>(AllocateLargeTempBuffer());
+        try
+        {
+            length = DecodeChunk(buffer, MAX_UNCOMPRESSED_CHUNK_SIZE, src, header);
+        }
+        catch (const std::exception&)
+        {
+            FreeLargeTempBuffer(buffer);
+            throw;
+        }
+        std::memcpy(dst, buffer, std::min(length, destination.Length));
+        FreeLargeTempBuffer(buffer);
+    }
+
+    if (length == 0)
+    {
+        throw SawyerChunkException(EXCEPTION_MSG_ZERO_SIZED_CHUNK);
+    }
+    if (length < destination.Length)
+    {
+        std::fill_n(dst + length, destination.Length - length, 0x00);
+    }
+}
+
 size_t SawyerChunkReader::DecodeChunk(void* dst, size_t dstCapacity, const void* src, const sawyercoding_chunk_header& header)
 {
     size_t resultLength;
@@ -194,12 +310,41 @@ size_t SawyerChunkReader::DecodeChunk(void* dst, size_t dstCapacity, const void*
 size_t SawyerChunkReader::DecodeChunkRLERepeat(void* dst, size_t dstCapacity, const void* src, size_t srcLength)
 {
     auto immBuffer = AllocateLargeTempBuffer();
-    auto immLength = DecodeChunkRLE(immBuffer, MAX_UNCOMPRESSED_CHUNK_SIZE, src, srcLength);
-    auto size = DecodeChunkRepeat(dst, dstCapacity, immBuffer, immLength);
+    size_t size;
+    try
+    {
+        auto immLength = DecodeChunkRLE(immBuffer, MAX_UNCOMPRESSED_CHUNK_SIZE, src, srcLength);
+        size = DecodeChunkRepeat(dst, dstCapacity, immBuffer, immLength);
+    }
+    catch (const std::exception&)
+    {
+        FreeLargeTempBuffer(immBuffer);
+        throw;
+    }
     FreeLargeTempBuffer(immBuffer);
     return size;
 }
 
+// Runs are copied in fixed size blocks when there is room for the extra bytes that may be written, which saves
+// working out how to copy each run of a different length.
+constexpr size_t COPY_BLOCK_SIZE = 16;
+
+static void copy_blocks(uint8_t* dst, const uint8_t* src, size_t count)
+{
+    for (size_t i = 0; i < count; i += COPY_BLOCK_SIZE)
+    {
+        std::memcpy(dst + i, src + i, COPY_BLOCK_SIZE);
+    }
+}
+
+static void fill_blocks(uint8_t* dst, uint8_t value, size_t count)
+{
+    for (size_t i = 0; i < count; i += COPY_BLOCK_SIZE)
+    {
+        std::memset(dst + i, value, COPY_BLOCK_SIZE);
+    }
+}
+
 size_t SawyerChunkReader::DecodeChunkRLE(void* dst, size_t dstCapacity, const void* src, size_t srcLength)
 {
     auto src8 = static_cast<const uint8_t*>(src);
@@ -222,7 +367,14 @@ size_t SawyerChunkReader::DecodeChunkRLE(void* dst, size_t dstCapacity, const vo
                 throw SawyerChunkException(EXCEPTION_MSG_DESTINATION_TOO_SMALL);
             }
 
-            std::fill_n(dst8, count, src8[i]);
+            if (dst8 + count + COPY_BLOCK_SIZE <= dstEnd)
+            {
+                fill_blocks(dst8, src8[i], count);
+            }
+            else
+            {
+                std::fill_n(dst8, count, src8[i]);
+            }
             dst8 += count;
         }
         else
@@ -240,7 +392,14 @@ size_t SawyerChunkReader::DecodeChunkRLE(void* dst, size_t dstCapacity, const vo
                 throw SawyerChunkException(EXCEPTION_MSG_CORRUPT_RLE);
             }
 
-            std::memcpy(dst8, src8 + i + 1, rleCodeByte + 1);
+            if (dst8 + rleCodeByte + 1 + COPY_BLOCK_SIZE <= dstEnd && i + 1 + rleCodeByte + 1 + COPY_BLOCK_SIZE <= srcLength)
+            {
+                copy_blocks(dst8, src8 + i + 1, rleCodeByte + 1);
+            }
+            else
+            {
+                std::memcpy(dst8, src8 + i + 1, rleCodeByte + 1);
+            }
             dst8 += rleCodeByte + 1;
             i += rleCodeByte + 1;
         }
@@ -257,6 +416,14 @@ size_t SawyerChunkReader::DecodeChunkRepeat(void* dst, size_t dstCapacity, const
     {
         if (src8[i] == 0xFF)
         {
+            if (i + 1 >= srcLength)
+            {
+                throw SawyerChunkException(EXCEPTION_MSG_CORRUPT_RLE);
+            }
+            if (dst8 >= dstEnd)
+            {
+                throw SawyerChunkException(EXCEPTION_MSG_DESTINATION_TOO_SMALL);
+            }
             *dst8++ = src8[++i];
         }
         else
@@ -264,12 +431,25 @@ size_t SawyerChunkReader::DecodeChunkRepeat(void* dst, size_t dstCapacity, const
             size_t count = (src8[i] & 7) + 1;
             const uint8_t* copySrc = dst8 + static_cast<int32_t>(src8[i] >> 3) - 32;
 
-            if (dst8 + count >= dstEnd || copySrc + count >= dstEnd)
+            if (copySrc < static_cast<const uint8_t*>(dst))
+            {
+                throw SawyerChunkException(EXCEPTION_MSG_CORRUPT_RLE);
+            }
+            if (dst8 + count > dstEnd || copySrc + count > dstEnd)
             {
                 throw SawyerChunkException(EXCEPTION_MSG_DESTINATION_TOO_SMALL);
             }
 
-            std::memcpy(dst8, copySrc, count);
+            // Copying all 8 bytes a repeat can have is quicker than copying count bytes, as long as they do not
+            // overlap the bytes being written.
+            if (dst8 - copySrc >= 8 && dst8 + 8 < dstEnd)
+            {
+                std::memcpy(dst8, copySrc, 8);
+            }
+            else
+            {
+                std::memcpy(dst8, copySrc, count);
+            }
             dst8 += count;
         }
     }
@@ -283,14 +463,7 @@ size_t SawyerChunkReader::DecodeChunkRotate(void* dst, size_t dstCapacity, const
         throw SawyerChunkException(EXCEPTION_MSG_DESTINATION_TOO_SMALL);
     }
 
-    auto src8 = static_cast<const uint8_t*>(src);
-    auto dst8 = static_cast<uint8_t*>(dst);
-    uint8_t code = 1;
-    for (size_t i = 0; i < srcLength; i++)
-    {
-        dst8[i] = ror8(src8[i], code);
-        code = (code + 2) % 8;
-    }
+    sawyercoding_decode_rotate(static_cast<uint8_t*>(dst), static_cast<const uint8_t*>(src), srcLength);
     return srcLength;
 }
 
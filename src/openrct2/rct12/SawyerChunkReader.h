@@ -14,9 +14,19 @@
 #include "SawyerChunk.h"
 
 #include <memory>
+#include <vector>
 
 interface IStream;
 
+/**
+ * Where ReadChunks puts a chunk, the same as the destination buffer of ReadChunk.
+ */
+struct SawyerChunkDestination
+{
+    void* Data;
+    size_t Length;
+};
+
 /**
  * Reads sawyer encoding chunks from a data stream. This can be used to read
  * SC6, SV6 and RCT2 objects.
@@ -55,6 +65,14 @@ public:
      */
     void ReadChunk(void* dst, size_t length);
 
+    /**
+     * Reads the next chunks from the stream, one for each destination, with the
+     * same result as calling ReadChunk for each of them in turn. The data of all
+     * chunks is read at once and the chunks are decoded in parallel, straight
+     * into their destination.
+     */
+    void ReadChunks(const std::vector<SawyerChunkDestination>& destinations);
+
     /**
      * Reads the next chunk from the stream into a buffer returned as the
      * specified type. If the chunk is smaller than the size of the type
@@ -69,6 +87,8 @@ public:
 
 private:
     static size_t DecodeChunk(void* dst, size_t dstCapacity, const void* src, const sawyercoding_chunk_header& header);
+    static void DecodeChunkTo(
+        const SawyerChunkDestination& destination, const void* src, const sawyercoding_chunk_header& header);
     static size_t DecodeChunkRLERepeat(void* dst, size_t dstCapacity, const void* src, size_t srcLength);
     static size_t DecodeChunkRLE(void* dst, size_t dstCapacity, const void* src, size_t srcLength);
     static size_t DecodeChunkRepeat(void* dst, size_t dstCapacity, const void* src, size_t srcLength);
@@ -12,8 +12,7 @@
 #include "../core/IStream.hpp"
 #include "../util/SawyerCoding.h"
 
-// Maximum buffer size to store compressed data, maximum of 16 MiB
-constexpr size_t MAX_COMPRESSED_CHUNK_SIZE = 16 * 1024 * 1024;
+#include <algorithm>
 
 SawyerChunkWriter::SawyerChunkWriter(IStream* stream)
     : _stream(stream)
@@ -31,10 +30,10 @@ void SawyerChunkWriter::WriteChunk(const void* src, size_t length, SAWYER_ENCODI
     header.encoding = static_cast<uint8_t>(encoding);
     header.length = static_cast<uint32_t>(length);
 
-    auto data = std::make_unique<uint8_t[]>(MAX_COMPRESSED_CHUNK_SIZE);
-    size_t dataLength = sawyercoding_write_chunk_buffer(data.get(), static_cast<const uint8_t*>(src), header);
+    const uint8_t* data = sawyercoding_encode_chunk(header, static_cast<const uint8_t*>(src), _buffer, _tempBuffer);
 
-    _stream->Write(data.get(), dataLength);
+    _stream->Write(&header, sizeof(header));
+    _stream->Write(data, header.length);
 }
 
 /**
@@ -91,8 +90,10 @@ static size_t EncodeChunkRLE(const uint8_t* src_buffer, uint8_t* dst_buffer, siz
 
 void SawyerChunkWriter::WriteChunkTrack(const void* src, size_t length)
 {
-    auto data = std::make_unique<uint8_t[]>(MAX_COMPRESSED_CHUNK_SIZE);
-    size_t dataLength = EncodeChunkRLE(static_cast<const uint8_t*>(src), data.get(), length);
+    // At worst a single byte followed by a pair of equal bytes, which takes four bytes for three.
+    _buffer.resize(std::max(_buffer.size(), length + length / 2 + 2));
+    uint8_t* data = _buffer.data();
+    size_t dataLength = EncodeChunkRLE(static_cast<const uint8_t*>(src), data, length);
 
     uint32_t checksum = 0;
     for (size_t i = 0; i < dataLength; i++)
@@ -103,6 +104,6 @@ void SawyerChunkWriter::WriteChunkTrack(const void* src, size_t length)
     }
     checksum -= 0x1D4C1;
 
-    _stream->Write(data.get(), dataLength);
+    _stream->Write(data, dataLength);
     _stream->WriteValue<uint32_t>(checksum);
 }
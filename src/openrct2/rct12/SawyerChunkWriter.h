@@ -13,6 +13,7 @@
 #include "SawyerChunk.h"
 
 #include <memory>
+#include <vector>
 
 interface IStream;
 
@@ -24,6 +25,10 @@ class SawyerChunkWriter final
 {
 private:
     IStream* const _stream = nullptr;
+    // Chunks are encoded into these, they are kept for the next chunk. Each chunk is written out as soon as it is
+    // encoded, so at most the encoded data of the largest chunk is held, never the whole file.
+    std::vector<uint8_t> _buffer;
+    std::vector<uint8_t> _tempBuffer;
 
 public:
     explicit SawyerChunkWriter(IStream* stream);
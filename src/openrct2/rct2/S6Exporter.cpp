@@ -15,8 +15,10 @@
 #include "../OpenRCT2.h"
 #include "../common.h"
 #include "../config/Config.h"
+#include "../core/ChecksumStream.hpp"
 #include "../core/FileStream.hpp"
 #include "../core/IStream.hpp"
+#include "../core/MemoryStream.h"
 #include "../core/String.hpp"
 #include "../interface/Viewport.h"
 #include "../interface/Window.h"
@@ -43,6 +45,7 @@
 #include "../util/SawyerCoding.h"
 #include "../util/Util.h"
 #include "../world/Climate.h"
+#include "../world/LargeScenery.h"
 #include "../world/MapAnimation.h"
 #include "../world/Park.h"
 #include "../world/Sprite.h"
@@ -50,7 +53,9 @@
 #include <algorithm>
 #include <cstring>
 #include <functional>
+#include <future>
 #include <iterator>
+#include <memory>
 #include <optional>
 
 S6Exporter::S6Exporter()
@@ -90,7 +95,9 @@ void S6Exporter::Save(IStream* stream, bool isScenario)
     _s6.header.magic_number = S6_MAGIC_NUMBER;
     _s6.game_version_number = 201028;
 
-    auto chunkWriter = SawyerChunkWriter(stream);
+    // Everything is written through the checksum stream so the file does not have to be read back for its checksum.
+    auto checksumStream = ChecksumStream(stream);
+    auto chunkWriter = SawyerChunkWriter(&checksumStream);
 
     // 0: Write header chunk
     chunkWriter.WriteChunk(&_s6.header, SAWYER_ENCODING::ROTATE);
@@ -104,8 +111,15 @@ void S6Exporter::Save(IStream* stream, bool isScenario)
     // 2: Write packed objects
     if (_s6.header.num_packed_objects > 0)
     {
-        auto& objRepo = OpenRCT2::GetContext()->GetObjectRepository();
-        objRepo.WritePackedObjects(stream, ExportObjectsList);
+        if (_objectsPacked)
+        {
+            checksumStream.Write(_packedObjects.data(), _packedObjects.size());
+        }
+        else
+        {
+            auto& objRepo = OpenRCT2::GetContext()->GetObjectRepository();
+            objRepo.WritePackedObjects(&checksumStream, ExportObjectsList);
+        }
     }
 
     // 3: Write available objects chunk
@@ -135,21 +149,49 @@ void S6Exporter::Save(IStream* stream, bool isScenario)
         chunkWriter.WriteChunk(&_s6.next_free_tile_element_pointer_index, 0x2E8570, SAWYER_ENCODING::RLECOMPRESSED);
     }
 
-    // Determine number of bytes written
-    size_t fileSize = stream->GetLength();
+    // Write the checksum on the end
+    stream->WriteValue(checksumStream.GetChecksum());
+}
 
-    // Read all written bytes back into a single buffer
-    stream->SetPosition(0);
-    auto data = std::unique_ptr<uint8_t, std::function<void(uint8_t*)>>(
-        stream->ReadArray<uint8_t>(fileSize), Memory::Free<uint8_t>);
-    uint32_t checksum = sawyercoding_calculate_checksum(data.get(), fileSize);
+/**
+ * Packs the objects to export up front, so saving the park afterwards does not need the object repository.
+ */
+void S6Exporter::PackObjects()
+{
+    MemoryStream stream;
+    auto& objRepo = OpenRCT2::GetContext()->GetObjectRepository();
+    objRepo.WritePackedObjects(&stream, ExportObjectsList);
 
-    // Write the checksum on the end
-    stream->SetPosition(fileSize);
-    stream->WriteValue(checksum);
+    auto data = static_cast<const uint8_t*>(stream.GetData());
+    _packedObjects.assign(data, data + stream.GetLength());
+    _objectsPacked = true;
 }
 
 void S6Exporter::Export()
+{
+    ExportGameState();
+    ExportTileElementsAndSprites(gTileElements, get_sprite(0));
+}
+
+void S6Exporter::BeginExport()
+{
+    ExportGameState();
+
+    _tileElements.resize(RCT2_MAX_TILE_ELEMENTS);
+    std::memcpy(_tileElements.data(), gTileElements, RCT2_MAX_TILE_ELEMENTS * sizeof(TileElement));
+    _sprites.resize(RCT2_MAX_SPRITES);
+    std::memcpy(_sprites.data(), get_sprite(0), RCT2_MAX_SPRITES * sizeof(rct_sprite));
+}
+
+void S6Exporter::FinishExport()
+{
+    ExportTileElementsAndSprites(_tileElements.data(), _sprites.data());
+
+    _tileElements = {};
+    _sprites = {};
+}
+
+void S6Exporter::ExportGameState()
 {
     int32_t spatial_cycle = check_for_spatial_index_cycles(false);
     int32_t regular_cycle = check_for_sprite_list_cycles(false);
@@ -198,8 +240,20 @@ void S6Exporter::Export()
 
     // Map elements must be reorganised prior to saving otherwise save may be invalid
     map_reorganise_elements();
-    ExportTileElements();
-    ExportSprites();
+    _s6.next_free_tile_element_pointer_index = gNextFreeTileElementPointerIndex;
+    ExportScrollingSceneryEntries();
+
+    // Sprites needs to be reset before they get used.
+    // Might as well reset them in here to zero out the space and improve
+    // compression ratios. Especially useful for multiplayer servers that
+    // use zlib on the sent stream.
+    sprite_clear_all_unused();
+    ExportPeepNames();
+    for (int32_t i = 0; i < SPRITE_LIST_COUNT; i++)
+    {
+        _s6.sprite_lists_head[i] = gSpriteListHead[i];
+        _s6.sprite_lists_count[i] = gSpriteListCount[i];
+    }
     ExportParkName();
 
     _s6.initial_cash = gInitialCash;
@@ -423,6 +477,12 @@ void S6Exporter::Export()
     {
         scenario_remove_trackless_rides(&_s6);
     }
+}
+
+void S6Exporter::ExportTileElementsAndSprites(const TileElement* tileElements, const rct_sprite* sprites)
+{
+    ExportTileElements(tileElements);
+    ExportSprites(sprites);
 
     scenario_fix_ghosts(&_s6);
     game_convert_strings_to_rct2(&_s6);
@@ -936,22 +996,34 @@ void S6Exporter::ExportMarketingCampaigns()
     }
 }
 
-void S6Exporter::ExportSprites()
+void S6Exporter::ExportPeepNames()
 {
-    // Sprites needs to be reset before they get used.
-    // Might as well reset them in here to zero out the space and improve
-    // compression ratios. Especially useful for multiplayer servers that
-    // use zlib on the sent stream.
-    sprite_clear_all_unused();
+    _peepNameStringIds.clear();
     for (int32_t i = 0; i < RCT2_MAX_SPRITES; i++)
     {
-        ExportSprite(&_s6.sprites[i], get_sprite(i));
+        const auto* sprite = get_sprite(i);
+        if (sprite->generic.sprite_identifier != SPRITE_IDENTIFIER_PEEP || sprite->peep.Name == nullptr)
+            continue;
+
+        auto stringId = AllocateUserString(sprite->peep.Name);
+        if (stringId != std::nullopt)
+        {
+            _peepNameStringIds[sprite->peep.sprite_index] = *stringId;
+        }
+        else
+        {
+            log_warning(
+                "Unable to allocate user string for peep #%d (%s) during S6 export.",
+                static_cast<int>(sprite->peep.sprite_index), sprite->peep.Name);
+        }
     }
+}
 
-    for (int32_t i = 0; i < SPRITE_LIST_COUNT; i++)
+void S6Exporter::ExportSprites(const rct_sprite* sprites)
+{
+    for (int32_t i = 0; i < RCT2_MAX_SPRITES; i++)
     {
-        _s6.sprite_lists_head[i] = gSpriteListHead[i];
-        _s6.sprite_lists_count[i] = gSpriteListCount[i];
+        ExportSprite(&_s6.sprites[i], &sprites[i]);
     }
 }
 
@@ -1007,8 +1079,6 @@ void S6Exporter::ExportSpriteCommonProperties(RCT12SpriteBase* dst, const Sprite
 
 void S6Exporter::ExportSpriteVehicle(RCT2SpriteVehicle* dst, const Vehicle* src)
 {
-    const auto* ride = get_ride(src->ride);
-
     ExportSpriteCommonProperties(dst, static_cast<const SpriteBase*>(src));
     dst->vehicle_sprite_type = src->vehicle_sprite_type;
     dst->bank_rotation = src->bank_rotation;
@@ -1019,7 +1089,10 @@ void S6Exporter::ExportSpriteVehicle(RCT2SpriteVehicle* dst, const Vehicle* src)
     dst->vehicle_type = src->vehicle_type;
     dst->colours = src->colours;
     dst->track_progress = src->track_progress;
-    if (ride != nullptr && ride->mode == RIDE_MODE_BOAT_HIRE && src->status == VEHICLE_STATUS_TRAVELLING_BOAT)
+    // The rides have already been exported, use those rather than the live rides.
+    bool isBoatHire = src->ride < RCT12_MAX_RIDES_IN_PARK && _s6.rides[src->ride].type != RIDE_TYPE_NULL
+        && _s6.rides[src->ride].mode == RIDE_MODE_BOAT_HIRE;
+    if (isBoatHire && src->status == VEHICLE_STATUS_TRAVELLING_BOAT)
     {
         if (src->BoatLocation.isNull())
         {
@@ -1095,23 +1168,13 @@ void S6Exporter::ExportSpritePeep(RCT2SpritePeep* dst, const Peep* src)
 {
     ExportSpriteCommonProperties(dst, static_cast<const SpriteBase*>(src));
 
-    auto generateName = true;
-    if (src->Name != nullptr)
+    // The name was allocated by ExportPeepNames, src may be a copy whose name has since been freed.
+    auto nameStringId = _peepNameStringIds.find(src->sprite_index);
+    if (nameStringId != _peepNameStringIds.end())
     {
-        auto stringId = AllocateUserString(src->Name);
-        if (stringId != std::nullopt)
-        {
-            dst->name_string_idx = *stringId;
-            generateName = false;
-        }
-        else
-        {
-            log_warning(
-                "Unable to allocate user string for peep #%d (%s) during S6 export.", static_cast<int>(src->sprite_index),
-                src->Name);
-        }
+        dst->name_string_idx = nameStringId->second;
     }
-    if (generateName)
+    else
     {
         if (src->AssignedPeepType == PeepType::PEEP_TYPE_STAFF)
         {
@@ -1123,7 +1186,7 @@ void S6Exporter::ExportSpritePeep(RCT2SpritePeep* dst, const Peep* src)
             };
             dst->name_string_idx = staffNames[src->StaffType % sizeof(staffNames)];
         }
-        else if (gParkFlags & PARK_FLAGS_SHOW_REAL_GUEST_NAMES)
+        else if (_s6.park_flags & PARK_FLAGS_SHOW_REAL_GUEST_NAMES)
         {
             dst->name_string_idx = get_real_name_string_id_from_id(src->Id);
         }
@@ -1407,11 +1470,28 @@ void S6Exporter::ExportMapAnimations()
     }
 }
 
-void S6Exporter::ExportTileElements()
+void S6Exporter::ExportScrollingSceneryEntries()
+{
+    _scrollingWallEntries.assign(MAX_WALL_SCENERY_OBJECTS, false);
+    for (ObjectEntryIndex i = 0; i < MAX_WALL_SCENERY_OBJECTS; i++)
+    {
+        auto entry = get_wall_entry(i);
+        _scrollingWallEntries[i] = entry != nullptr && entry->wall.scrolling_mode != SCROLLING_MODE_NONE;
+    }
+
+    _scrollingLargeSceneryEntries.assign(MAX_LARGE_SCENERY_OBJECTS, false);
+    for (ObjectEntryIndex i = 0; i < MAX_LARGE_SCENERY_OBJECTS; i++)
+    {
+        auto entry = get_large_scenery_entry(i);
+        _scrollingLargeSceneryEntries[i] = entry != nullptr && entry->large_scenery.scrolling_mode != SCROLLING_MODE_NONE;
+    }
+}
+
+void S6Exporter::ExportTileElements(const TileElement* tileElements)
 {
     for (uint32_t index = 0; index < RCT2_MAX_TILE_ELEMENTS; index++)
     {
-        auto src = &gTileElements[index];
+        auto src = &tileElements[index];
         auto dst = &_s6.tile_elements[index];
         if (src->base_height == MAX_ELEMENT_HEIGHT)
         {
@@ -1427,10 +1507,9 @@ void S6Exporter::ExportTileElements()
                 ExportTileElement(dst, src);
         }
     }
-    _s6.next_free_tile_element_pointer_index = gNextFreeTileElementPointerIndex;
 }
 
-void S6Exporter::ExportTileElement(RCT12TileElement* dst, TileElement* src)
+void S6Exporter::ExportTileElement(RCT12TileElement* dst, const TileElement* src)
 {
     // Todo: allow for changing defition of OpenRCT2 tile element types - replace with a map
     uint8_t tileElementType = src->GetType();
@@ -1508,13 +1587,10 @@ void S6Exporter::ExportTileElement(RCT12TileElement* dst, TileElement* src)
             // Skipping IsHighlighted()
 
             // This has to be done last, since the maze entry shares fields with the colour and sequence fields.
-            auto ride = get_ride(dst2->GetRideIndex());
-            if (ride)
+            auto rideIndex = dst2->GetRideIndex();
+            if (rideIndex < RCT12_MAX_RIDES_IN_PARK && _s6.rides[rideIndex].type == RIDE_TYPE_MAZE)
             {
-                if (ride->type == RIDE_TYPE_MAZE)
-                {
-                    dst2->SetMazeEntry(src2->GetMazeEntry());
-                }
+                dst2->SetMazeEntry(src2->GetMazeEntry());
             }
 
             break;
@@ -1561,8 +1637,8 @@ void S6Exporter::ExportTileElement(RCT12TileElement* dst, TileElement* src)
             dst2->SetAcrossTrack(src2->IsAcrossTrack());
             dst2->SetAnimationIsBackwards(src2->AnimationIsBackwards());
 
-            auto entry = src2->GetEntry();
-            if (entry != nullptr && entry->wall.scrolling_mode != SCROLLING_MODE_NONE)
+            auto entryIndex = src2->GetEntryIndex();
+            if (entryIndex < _scrollingWallEntries.size() && _scrollingWallEntries[entryIndex])
             {
                 auto bannerIndex = src2->GetBannerIndex();
                 if (bannerIndex != BANNER_INDEX_NULL)
@@ -1583,8 +1659,8 @@ void S6Exporter::ExportTileElement(RCT12TileElement* dst, TileElement* src)
             dst2->SetPrimaryColour(src2->GetPrimaryColour());
             dst2->SetSecondaryColour(src2->GetSecondaryColour());
 
-            auto entry = src2->GetEntry();
-            if (entry != nullptr && entry->large_scenery.scrolling_mode != SCROLLING_MODE_NONE)
+            auto entryIndex = src2->GetEntryIndex();
+            if (entryIndex < _scrollingLargeSceneryEntries.size() && _scrollingLargeSceneryEntries[entryIndex])
             {
                 auto bannerIndex = src2->GetBannerIndex();
                 if (bannerIndex != BANNER_INDEX_NULL)
@@ -1676,12 +1752,7 @@ enum : uint32_t
     S6_SAVE_FLAG_AUTOMATIC = 1u << 31,
 };
 
-/**
- *
- *  rct2: 0x006754F5
- * @param flags bit 0: pack objects, 1: save as scenario
- */
-int32_t scenario_save(const utf8* path, int32_t flags)
+static void scenario_begin_save(const utf8* path, int32_t flags)
 {
     if (flags & S6_SAVE_FLAG_SCENARIO)
     {
@@ -1699,33 +1770,69 @@ int32_t scenario_save(const utf8* path, int32_t flags)
 
     map_reorganise_elements();
     viewport_set_saved_view();
+}
+
+/**
+ * Exports the park, the exporter holds everything needed to write the park after that. When background is set the
+ * tile elements and sprites are only copied, S6Exporter::FinishExport must be called before writing.
+ */
+static std::unique_ptr<S6Exporter> scenario_export(int32_t flags, bool background)
+{
+    auto s6exporter = std::make_unique<S6Exporter>();
+    if (flags & S6_SAVE_FLAG_EXPORT)
+    {
+        auto& objManager = OpenRCT2::GetContext()->GetObjectManager();
+        s6exporter->ExportObjectsList = objManager.GetPackableObjects();
+    }
+    s6exporter->RemoveTracklessRides = true;
+    if (background)
+    {
+        s6exporter->BeginExport();
+    }
+    else
+    {
+        s6exporter->Export();
+    }
+    if (!s6exporter->ExportObjectsList.empty())
+    {
+        // Saving in the background must not use the object repository.
+        s6exporter->PackObjects();
+    }
+    return s6exporter;
+}
+
+static void scenario_write(S6Exporter& s6exporter, const utf8* path, int32_t flags)
+{
+    if (flags & S6_SAVE_FLAG_SCENARIO)
+    {
+        s6exporter.SaveScenario(path);
+    }
+    else
+    {
+        s6exporter.SaveGame(path);
+    }
+}
+
+/**
+ *
+ *  rct2: 0x006754F5
+ * @param flags bit 0: pack objects, 1: save as scenario
+ */
+int32_t scenario_save(const utf8* path, int32_t flags)
+{
+    scenario_begin_save(path, flags);
 
     bool result = false;
-    auto s6exporter = new S6Exporter();
     try
     {
-        if (flags & S6_SAVE_FLAG_EXPORT)
-        {
-            auto& objManager = OpenRCT2::GetContext()->GetObjectManager();
-            s6exporter->ExportObjectsList = objManager.GetPackableObjects();
-        }
-        s6exporter->RemoveTracklessRides = true;
-        s6exporter->Export();
-        if (flags & S6_SAVE_FLAG_SCENARIO)
-        {
-            s6exporter->SaveScenario(path);
-        }
-        else
-        {
-            s6exporter->SaveGame(path);
-        }
+        auto s6exporter = scenario_export(flags, false);
+        scenario_write(*s6exporter, path, flags);
         result = true;
     }
     catch (const std::exception& e)
     {
         log_error("Unable to save park: '%s'", e.what());
     }
-    delete s6exporter;
 
     gfx_invalidate_screen();
 
@@ -1735,3 +1842,47 @@ int32_t scenario_save(const utf8* path, int32_t flags)
     }
     return result;
 }
+
+/**
+ * Same as scenario_save but only copies the park state and packs its objects on the calling thread, exporting the tile
+ * elements and sprites, encoding the export and writing it to path is done on a background thread. Only meant for
+ * automatic saves.
+ * @returns a future that becomes true once the file has been written.
+ */
+std::future<bool> scenario_save_in_background(const utf8* path, int32_t flags)
+{
+    scenario_begin_save(path, flags);
+
+    std::shared_ptr<S6Exporter> s6exporter;
+    try
+    {
+        s6exporter = scenario_export(flags, true);
+    }
+    catch (const std::exception& e)
+    {
+        log_error("Unable to save park: '%s'", e.what());
+    }
+
+    gfx_invalidate_screen();
+
+    if (s6exporter == nullptr)
+    {
+        std::promise<bool> failed;
+        failed.set_value(false);
+        return failed.get_future();
+    }
+
+    return std::async(std::launch::async, [s6exporter, pathCopy = std::string(path), flags]() -> bool {
+        try
+        {
+            s6exporter->FinishExport();
+            scenario_write(*s6exporter, pathCopy.c_str(), flags);
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            log_error("Unable to save park: '%s'", e.what());
+            return false;
+        }
+    });
+}
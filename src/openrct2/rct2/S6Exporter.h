@@ -16,6 +16,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
 interface IStream;
@@ -39,10 +40,17 @@ public:
     void SaveScenario(const utf8* path);
     void SaveScenario(IStream* stream);
     void Export();
+    /**
+     * Exports the park like Export, except for the tile elements and sprites which are only copied. FinishExport exports
+     * those from the copies, it does not touch the game state so it can run on another thread while the game continues.
+     */
+    void BeginExport();
+    void FinishExport();
+    void PackObjects();
     void ExportParkName();
     void ExportRides();
     void ExportRide(rct2_ride* dst, const Ride* src);
-    void ExportSprites();
+    void ExportSprites(const rct_sprite* sprites);
     void ExportSprite(RCT2Sprite* dst, const rct_sprite* src);
     void ExportSpriteCommonProperties(RCT12SpriteBase* dst, const SpriteBase* src);
     void ExportSpriteVehicle(RCT2SpriteVehicle* dst, const Vehicle* src);
@@ -53,8 +61,21 @@ public:
 private:
     rct_s6_data _s6{};
     std::vector<std::string> _userStrings;
+    // The objects of ExportObjectsList as written to the file, once they have been packed.
+    std::vector<uint8_t> _packedObjects;
+    bool _objectsPacked = false;
+    // The tile elements and sprites copied by BeginExport.
+    std::vector<TileElement> _tileElements;
+    std::vector<rct_sprite> _sprites;
+    // Everything the tile elements and sprites are exported with that is not part of them, resolved up front so
+    // exporting them does not read the game state.
+    std::unordered_map<uint16_t, rct_string_id> _peepNameStringIds;
+    std::vector<bool> _scrollingWallEntries;
+    std::vector<bool> _scrollingLargeSceneryEntries;
 
     void Save(IStream* stream, bool isScenario);
+    void ExportGameState();
+    void ExportTileElementsAndSprites(const TileElement* tileElements, const rct_sprite* sprites);
     static uint32_t GetLoanHash(money32 initialCash, money32 bankLoan, uint32_t maxBankLoan);
     void ExportResearchedRideTypes();
     void ExportResearchedRideEntries();
@@ -69,8 +90,10 @@ private:
     void ExportBanner(RCT12Banner& dst, const Banner& src);
     void ExportMapAnimations();
 
-    void ExportTileElements();
-    void ExportTileElement(RCT12TileElement* dst, TileElement* src);
+    void ExportScrollingSceneryEntries();
+    void ExportPeepNames();
+    void ExportTileElements(const TileElement* tileElements);
+    void ExportTileElement(RCT12TileElement* dst, const TileElement* src);
 
     std::optional<uint16_t> AllocateUserString(const std::string_view& value);
     void ExportUserStrings();
@@ -15,8 +15,8 @@
 #include "../ParkImporter.h"
 #include "../config/Config.h"
 #include "../core/Console.hpp"
-#include "../core/FileStream.hpp"
 #include "../core/IStream.hpp"
+#include "../core/MappedFileStream.h"
 #include "../core/Path.hpp"
 #include "../core/Random.hpp"
 #include "../core/String.hpp"
@@ -93,7 +93,7 @@ public:
 
     ParkLoadResult LoadSavedGame(const utf8* path, bool skipObjectCheck = false) override
     {
-        auto fs = FileStream(path, FILE_MODE_OPEN);
+        auto fs = MappedFileStream(path);
         auto result = LoadFromStream(&fs, false, skipObjectCheck);
         _s6Path = path;
         return result;
@@ -101,7 +101,7 @@ public:
 
     ParkLoadResult LoadScenario(const utf8* path, bool skipObjectCheck = false) override
     {
-        auto fs = FileStream(path, FILE_MODE_OPEN);
+        auto fs = MappedFileStream(path);
         auto result = LoadFromStream(&fs, true, skipObjectCheck);
         _s6Path = path;
         return result;
@@ -156,24 +156,32 @@ public:
 
         if (isScenario)
         {
-            chunkReader.ReadChunk(&_s6.objects, sizeof(_s6.objects));
-            chunkReader.ReadChunk(&_s6.elapsed_months, 16);
-            chunkReader.ReadChunk(&_s6.tile_elements, sizeof(_s6.tile_elements));
-            chunkReader.ReadChunk(&_s6.next_free_tile_element_pointer_index, 2560076);
-            chunkReader.ReadChunk(&_s6.guests_in_park, 4);
-            chunkReader.ReadChunk(&_s6.last_guests_in_park, 8);
-            chunkReader.ReadChunk(&_s6.park_rating, 2);
-            chunkReader.ReadChunk(&_s6.active_research_types, 1082);
-            chunkReader.ReadChunk(&_s6.current_expenditure, 16);
-            chunkReader.ReadChunk(&_s6.park_value, 4);
-            chunkReader.ReadChunk(&_s6.completed_company_value, 483816);
+            ReadChunks(
+                chunkReader,
+                {
+                    { &_s6.objects, sizeof(_s6.objects) },
+                    { &_s6.elapsed_months, 16 },
+                    { &_s6.tile_elements, sizeof(_s6.tile_elements) },
+                    { &_s6.next_free_tile_element_pointer_index, 2560076 },
+                    { &_s6.guests_in_park, 4 },
+                    { &_s6.last_guests_in_park, 8 },
+                    { &_s6.park_rating, 2 },
+                    { &_s6.active_research_types, 1082 },
+                    { &_s6.current_expenditure, 16 },
+                    { &_s6.park_value, 4 },
+                    { &_s6.completed_company_value, 483816 },
+                });
         }
         else
         {
-            chunkReader.ReadChunk(&_s6.objects, sizeof(_s6.objects));
-            chunkReader.ReadChunk(&_s6.elapsed_months, 16);
-            chunkReader.ReadChunk(&_s6.tile_elements, sizeof(_s6.tile_elements));
-            chunkReader.ReadChunk(&_s6.next_free_tile_element_pointer_index, 3048816);
+            ReadChunks(
+                chunkReader,
+                {
+                    { &_s6.objects, sizeof(_s6.objects) },
+                    { &_s6.elapsed_months, 16 },
+                    { &_s6.tile_elements, sizeof(_s6.tile_elements) },
+                    { &_s6.next_free_tile_element_pointer_index, 3048816 },
+                });
         }
 
         _s6Path = path;
@@ -181,6 +189,24 @@ public:
         return ParkLoadResult(GetRequiredObjects());
     }
 
+    /**
+     * Reads the chunks that follow the packed objects, decoding them in parallel unless that is turned off.
+     */
+    void ReadChunks(SawyerChunkReader& chunkReader, const std::vector<SawyerChunkDestination>& destinations)
+    {
+        if (gConfigGeneral.parallel_park_loading)
+        {
+            chunkReader.ReadChunks(destinations);
+        }
+        else
+        {
+            for (const auto& destination : destinations)
+            {
+                chunkReader.ReadChunk(destination.Data, destination.Length);
+            }
+        }
+    }
+
     bool GetDetails(scenario_index_entry* dst) override
     {
         *dst = {};
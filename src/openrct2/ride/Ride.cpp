@@ -57,6 +57,7 @@
 #include "MusicList.h"
 #include "RideData.h"
 #include "RideGroupManager.h"
+#include "RideReachability.h"
 #include "ShopItem.h"
 #include "Station.h"
 #include "Track.h"
@@ -128,12 +129,12 @@ static void ride_breakdown_status_update(Ride* ride);
 static void ride_breakdown_update(Ride* ride);
 static void ride_call_closest_mechanic(Ride* ride);
 static void ride_call_mechanic(Ride* ride, Peep* mechanic, int32_t forInspection);
-static void ride_entrance_exit_connected(Ride* ride);
+static void ride_entrance_exit_connected(Ride* ride, uint8_t unreachable);
 static int32_t ride_get_new_breakdown_problem(Ride* ride);
 static void ride_inspection_update(Ride* ride);
 static void ride_mechanic_status_update(Ride* ride, int32_t mechanicStatus);
 static void ride_music_update(Ride* ride);
-static void ride_shop_connected(Ride* ride);
+static void ride_shop_connected(Ride* ride, uint8_t unreachable);
 void loc_6DDF9C(Ride* ride, TileElement* tileElement);
 
 RideManager GetRideManager()
@@ -3162,40 +3163,19 @@ void ride_check_all_reachable()
         if (ride.status != RIDE_STATUS_OPEN || ride.connected_message_throttle != 0)
             continue;
 
+        auto unreachable = ride_reachability_get_unreachable(ride);
         if (ride_type_has_flag(ride.type, RIDE_TYPE_FLAG_IS_SHOP))
-            ride_shop_connected(&ride);
+            ride_shop_connected(&ride, unreachable);
         else
-            ride_entrance_exit_connected(&ride);
+            ride_entrance_exit_connected(&ride, unreachable);
     }
 }
 
-/**
- *
- *  rct2: 0x006B7C59
- * @return true if the coordinate is reachable or has no entrance, false otherwise
- */
-static bool ride_entrance_exit_is_reachable(const TileCoordsXYZD& coordinates)
-{
-    if (coordinates.isNull())
-        return true;
-
-    TileCoordsXYZ loc{ coordinates.x, coordinates.y, coordinates.z };
-    loc -= TileDirectionDelta[coordinates.direction];
-
-    return map_coord_is_connected(loc, coordinates.direction);
-}
-
-static void ride_entrance_exit_connected(Ride* ride)
+static void ride_entrance_exit_connected(Ride* ride, uint8_t unreachable)
 {
     for (int32_t i = 0; i < MAX_STATIONS; ++i)
     {
-        auto station_start = ride->stations[i].Start;
-        auto entrance = ride_get_entrance_location(ride, i);
-        auto exit = ride_get_exit_location(ride, i);
-
-        if (station_start.isNull())
-            continue;
-        if (!entrance.isNull() && !ride_entrance_exit_is_reachable(entrance))
+        if (unreachable & ride_reachability_entrance_flag(i))
         {
             // name of ride is parameter of the format string
             ride->FormatNameTo(gCommonFormatArgs);
@@ -3206,7 +3186,7 @@ static void ride_entrance_exit_connected(Ride* ride)
             ride->connected_message_throttle = 3;
         }
 
-        if (!exit.isNull() && !ride_entrance_exit_is_reachable(exit))
+        if (unreachable & ride_reachability_exit_flag(i))
         {
             // name of ride is parameter of the format string
             ride->FormatNameTo(gCommonFormatArgs);
@@ -3219,70 +3199,11 @@ static void ride_entrance_exit_connected(Ride* ride)
     }
 }
 
-static void ride_shop_connected(Ride* ride)
+static void ride_shop_connected(Ride* ride, uint8_t unreachable)
 {
-    auto shopLoc = TileCoordsXY(ride->stations[0].Start);
-    if (shopLoc.isNull())
-        return;
-
-    TrackElement* trackElement = nullptr;
-    TileElement* tileElement = map_get_first_element_at(shopLoc.ToCoordsXY());
-    do
-    {
-        if (tileElement == nullptr)
-            break;
-        if (tileElement->GetType() == TILE_ELEMENT_TYPE_TRACK && tileElement->AsTrack()->GetRideIndex() == ride->id)
-        {
-            trackElement = tileElement->AsTrack();
-            break;
-        }
-    } while (!(tileElement++)->IsLastForTile());
-
-    if (trackElement == nullptr)
+    if (!(unreachable & ride_reachability_entrance_flag(0)))
         return;
 
-    uint8_t entrance_directions = 0;
-    auto track_type = trackElement->GetTrackType();
-    ride = get_ride(trackElement->GetRideIndex());
-    if (ride == nullptr)
-    {
-        return;
-    }
-    if (ride_type_has_flag(ride->type, RIDE_TYPE_FLAG_FLAT_RIDE))
-    {
-        entrance_directions = FlatRideTrackSequenceProperties[track_type][0] & 0xF;
-    }
-    else
-    {
-        entrance_directions = TrackSequenceProperties[track_type][0] & 0xF;
-    }
-
-    uint8_t tile_direction = trackElement->GetDirection();
-    entrance_directions = rol4(entrance_directions, tile_direction);
-
-    // Now each bit in entrance_directions stands for an entrance direction to check
-    if (entrance_directions == 0)
-        return;
-
-    for (auto count = 0; entrance_directions != 0; count++)
-    {
-        if (!(entrance_directions & 1))
-        {
-            entrance_directions >>= 1;
-            continue;
-        }
-        entrance_directions >>= 1;
-
-        // Flip direction north<->south, east<->west
-        uint8_t face_direction = direction_reverse(count);
-
-        int32_t y2 = shopLoc.y - TileDirectionDelta[face_direction].y;
-        int32_t x2 = shopLoc.x - TileDirectionDelta[face_direction].x;
-
-        if (map_coord_is_connected({ x2, y2, tileElement->base_height }, face_direction))
-            return;
-    }
-
     // Name of ride is parameter of the format string
     ride->FormatNameTo(gCommonFormatArgs);
     if (gConfigNotifications.ride_warnings)
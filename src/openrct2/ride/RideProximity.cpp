@@ -0,0 +1,254 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "RideProximity.h"
+
+#include "../world/Map.h"
+#include "Track.h"
+
+#include <algorithm>
+#include <vector>
+
+using RideSet = std::bitset<MAX_RIDES>;
+
+// The rides with track on each tile are combined into blocks of BLOCK_SIZE x BLOCK_SIZE tiles, one block for every
+// tile as its top left corner. Two overlapping blocks per axis cover the whole window around a guest, so a lookup is
+// four ORs no matter how much track there is around. Blocks may start left of or above the map so windows near the
+// edge can be covered as well.
+constexpr int32_t MAP_TILES = MAXIMUM_MAP_SIZE_TECHNICAL;
+constexpr int32_t WINDOW_SIZE = RIDE_PROXIMITY_RADIUS * 2 + 1;
+constexpr int32_t BLOCK_SIZE = 16;
+constexpr int32_t BLOCK_ORIGIN_MIN = -(BLOCK_SIZE - 1);
+constexpr int32_t BLOCK_ORIGINS = MAP_TILES - BLOCK_ORIGIN_MIN;
+static_assert(BLOCK_SIZE <= WINDOW_SIZE && BLOCK_SIZE * 2 >= WINDOW_SIZE, "Two blocks must exactly cover a window");
+static_assert(RIDE_PROXIMITY_RADIUS <= -BLOCK_ORIGIN_MIN, "Windows must not start before the first block");
+
+// Marking more tiles than this between two lookups rebuilds the whole index instead.
+constexpr size_t MAX_DIRTY_TILES = 4096;
+
+static std::vector<RideSet> _tileRides;
+static std::vector<RideSet> _blockRides;
+static std::vector<TileCoordsXY> _dirtyTiles;
+static bool _allDirty = true;
+static bool _trackRemoved;
+
+static RideSet& GetTileRides(int32_t x, int32_t y)
+{
+    return _tileRides[x * MAP_TILES + y];
+}
+
+static RideSet& GetBlockRides(int32_t originX, int32_t originY)
+{
+    return _blockRides[(originX - BLOCK_ORIGIN_MIN) * BLOCK_ORIGINS + (originY - BLOCK_ORIGIN_MIN)];
+}
+
+static RideSet GetRidesWithTrackAt(const CoordsXY& loc)
+{
+    RideSet rides;
+    auto tileElement = map_get_first_element_at(loc);
+    if (tileElement != nullptr)
+    {
+        do
+        {
+            if (tileElement->GetType() == TILE_ELEMENT_TYPE_TRACK)
+            {
+                auto rideIndex = tileElement->AsTrack()->GetRideIndex();
+                if (rideIndex < MAX_RIDES)
+                {
+                    rides[rideIndex] = true;
+                }
+            }
+        } while (!(tileElement++)->IsLastForTile());
+    }
+    return rides;
+}
+
+/**
+ * Recalculates all blocks that include any tile from left, top to right, bottom.
+ */
+static void RebuildBlocks(int32_t left, int32_t top, int32_t right, int32_t bottom)
+{
+    const int32_t originLeft = std::max(left - (BLOCK_SIZE - 1), BLOCK_ORIGIN_MIN);
+    const int32_t originTop = std::max(top - (BLOCK_SIZE - 1), BLOCK_ORIGIN_MIN);
+    const int32_t originRight = std::min(right, MAP_TILES - 1);
+    const int32_t originBottom = std::min(bottom, MAP_TILES - 1);
+    const int32_t rowTop = std::max(originTop, 0);
+    const int32_t rowBottom = std::min(originBottom + BLOCK_SIZE - 1, MAP_TILES - 1);
+    const int32_t numRows = rowBottom - rowTop + 1;
+
+    // First combine the tiles along x for every row, then combine those rows along y.
+    std::vector<RideSet> rows((originRight - originLeft + 1) * numRows);
+    for (int32_t originX = originLeft; originX <= originRight; originX++)
+    {
+        const int32_t tileLeft = std::max(originX, 0);
+        const int32_t tileRight = std::min(originX + BLOCK_SIZE - 1, MAP_TILES - 1);
+        for (int32_t y = rowTop; y <= rowBottom; y++)
+        {
+            auto& row = rows[(originX - originLeft) * numRows + (y - rowTop)];
+            for (int32_t x = tileLeft; x <= tileRight; x++)
+            {
+                row |= GetTileRides(x, y);
+            }
+        }
+    }
+
+    for (int32_t originX = originLeft; originX <= originRight; originX++)
+    {
+        for (int32_t originY = originTop; originY <= originBottom; originY++)
+        {
+            const int32_t tileTop = std::max(originY, 0);
+            const int32_t tileBottom = std::min(originY + BLOCK_SIZE - 1, MAP_TILES - 1);
+            auto& block = GetBlockRides(originX, originY);
+            block.reset();
+            for (int32_t y = tileTop; y <= tileBottom; y++)
+            {
+                block |= rows[(originX - originLeft) * numRows + (y - rowTop)];
+            }
+        }
+    }
+}
+
+void ride_proximity_invalidate_all()
+{
+    _allDirty = true;
+    _trackRemoved = false;
+    _dirtyTiles.clear();
+}
+
+void ride_proximity_invalidate_tile(const CoordsXY& loc)
+{
+    if (_allDirty || !map_is_location_valid(loc))
+        return;
+
+    if (_dirtyTiles.size() >= MAX_DIRTY_TILES)
+    {
+        ride_proximity_invalidate_all();
+        return;
+    }
+    _dirtyTiles.push_back(TileCoordsXY(loc));
+}
+
+/**
+ * Called before an element is removed from its tile. The tile is not known here, but removing track can only clear
+ * tiles that currently have rides on them, so those are all checked on the next update.
+ */
+void ride_proximity_on_element_removed(const TileElement* tileElement)
+{
+    if (tileElement->GetType() == TILE_ELEMENT_TYPE_TRACK)
+    {
+        _trackRemoved = true;
+    }
+}
+
+/**
+ * Brings the index up to date with the map. Lookups do this themselves, but it must be called before looking up
+ * rides from several threads at once.
+ */
+void ride_proximity_update()
+{
+    if (_tileRides.empty())
+    {
+        _tileRides.resize(MAP_TILES * MAP_TILES);
+        _blockRides.resize(BLOCK_ORIGINS * BLOCK_ORIGINS);
+        _allDirty = true;
+    }
+
+    if (_allDirty)
+    {
+        for (int32_t x = 0; x < MAP_TILES; x++)
+        {
+            for (int32_t y = 0; y < MAP_TILES; y++)
+            {
+                GetTileRides(x, y) = GetRidesWithTrackAt(TileCoordsXY{ x, y }.ToCoordsXY());
+            }
+        }
+        RebuildBlocks(0, 0, MAP_TILES - 1, MAP_TILES - 1);
+        _allDirty = false;
+        _trackRemoved = false;
+        _dirtyTiles.clear();
+        return;
+    }
+
+    if (_trackRemoved)
+    {
+        for (int32_t x = 0; x < MAP_TILES; x++)
+        {
+            for (int32_t y = 0; y < MAP_TILES; y++)
+            {
+                if (GetTileRides(x, y).any())
+                {
+                    _dirtyTiles.push_back({ x, y });
+                }
+            }
+        }
+        _trackRemoved = false;
+    }
+
+    if (_dirtyTiles.empty())
+        return;
+
+    int32_t left = MAP_TILES;
+    int32_t top = MAP_TILES;
+    int32_t right = -1;
+    int32_t bottom = -1;
+    for (const auto& tile : _dirtyTiles)
+    {
+        auto rides = GetRidesWithTrackAt(tile.ToCoordsXY());
+        auto& tileRides = GetTileRides(tile.x, tile.y);
+        if (rides != tileRides)
+        {
+            tileRides = rides;
+            left = std::min(left, tile.x);
+            top = std::min(top, tile.y);
+            right = std::max(right, tile.x);
+            bottom = std::max(bottom, tile.y);
+        }
+    }
+    _dirtyTiles.clear();
+
+    if (right >= left)
+    {
+        RebuildBlocks(left, top, right, bottom);
+    }
+}
+
+/**
+ * Gets all rides that have track on any tile at most RIDE_PROXIMITY_RADIUS tiles away from loc on either axis.
+ */
+std::bitset<MAX_RIDES> ride_proximity_get_nearby_rides(const CoordsXY& loc)
+{
+    if (!map_is_location_valid(loc))
+    {
+        // The window may still overlap the map, look at the tiles directly.
+        RideSet rides;
+        const auto centre = loc.ToTileStart();
+        constexpr auto radius = RIDE_PROXIMITY_RADIUS * COORDS_XY_STEP;
+        for (int32_t tileX = centre.x - radius; tileX <= centre.x + radius; tileX += COORDS_XY_STEP)
+        {
+            for (int32_t tileY = centre.y - radius; tileY <= centre.y + radius; tileY += COORDS_XY_STEP)
+            {
+                if (map_is_location_valid({ tileX, tileY }))
+                {
+                    rides |= GetRidesWithTrackAt({ tileX, tileY });
+                }
+            }
+        }
+        return rides;
+    }
+
+    ride_proximity_update();
+
+    const auto tile = TileCoordsXY(loc);
+    const int32_t nearX = tile.x - RIDE_PROXIMITY_RADIUS;
+    const int32_t nearY = tile.y - RIDE_PROXIMITY_RADIUS;
+    const int32_t farX = tile.x + RIDE_PROXIMITY_RADIUS - (BLOCK_SIZE - 1);
+    const int32_t farY = tile.y + RIDE_PROXIMITY_RADIUS - (BLOCK_SIZE - 1);
+    return GetBlockRides(nearX, nearY) | GetBlockRides(farX, nearY) | GetBlockRides(nearX, farY)
+        | GetBlockRides(farX, farY);
+}
@@ -0,0 +1,27 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "../world/Location.hpp"
+#include "Ride.h"
+
+#include <bitset>
+
+struct TileElement;
+
+// Guests take every ride with track within this many tiles of them into consideration.
+constexpr int32_t RIDE_PROXIMITY_RADIUS = 10;
+
+void ride_proximity_invalidate_all();
+void ride_proximity_invalidate_tile(const CoordsXY& loc);
+void ride_proximity_on_element_removed(const TileElement* tileElement);
+void ride_proximity_update();
+std::bitset<MAX_RIDES> ride_proximity_get_nearby_rides(const CoordsXY& loc);
@@ -12,6 +12,7 @@
 #include "../Cheats.h"
 #include "../Context.h"
 #include "../OpenRCT2.h"
+#include "../core/TaskScheduler.h"
 #include "../interface/Window.h"
 #include "../localisation/Date.h"
 #include "../scripting/ScriptEngine.h"
@@ -24,6 +25,7 @@
 #include "Track.h"
 
 #include <algorithm>
+#include <array>
 #include <iterator>
 
 using namespace OpenRCT2;
@@ -76,41 +78,96 @@ struct ShelteredEights
     uint8_t TotalShelteredEighths;
 };
 
-using ride_ratings_calculation = void (*)(Ride* ride);
+// Number of rides rated every tick with the fast ride ratings cheat.
+static constexpr size_t RIDE_RATINGS_FAST_BATCH_SIZE = 16;
+
+using ride_ratings_calculation = void (*)(Ride* ride, RideRatingCalculationData& calcData);
 
 RideRatingCalculationData gRideRatingsCalcData;
 
 static ride_ratings_calculation ride_ratings_get_calculate_func(uint8_t rideType);
 
-static void ride_ratings_update_state();
-static void ride_ratings_update_state_0();
-static void ride_ratings_update_state_1();
-static void ride_ratings_update_state_2();
-static void ride_ratings_update_state_3();
-static void ride_ratings_update_state_4();
-static void ride_ratings_update_state_5();
-static void ride_ratings_begin_proximity_loop();
-static void ride_ratings_calculate(Ride* ride);
+static void ride_ratings_update_state(RideRatingCalculationData& calcData);
+static void ride_ratings_update_state_0(RideRatingCalculationData& calcData);
+static void ride_ratings_update_state_1(RideRatingCalculationData& calcData);
+static void ride_ratings_update_state_2(RideRatingCalculationData& calcData);
+static void ride_ratings_update_state_3(RideRatingCalculationData& calcData);
+static void ride_ratings_update_state_4(RideRatingCalculationData& calcData);
+static void ride_ratings_update_state_5(RideRatingCalculationData& calcData);
+static void ride_ratings_begin_proximity_loop(RideRatingCalculationData& calcData);
+static void ride_ratings_calculate(Ride* ride, RideRatingCalculationData& calcData);
 static void ride_ratings_calculate_value(Ride* ride);
-static void ride_ratings_score_close_proximity(TileElement* inputTileElement);
+static void ride_ratings_score_close_proximity(RideRatingCalculationData& calcData, TileElement* inputTileElement);
 
 static void ride_ratings_add(rating_tuple* rating, int32_t excitement, int32_t intensity, int32_t nausea);
 
 /**
- * This is a small hack function to keep calling the ride rating processor until
- * the given ride's ratings have been calculated. What ever is currently being
- * processed will be overwritten.
- * Only purpose of this function currently is for testing.
+ * Walks the track of the ride in calcData in one go, leaves calcData in the calculate state if the ride can be rated.
+ * Only reads the map, so the track of several rides can be walked at the same time.
+ */
+static void ride_ratings_walk_track(RideRatingCalculationData& calcData)
+{
+    calcData.state = RIDE_RATINGS_STATE_INITIALISE;
+    while (calcData.state != RIDE_RATINGS_STATE_FIND_NEXT_RIDE && calcData.state != RIDE_RATINGS_STATE_CALCULATE)
+    {
+        ride_ratings_update_state(calcData);
+    }
+}
+
+/**
+ * Calculates the ratings of the given ride straight away, the ride being rated over several ticks is left as it is.
  */
 void ride_ratings_update_ride(const Ride& ride)
 {
     if (ride.status != RIDE_STATUS_CLOSED)
     {
-        gRideRatingsCalcData.current_ride = ride.id;
-        gRideRatingsCalcData.state = RIDE_RATINGS_STATE_INITIALISE;
-        while (gRideRatingsCalcData.state != RIDE_RATINGS_STATE_FIND_NEXT_RIDE)
+        RideRatingCalculationData calcData{};
+        calcData.current_ride = ride.id;
+        ride_ratings_walk_track(calcData);
+        if (calcData.state == RIDE_RATINGS_STATE_CALCULATE)
+        {
+            ride_ratings_update_state_3(calcData);
+        }
+    }
+}
+
+/**
+ * Rates the next few open rides every tick instead of walking the track of one ride a piece a tick. The tracks are
+ * walked in parallel, the ratings are then calculated in ride order on this thread as that is what other code sees.
+ */
+static void ride_ratings_update_next_rides()
+{
+    std::array<RideRatingCalculationData, RIDE_RATINGS_FAST_BATCH_SIZE> batch;
+    size_t count = 0;
+
+    // Continue the round robin from where the state machine or the last batch left off.
+    int32_t currentRide = gRideRatingsCalcData.current_ride;
+    for (int32_t i = 0; i < RIDE_ID_NULL && count < batch.size(); i++)
+    {
+        currentRide++;
+        if (currentRide == RIDE_ID_NULL)
+        {
+            currentRide = 0;
+        }
+
+        auto ride = get_ride(currentRide);
+        if (ride != nullptr && ride->status != RIDE_STATUS_CLOSED)
+        {
+            batch[count] = {};
+            batch[count].current_ride = currentRide;
+            count++;
+        }
+    }
+    gRideRatingsCalcData.current_ride = currentRide;
+    gRideRatingsCalcData.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
+
+    TaskScheduler::GetDefault().ParallelFor(0, count, 1, [&batch](size_t i) { ride_ratings_walk_track(batch[i]); });
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (batch[i].state == RIDE_RATINGS_STATE_CALCULATE)
         {
-            ride_ratings_update_state();
+            ride_ratings_update_state_3(batch[i]);
         }
     }
 }
@@ -124,30 +181,36 @@ void ride_ratings_update_all()
     if (gScreenFlags & SCREEN_FLAGS_SCENARIO_EDITOR)
         return;
 
-    ride_ratings_update_state();
+    if (gCheatsFastRideRatings)
+    {
+        ride_ratings_update_next_rides();
+        return;
+    }
+
+    ride_ratings_update_state(gRideRatingsCalcData);
 }
 
-static void ride_ratings_update_state()
+static void ride_ratings_update_state(RideRatingCalculationData& calcData)
 {
-    switch (gRideRatingsCalcData.state)
+    switch (calcData.state)
     {
         case RIDE_RATINGS_STATE_FIND_NEXT_RIDE:
-            ride_ratings_update_state_0();
+            ride_ratings_update_state_0(calcData);
             break;
         case RIDE_RATINGS_STATE_INITIALISE:
-            ride_ratings_update_state_1();
+            ride_ratings_update_state_1(calcData);
             break;
         case RIDE_RATINGS_STATE_2:
-            ride_ratings_update_state_2();
+            ride_ratings_update_state_2(calcData);
             break;
         case RIDE_RATINGS_STATE_CALCULATE:
-            ride_ratings_update_state_3();
+            ride_ratings_update_state_3(calcData);
             break;
         case RIDE_RATINGS_STATE_4:
-            ride_ratings_update_state_4();
+            ride_ratings_update_state_4(calcData);
             break;
         case RIDE_RATINGS_STATE_5:
-            ride_ratings_update_state_5();
+            ride_ratings_update_state_5(calcData);
             break;
     }
 }
@@ -156,9 +219,9 @@ static void ride_ratings_update_state()
  *
  *  rct2: 0x006B5A5C
  */
-static void ride_ratings_update_state_0()
+static void ride_ratings_update_state_0(RideRatingCalculationData& calcData)
 {
-    int32_t currentRide = gRideRatingsCalcData.current_ride;
+    int32_t currentRide = calcData.current_ride;
 
     currentRide++;
     if (currentRide == RIDE_ID_NULL)
@@ -169,51 +232,50 @@ static void ride_ratings_update_state_0()
     auto ride = get_ride(currentRide);
     if (ride != nullptr && ride->status != RIDE_STATUS_CLOSED)
     {
-        gRideRatingsCalcData.state = RIDE_RATINGS_STATE_INITIALISE;
+        calcData.state = RIDE_RATINGS_STATE_INITIALISE;
     }
-    gRideRatingsCalcData.current_ride = currentRide;
+    calcData.current_ride = currentRide;
 }
 
 /**
  *
  *  rct2: 0x006B5A94
  */
-static void ride_ratings_update_state_1()
+static void ride_ratings_update_state_1(RideRatingCalculationData& calcData)
 {
-    gRideRatingsCalcData.proximity_total = 0;
+    calcData.proximity_total = 0;
     for (int32_t i = 0; i < PROXIMITY_COUNT; i++)
     {
-        gRideRatingsCalcData.proximity_scores[i] = 0;
+        calcData.proximity_scores[i] = 0;
     }
-    gRideRatingsCalcData.num_brakes = 0;
-    gRideRatingsCalcData.num_reversers = 0;
-    gRideRatingsCalcData.state = RIDE_RATINGS_STATE_2;
-    gRideRatingsCalcData.station_flags = 0;
-    ride_ratings_begin_proximity_loop();
+    calcData.num_brakes = 0;
+    calcData.num_reversers = 0;
+    calcData.state = RIDE_RATINGS_STATE_2;
+    calcData.station_flags = 0;
+    ride_ratings_begin_proximity_loop(calcData);
 }
 
 /**
  *
  *  rct2: 0x006B5C66
  */
-static void ride_ratings_update_state_2()
+static void ride_ratings_update_state_2(RideRatingCalculationData& calcData)
 {
-    const ride_id_t rideIndex = gRideRatingsCalcData.current_ride;
+    const ride_id_t rideIndex = calcData.current_ride;
     auto ride = get_ride(rideIndex);
     if (ride == nullptr || ride->status == RIDE_STATUS_CLOSED)
     {
-        gRideRatingsCalcData.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
+        calcData.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
         return;
     }
 
-    auto loc = CoordsXYZ{ gRideRatingsCalcData.proximity_x, gRideRatingsCalcData.proximity_y,
-                          gRideRatingsCalcData.proximity_z };
-    int32_t trackType = gRideRatingsCalcData.proximity_track_type;
+    auto loc = CoordsXYZ{ calcData.proximity_x, calcData.proximity_y, calcData.proximity_z };
+    int32_t trackType = calcData.proximity_track_type;
 
     TileElement* tileElement = map_get_first_element_at(loc);
     if (tileElement == nullptr)
     {
-        gRideRatingsCalcData.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
+        calcData.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
         return;
     }
     do
@@ -237,97 +299,96 @@ static void ride_ratings_update_state_2()
             if (trackType == TRACK_ELEM_END_STATION)
             {
                 int32_t entranceIndex = tileElement->AsTrack()->GetStationIndex();
-                gRideRatingsCalcData.station_flags &= ~RIDE_RATING_STATION_FLAG_NO_ENTRANCE;
+                calcData.station_flags &= ~RIDE_RATING_STATION_FLAG_NO_ENTRANCE;
                 if (ride_get_entrance_location(ride, entranceIndex).isNull())
                 {
-                    gRideRatingsCalcData.station_flags |= RIDE_RATING_STATION_FLAG_NO_ENTRANCE;
+                    calcData.station_flags |= RIDE_RATING_STATION_FLAG_NO_ENTRANCE;
                 }
             }
 
-            ride_ratings_score_close_proximity(tileElement);
+            ride_ratings_score_close_proximity(calcData, tileElement);
 
             CoordsXYE trackElement = {
-                /* .x = */ gRideRatingsCalcData.proximity_x,
-                /* .y = */ gRideRatingsCalcData.proximity_y,
+                /* .x = */ calcData.proximity_x,
+                /* .y = */ calcData.proximity_y,
                 /* .element = */ tileElement,
             };
             CoordsXYE nextTrackElement;
             if (!track_block_get_next(&trackElement, &nextTrackElement, nullptr, nullptr))
             {
-                gRideRatingsCalcData.state = RIDE_RATINGS_STATE_4;
+                calcData.state = RIDE_RATINGS_STATE_4;
                 return;
             }
 
             loc = { nextTrackElement, nextTrackElement.element->GetBaseZ() };
             tileElement = nextTrackElement.element;
-            if (loc.x == gRideRatingsCalcData.proximity_start_x && loc.y == gRideRatingsCalcData.proximity_start_y
-                && loc.z == gRideRatingsCalcData.proximity_start_z)
+            if (loc.x == calcData.proximity_start_x && loc.y == calcData.proximity_start_y
+                && loc.z == calcData.proximity_start_z)
             {
-                gRideRatingsCalcData.state = RIDE_RATINGS_STATE_CALCULATE;
+                calcData.state = RIDE_RATINGS_STATE_CALCULATE;
                 return;
             }
-            gRideRatingsCalcData.proximity_x = loc.x;
-            gRideRatingsCalcData.proximity_y = loc.y;
-            gRideRatingsCalcData.proximity_z = loc.z;
-            gRideRatingsCalcData.proximity_track_type = tileElement->AsTrack()->GetTrackType();
+            calcData.proximity_x = loc.x;
+            calcData.proximity_y = loc.y;
+            calcData.proximity_z = loc.z;
+            calcData.proximity_track_type = tileElement->AsTrack()->GetTrackType();
             return;
         }
     } while (!(tileElement++)->IsLastForTile());
 
-    gRideRatingsCalcData.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
+    calcData.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
 }
 
 /**
  *
  *  rct2: 0x006B5E4D
  */
-static void ride_ratings_update_state_3()
+static void ride_ratings_update_state_3(RideRatingCalculationData& calcData)
 {
-    auto ride = get_ride(gRideRatingsCalcData.current_ride);
+    auto ride = get_ride(calcData.current_ride);
     if (ride == nullptr || ride->status == RIDE_STATUS_CLOSED)
     {
-        gRideRatingsCalcData.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
+        calcData.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
         return;
     }
 
-    ride_ratings_calculate(ride);
+    ride_ratings_calculate(ride, calcData);
     ride_ratings_calculate_value(ride);
 
-    window_invalidate_by_number(WC_RIDE, gRideRatingsCalcData.current_ride);
-    gRideRatingsCalcData.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
+    window_invalidate_by_number(WC_RIDE, calcData.current_ride);
+    calcData.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
 }
 
 /**
  *
  *  rct2: 0x006B5BAB
  */
-static void ride_ratings_update_state_4()
+static void ride_ratings_update_state_4(RideRatingCalculationData& calcData)
 {
-    gRideRatingsCalcData.state = RIDE_RATINGS_STATE_5;
-    ride_ratings_begin_proximity_loop();
+    calcData.state = RIDE_RATINGS_STATE_5;
+    ride_ratings_begin_proximity_loop(calcData);
 }
 
 /**
  *
  *  rct2: 0x006B5D72
  */
-static void ride_ratings_update_state_5()
+static void ride_ratings_update_state_5(RideRatingCalculationData& calcData)
 {
-    auto ride = get_ride(gRideRatingsCalcData.current_ride);
+    auto ride = get_ride(calcData.current_ride);
     if (ride == nullptr || ride->status == RIDE_STATUS_CLOSED)
     {
-        gRideRatingsCalcData.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
+        calcData.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
         return;
     }
 
-    auto loc = CoordsXYZ{ gRideRatingsCalcData.proximity_x, gRideRatingsCalcData.proximity_y,
-                          gRideRatingsCalcData.proximity_z };
-    int32_t trackType = gRideRatingsCalcData.proximity_track_type;
+    auto loc = CoordsXYZ{ calcData.proximity_x, calcData.proximity_y, calcData.proximity_z };
+    int32_t trackType = calcData.proximity_track_type;
 
     TileElement* tileElement = map_get_first_element_at(loc);
     if (tileElement == nullptr)
     {
-        gRideRatingsCalcData.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
+        calcData.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
         return;
     }
     do
@@ -347,53 +408,53 @@ static void ride_ratings_update_state_5()
 
         if (trackType == 255 || trackType == tileElement->AsTrack()->GetTrackType())
         {
-            ride_ratings_score_close_proximity(tileElement);
+            ride_ratings_score_close_proximity(calcData, tileElement);
 
-            loc.x = gRideRatingsCalcData.proximity_x;
-            loc.y = gRideRatingsCalcData.proximity_y;
+            loc.x = calcData.proximity_x;
+            loc.y = calcData.proximity_y;
             track_begin_end trackBeginEnd;
             if (!track_block_get_previous({ loc, tileElement }, &trackBeginEnd))
             {
-                gRideRatingsCalcData.state = RIDE_RATINGS_STATE_CALCULATE;
+                calcData.state = RIDE_RATINGS_STATE_CALCULATE;
                 return;
             }
 
             loc.x = trackBeginEnd.begin_x;
             loc.y = trackBeginEnd.begin_y;
             loc.z = trackBeginEnd.begin_z;
-            if (loc.x == gRideRatingsCalcData.proximity_start_x && loc.y == gRideRatingsCalcData.proximity_start_y
-                && loc.z == gRideRatingsCalcData.proximity_start_z)
+            if (loc.x == calcData.proximity_start_x && loc.y == calcData.proximity_start_y
+                && loc.z == calcData.proximity_start_z)
             {
-                gRideRatingsCalcData.state = RIDE_RATINGS_STATE_CALCULATE;
+                calcData.state = RIDE_RATINGS_STATE_CALCULATE;
                 return;
             }
-            gRideRatingsCalcData.proximity_x = loc.x;
-            gRideRatingsCalcData.proximity_y = loc.y;
-            gRideRatingsCalcData.proximity_z = loc.z;
-            gRideRatingsCalcData.proximity_track_type = trackBeginEnd.begin_element->AsTrack()->GetTrackType();
+            calcData.proximity_x = loc.x;
+            calcData.proximity_y = loc.y;
+            calcData.proximity_z = loc.z;
+            calcData.proximity_track_type = trackBeginEnd.begin_element->AsTrack()->GetTrackType();
             return;
         }
     } while (!(tileElement++)->IsLastForTile());
 
-    gRideRatingsCalcData.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
+    calcData.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
 }
 
 /**
  *
  *  rct2: 0x006B5BB2
  */
-static void ride_ratings_begin_proximity_loop()
+static void ride_ratings_begin_proximity_loop(RideRatingCalculationData& calcData)
 {
-    auto ride = get_ride(gRideRatingsCalcData.current_ride);
+    auto ride = get_ride(calcData.current_ride);
     if (ride == nullptr || ride->status == RIDE_STATUS_CLOSED)
     {
-        gRideRatingsCalcData.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
+        calcData.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
         return;
     }
 
     if (ride->type == RIDE_TYPE_MAZE)
     {
-        gRideRatingsCalcData.state = RIDE_RATINGS_STATE_CALCULATE;
+        calcData.state = RIDE_RATINGS_STATE_CALCULATE;
         return;
     }
 
@@ -401,41 +462,42 @@ static void ride_ratings_begin_proximity_loop()
     {
         if (!ride->stations[i].Start.isNull())
         {
-            gRideRatingsCalcData.station_flags &= ~RIDE_RATING_STATION_FLAG_NO_ENTRANCE;
+            calcData.station_flags &= ~RIDE_RATING_STATION_FLAG_NO_ENTRANCE;
             if (ride_get_entrance_location(ride, i).isNull())
             {
-                gRideRatingsCalcData.station_flags |= RIDE_RATING_STATION_FLAG_NO_ENTRANCE;
+                calcData.station_flags |= RIDE_RATING_STATION_FLAG_NO_ENTRANCE;
             }
 
             auto location = ride->stations[i].GetStart();
 
-            gRideRatingsCalcData.proximity_x = location.x;
-            gRideRatingsCalcData.proximity_y = location.y;
-            gRideRatingsCalcData.proximity_z = location.z;
-            gRideRatingsCalcData.proximity_track_type = 255;
-            gRideRatingsCalcData.proximity_start_x = location.x;
-            gRideRatingsCalcData.proximity_start_y = location.y;
-            gRideRatingsCalcData.proximity_start_z = location.z;
+            calcData.proximity_x = location.x;
+            calcData.proximity_y = location.y;
+            calcData.proximity_z = location.z;
+            calcData.proximity_track_type = 255;
+            calcData.proximity_start_x = location.x;
+            calcData.proximity_start_y = location.y;
+            calcData.proximity_start_z = location.z;
             return;
         }
     }
 
-    gRideRatingsCalcData.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
+    calcData.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
 }
 
-static void proximity_score_increment(int32_t type)
+static void proximity_score_increment(RideRatingCalculationData& calcData, int32_t type)
 {
-    gRideRatingsCalcData.proximity_scores[type]++;
+    calcData.proximity_scores[type]++;
 }
 
 /**
  *
  *  rct2: 0x006B6207
  */
-static void ride_ratings_score_close_proximity_in_direction(TileElement* inputTileElement, int32_t direction)
+static void ride_ratings_score_close_proximity_in_direction(
+    RideRatingCalculationData& calcData, TileElement* inputTileElement, int32_t direction)
 {
-    auto scorePos = CoordsXY{ gRideRatingsCalcData.proximity_x + CoordsDirectionDelta[direction].x,
-                              gRideRatingsCalcData.proximity_y + CoordsDirectionDelta[direction].y };
+    auto scorePos = CoordsXY{ calcData.proximity_x + CoordsDirectionDelta[direction].x,
+                              calcData.proximity_y + CoordsDirectionDelta[direction].y };
     if (!map_is_location_valid(scorePos))
         return;
 
@@ -450,18 +512,18 @@ static void ride_ratings_score_close_proximity_in_direction(TileElement* inputTi
         switch (tileElement->GetType())
         {
             case TILE_ELEMENT_TYPE_SURFACE:
-                if (gRideRatingsCalcData.proximity_base_height <= inputTileElement->base_height)
+                if (calcData.proximity_base_height <= inputTileElement->base_height)
                 {
                     if (inputTileElement->clearance_height <= tileElement->base_height)
                     {
-                        proximity_score_increment(PROXIMITY_SURFACE_SIDE_CLOSE);
+                        proximity_score_increment(calcData, PROXIMITY_SURFACE_SIDE_CLOSE);
                     }
                 }
                 break;
             case TILE_ELEMENT_TYPE_PATH:
                 if (abs(inputTileElement->GetBaseZ() - tileElement->GetBaseZ()) <= 2 * COORDS_Z_STEP)
                 {
-                    proximity_score_increment(PROXIMITY_PATH_SIDE_CLOSE);
+                    proximity_score_increment(calcData, PROXIMITY_PATH_SIDE_CLOSE);
                 }
                 break;
             case TILE_ELEMENT_TYPE_TRACK:
@@ -469,7 +531,7 @@ static void ride_ratings_score_close_proximity_in_direction(TileElement* inputTi
                 {
                     if (abs(inputTileElement->GetBaseZ() - tileElement->GetBaseZ()) <= 2 * COORDS_Z_STEP)
                     {
-                        proximity_score_increment(PROXIMITY_FOREIGN_TRACK_SIDE_CLOSE);
+                        proximity_score_increment(calcData, PROXIMITY_FOREIGN_TRACK_SIDE_CLOSE);
                     }
                 }
                 break;
@@ -479,11 +541,11 @@ static void ride_ratings_score_close_proximity_in_direction(TileElement* inputTi
                 {
                     if (inputTileElement->GetBaseZ() > tileElement->GetClearanceZ())
                     {
-                        proximity_score_increment(PROXIMITY_SCENERY_SIDE_ABOVE);
+                        proximity_score_increment(calcData, PROXIMITY_SCENERY_SIDE_ABOVE);
                     }
                     else
                     {
-                        proximity_score_increment(PROXIMITY_SCENERY_SIDE_BELOW);
+                        proximity_score_increment(calcData, PROXIMITY_SCENERY_SIDE_BELOW);
                     }
                 }
                 break;
@@ -491,7 +553,8 @@ static void ride_ratings_score_close_proximity_in_direction(TileElement* inputTi
     } while (!(tileElement++)->IsLastForTile());
 }
 
-static void ride_ratings_score_close_proximity_loops_helper(TileElement* inputTileElement, int32_t x, int32_t y)
+static void ride_ratings_score_close_proximity_loops_helper(
+    RideRatingCalculationData& calcData, TileElement* inputTileElement, int32_t x, int32_t y)
 {
     TileElement* tileElement = map_get_first_element_at({ x, y });
     if (tileElement == nullptr)
@@ -509,7 +572,7 @@ static void ride_ratings_score_close_proximity_loops_helper(TileElement* inputTi
                     - static_cast<int32_t>(inputTileElement->base_height);
                 if (zDiff >= 0 && zDiff <= 16)
                 {
-                    proximity_score_increment(PROXIMITY_PATH_TROUGH_VERTICAL_LOOP);
+                    proximity_score_increment(calcData, PROXIMITY_PATH_TROUGH_VERTICAL_LOOP);
                 }
             }
             break;
@@ -523,11 +586,11 @@ static void ride_ratings_score_close_proximity_loops_helper(TileElement* inputTi
                         - static_cast<int32_t>(inputTileElement->base_height);
                     if (zDiff >= 0 && zDiff <= 16)
                     {
-                        proximity_score_increment(PROXIMITY_TRACK_THROUGH_VERTICAL_LOOP);
+                        proximity_score_increment(calcData, PROXIMITY_TRACK_THROUGH_VERTICAL_LOOP);
                         if (tileElement->AsTrack()->GetTrackType() == TRACK_ELEM_LEFT_VERTICAL_LOOP
                             || tileElement->AsTrack()->GetTrackType() == TRACK_ELEM_RIGHT_VERTICAL_LOOP)
                         {
-                            proximity_score_increment(PROXIMITY_INTERSECTING_VERTICAL_LOOP);
+                            proximity_score_increment(calcData, PROXIMITY_INTERSECTING_VERTICAL_LOOP);
                         }
                     }
                 }
@@ -541,19 +604,19 @@ static void ride_ratings_score_close_proximity_loops_helper(TileElement* inputTi
  *
  *  rct2: 0x006B62DA
  */
-static void ride_ratings_score_close_proximity_loops(TileElement* inputTileElement)
+static void ride_ratings_score_close_proximity_loops(RideRatingCalculationData& calcData, TileElement* inputTileElement)
 {
     int32_t trackType = inputTileElement->AsTrack()->GetTrackType();
     if (trackType == TRACK_ELEM_LEFT_VERTICAL_LOOP || trackType == TRACK_ELEM_RIGHT_VERTICAL_LOOP)
     {
-        int32_t x = gRideRatingsCalcData.proximity_x;
-        int32_t y = gRideRatingsCalcData.proximity_y;
-        ride_ratings_score_close_proximity_loops_helper(inputTileElement, x, y);
+        int32_t x = calcData.proximity_x;
+        int32_t y = calcData.proximity_y;
+        ride_ratings_score_close_proximity_loops_helper(calcData, inputTileElement, x, y);
 
         int32_t direction = inputTileElement->GetDirection();
-        x = gRideRatingsCalcData.proximity_x + CoordsDirectionDelta[direction].x;
-        y = gRideRatingsCalcData.proximity_y + CoordsDirectionDelta[direction].y;
-        ride_ratings_score_close_proximity_loops_helper(inputTileElement, x, y);
+        x = calcData.proximity_x + CoordsDirectionDelta[direction].x;
+        y = calcData.proximity_y + CoordsDirectionDelta[direction].y;
+        ride_ratings_score_close_proximity_loops_helper(calcData, inputTileElement, x, y);
     }
 }
 
@@ -561,16 +624,16 @@ static void ride_ratings_score_close_proximity_loops(TileElement* inputTileEleme
  *
  *  rct2: 0x006B5F9D
  */
-static void ride_ratings_score_close_proximity(TileElement* inputTileElement)
+static void ride_ratings_score_close_proximity(RideRatingCalculationData& calcData, TileElement* inputTileElement)
 {
-    if (gRideRatingsCalcData.station_flags & RIDE_RATING_STATION_FLAG_NO_ENTRANCE)
+    if (calcData.station_flags & RIDE_RATING_STATION_FLAG_NO_ENTRANCE)
     {
         return;
     }
 
-    gRideRatingsCalcData.proximity_total++;
-    int32_t x = gRideRatingsCalcData.proximity_x;
-    int32_t y = gRideRatingsCalcData.proximity_y;
+    calcData.proximity_total++;
+    int32_t x = calcData.proximity_x;
+    int32_t y = calcData.proximity_y;
     TileElement* tileElement = map_get_first_element_at({ x, y });
     if (tileElement == nullptr)
         return;
@@ -583,31 +646,31 @@ static void ride_ratings_score_close_proximity(TileElement* inputTileElement)
         switch (tileElement->GetType())
         {
             case TILE_ELEMENT_TYPE_SURFACE:
-                gRideRatingsCalcData.proximity_base_height = tileElement->base_height;
-                if (tileElement->GetBaseZ() == gRideRatingsCalcData.proximity_z)
+                calcData.proximity_base_height = tileElement->base_height;
+                if (tileElement->GetBaseZ() == calcData.proximity_z)
                 {
-                    proximity_score_increment(PROXIMITY_SURFACE_TOUCH);
+                    proximity_score_increment(calcData, PROXIMITY_SURFACE_TOUCH);
                 }
                 waterHeight = tileElement->AsSurface()->GetWaterHeight();
                 if (waterHeight != 0)
                 {
                     auto z = waterHeight;
-                    if (z <= gRideRatingsCalcData.proximity_z)
+                    if (z <= calcData.proximity_z)
                     {
-                        proximity_score_increment(PROXIMITY_WATER_OVER);
-                        if (z == gRideRatingsCalcData.proximity_z)
+                        proximity_score_increment(calcData, PROXIMITY_WATER_OVER);
+                        if (z == calcData.proximity_z)
                         {
-                            proximity_score_increment(PROXIMITY_WATER_TOUCH);
+                            proximity_score_increment(calcData, PROXIMITY_WATER_TOUCH);
                         }
                         z += 16;
-                        if (z == gRideRatingsCalcData.proximity_z)
+                        if (z == calcData.proximity_z)
                         {
-                            proximity_score_increment(PROXIMITY_WATER_LOW);
+                            proximity_score_increment(calcData, PROXIMITY_WATER_LOW);
                         }
                         z += 112;
-                        if (z <= gRideRatingsCalcData.proximity_z)
+                        if (z <= calcData.proximity_z)
                         {
-                            proximity_score_increment(PROXIMITY_WATER_HIGH);
+                            proximity_score_increment(calcData, PROXIMITY_WATER_HIGH);
                         }
                     }
                 }
@@ -618,11 +681,11 @@ static void ride_ratings_score_close_proximity(TileElement* inputTileElement)
                 {
                     if (tileElement->GetClearanceZ() == inputTileElement->GetBaseZ())
                     {
-                        proximity_score_increment(PROXIMITY_PATH_TOUCH_ABOVE);
+                        proximity_score_increment(calcData, PROXIMITY_PATH_TOUCH_ABOVE);
                     }
                     if (tileElement->GetBaseZ() == inputTileElement->GetClearanceZ())
                     {
-                        proximity_score_increment(PROXIMITY_PATH_TOUCH_UNDER);
+                        proximity_score_increment(calcData, PROXIMITY_PATH_TOUCH_UNDER);
                     }
                 }
                 else
@@ -630,15 +693,15 @@ static void ride_ratings_score_close_proximity(TileElement* inputTileElement)
                     // Bonus for path in first object entry
                     if (tileElement->GetClearanceZ() <= inputTileElement->GetBaseZ())
                     {
-                        proximity_score_increment(PROXIMITY_PATH_ZERO_OVER);
+                        proximity_score_increment(calcData, PROXIMITY_PATH_ZERO_OVER);
                     }
                     if (tileElement->GetClearanceZ() == inputTileElement->GetBaseZ())
                     {
-                        proximity_score_increment(PROXIMITY_PATH_ZERO_TOUCH_ABOVE);
+                        proximity_score_increment(calcData, PROXIMITY_PATH_ZERO_TOUCH_ABOVE);
                     }
                     if (tileElement->GetBaseZ() == inputTileElement->GetClearanceZ())
                     {
-                        proximity_score_increment(PROXIMITY_PATH_ZERO_TOUCH_UNDER);
+                        proximity_score_increment(calcData, PROXIMITY_PATH_ZERO_TOUCH_UNDER);
                     }
                 }
                 break;
@@ -652,33 +715,33 @@ static void ride_ratings_score_close_proximity(TileElement* inputTileElement)
                     {
                         if (tileElement->base_height - inputTileElement->clearance_height <= 10)
                         {
-                            proximity_score_increment(PROXIMITY_THROUGH_VERTICAL_LOOP);
+                            proximity_score_increment(calcData, PROXIMITY_THROUGH_VERTICAL_LOOP);
                         }
                     }
                 }
                 if (inputTileElement->AsTrack()->GetRideIndex() != tileElement->AsTrack()->GetRideIndex())
                 {
-                    proximity_score_increment(PROXIMITY_FOREIGN_TRACK_ABOVE_OR_BELOW);
+                    proximity_score_increment(calcData, PROXIMITY_FOREIGN_TRACK_ABOVE_OR_BELOW);
                     if (tileElement->GetClearanceZ() == inputTileElement->GetBaseZ())
                     {
-                        proximity_score_increment(PROXIMITY_FOREIGN_TRACK_TOUCH_ABOVE);
+                        proximity_score_increment(calcData, PROXIMITY_FOREIGN_TRACK_TOUCH_ABOVE);
                     }
                     if (tileElement->clearance_height + 2 <= inputTileElement->base_height)
                     {
                         if (tileElement->clearance_height + 10 >= inputTileElement->base_height)
                         {
-                            proximity_score_increment(PROXIMITY_FOREIGN_TRACK_CLOSE_ABOVE);
+                            proximity_score_increment(calcData, PROXIMITY_FOREIGN_TRACK_CLOSE_ABOVE);
                         }
                     }
                     if (inputTileElement->clearance_height == tileElement->base_height)
                     {
-                        proximity_score_increment(PROXIMITY_FOREIGN_TRACK_TOUCH_ABOVE);
+                        proximity_score_increment(calcData, PROXIMITY_FOREIGN_TRACK_TOUCH_ABOVE);
                     }
                     if (inputTileElement->clearance_height + 2 == tileElement->base_height)
                     {
                         if (static_cast<uint8_t>(inputTileElement->clearance_height + 10) >= tileElement->base_height)
                         {
-                            proximity_score_increment(PROXIMITY_FOREIGN_TRACK_CLOSE_ABOVE);
+                            proximity_score_increment(calcData, PROXIMITY_FOREIGN_TRACK_CLOSE_ABOVE);
                         }
                     }
                 }
@@ -687,40 +750,40 @@ static void ride_ratings_score_close_proximity(TileElement* inputTileElement)
                     bool isStation = tileElement->AsTrack()->IsStation();
                     if (tileElement->clearance_height == inputTileElement->base_height)
                     {
-                        proximity_score_increment(PROXIMITY_OWN_TRACK_TOUCH_ABOVE);
+                        proximity_score_increment(calcData, PROXIMITY_OWN_TRACK_TOUCH_ABOVE);
                         if (isStation)
                         {
-                            proximity_score_increment(PROXIMITY_OWN_STATION_TOUCH_ABOVE);
+                            proximity_score_increment(calcData, PROXIMITY_OWN_STATION_TOUCH_ABOVE);
                         }
                     }
                     if (tileElement->clearance_height + 2 <= inputTileElement->base_height)
                     {
                         if (tileElement->clearance_height + 10 >= inputTileElement->base_height)
                         {
-                            proximity_score_increment(PROXIMITY_OWN_TRACK_CLOSE_ABOVE);
+                            proximity_score_increment(calcData, PROXIMITY_OWN_TRACK_CLOSE_ABOVE);
                             if (isStation)
                             {
-                                proximity_score_increment(PROXIMITY_OWN_STATION_CLOSE_ABOVE);
+                                proximity_score_increment(calcData, PROXIMITY_OWN_STATION_CLOSE_ABOVE);
                             }
                         }
                     }
 
                     if (inputTileElement->GetClearanceZ() == tileElement->GetBaseZ())
                     {
-                        proximity_score_increment(PROXIMITY_OWN_TRACK_TOUCH_ABOVE);
+                        proximity_score_increment(calcData, PROXIMITY_OWN_TRACK_TOUCH_ABOVE);
                         if (isStation)
                         {
-                            proximity_score_increment(PROXIMITY_OWN_STATION_TOUCH_ABOVE);
+                            proximity_score_increment(calcData, PROXIMITY_OWN_STATION_TOUCH_ABOVE);
                         }
                     }
                     if (inputTileElement->clearance_height + 2 <= tileElement->base_height)
                     {
                         if (inputTileElement->clearance_height + 10 >= tileElement->base_height)
                         {
-                            proximity_score_increment(PROXIMITY_OWN_TRACK_CLOSE_ABOVE);
+                            proximity_score_increment(calcData, PROXIMITY_OWN_TRACK_CLOSE_ABOVE);
                             if (isStation)
                             {
-                                proximity_score_increment(PROXIMITY_OWN_STATION_CLOSE_ABOVE);
+                                proximity_score_increment(calcData, PROXIMITY_OWN_STATION_CLOSE_ABOVE);
                             }
                         }
                     }
@@ -731,28 +794,28 @@ static void ride_ratings_score_close_proximity(TileElement* inputTileElement)
     } while (!(tileElement++)->IsLastForTile());
 
     uint8_t direction = inputTileElement->GetDirection();
-    ride_ratings_score_close_proximity_in_direction(inputTileElement, (direction + 1) & 3);
-    ride_ratings_score_close_proximity_in_direction(inputTileElement, (direction - 1) & 3);
-    ride_ratings_score_close_proximity_loops(inputTileElement);
+    ride_ratings_score_close_proximity_in_direction(calcData, inputTileElement, (direction + 1) & 3);
+    ride_ratings_score_close_proximity_in_direction(calcData, inputTileElement, (direction - 1) & 3);
+    ride_ratings_score_close_proximity_loops(calcData, inputTileElement);
 
-    switch (gRideRatingsCalcData.proximity_track_type)
+    switch (calcData.proximity_track_type)
     {
         case TRACK_ELEM_BRAKES:
-            gRideRatingsCalcData.num_brakes++;
+            calcData.num_brakes++;
             break;
         case TRACK_ELEM_LEFT_REVERSER:
         case TRACK_ELEM_RIGHT_REVERSER:
-            gRideRatingsCalcData.num_reversers++;
+            calcData.num_reversers++;
             break;
     }
 }
 
-static void ride_ratings_calculate(Ride* ride)
+static void ride_ratings_calculate(Ride* ride, RideRatingCalculationData& calcData)
 {
     auto calcFunc = ride_ratings_get_calculate_func(ride->type);
     if (calcFunc != nullptr)
     {
-        calcFunc(ride);
+        calcFunc(ride, calcData);
     }
 
 #ifdef ORIGINAL_RATINGS
@@ -893,7 +956,7 @@ static void ride_ratings_calculate_value(Ride* ride)
  * inputs
  * - edi: ride ptr
  */
-static uint16_t ride_compute_upkeep(Ride* ride)
+static uint16_t ride_compute_upkeep(Ride* ride, const RideRatingCalculationData& calcData)
 {
     // data stored at 0x0057E3A8, incrementing 18 bytes at a time
     uint16_t upkeep = RideTypeDescriptors[ride->type].UpkeepCosts.BaseCost;
@@ -929,10 +992,10 @@ static uint16_t ride_compute_upkeep(Ride* ride)
     {
         reverserMaintenanceCost = 10;
     }
-    upkeep += reverserMaintenanceCost * gRideRatingsCalcData.num_reversers;
+    upkeep += reverserMaintenanceCost * calcData.num_reversers;
 
     // Add maintenance cost for brake track pieces
-    upkeep += 20 * gRideRatingsCalcData.num_brakes;
+    upkeep += 20 * calcData.num_brakes;
 
     // these seem to be adhoc adjustments to a ride's upkeep/cost, times
     // various variables set on the ride itself.
@@ -1085,9 +1148,9 @@ static uint32_t get_proximity_score_helper_3(uint16_t x, uint16_t resultIfNotZer
  *
  *  rct2: 0x0065E277
  */
-static uint32_t ride_ratings_get_proximity_score()
+static uint32_t ride_ratings_get_proximity_score(const RideRatingCalculationData& calcData)
 {
-    const uint16_t* scores = gRideRatingsCalcData.proximity_scores;
+    const uint16_t* scores = calcData.proximity_scores;
 
     uint32_t result = 0;
     result += get_proximity_score_helper_1(scores[PROXIMITY_WATER_OVER], 60, 0x00AAAA);
@@ -1618,9 +1681,10 @@ static void ride_ratings_apply_rotations(
         ride->rotations * nauseaMultiplier);
 }
 
-static void ride_ratings_apply_proximity(rating_tuple* ratings, int32_t excitementMultiplier)
+static void ride_ratings_apply_proximity(
+    const RideRatingCalculationData& calcData, rating_tuple* ratings, int32_t excitementMultiplier)
 {
-    ride_ratings_add(ratings, (ride_ratings_get_proximity_score() * excitementMultiplier) >> 16, 0, 0);
+    ride_ratings_add(ratings, (ride_ratings_get_proximity_score(calcData) * excitementMultiplier) >> 16, 0, 0);
 }
 
 static void ride_ratings_apply_scenery(rating_tuple* ratings, Ride* ride, int32_t excitementMultiplier)
@@ -1745,7 +1809,7 @@ static void ride_ratings_apply_first_length_penalty(
 
 #pragma region Ride rating calculation functions
 
-static void ride_ratings_calculate_spiral_roller_coaster(Ride* ride)
+static void ride_ratings_calculate_spiral_roller_coaster(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -1765,7 +1829,7 @@ static void ride_ratings_calculate_spiral_roller_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 28235, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 43690, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(calcData, &ratings, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 6693);
 
     if (ride->inversions == 0)
@@ -1785,13 +1849,13 @@ static void ride_ratings_calculate_spiral_roller_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_stand_up_roller_coaster(Ride* ride)
+static void ride_ratings_calculate_stand_up_roller_coaster(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -1811,7 +1875,7 @@ static void ride_ratings_calculate_stand_up_roller_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 34952, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 12850, 28398, 30427);
-    ride_ratings_apply_proximity(&ratings, 17893);
+    ride_ratings_apply_proximity(calcData, &ratings, 17893);
     ride_ratings_apply_scenery(&ratings, ride, 5577);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 12, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0xA0000, 2, 2, 2);
@@ -1823,13 +1887,13 @@ static void ride_ratings_calculate_stand_up_roller_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_suspended_swinging_coaster(Ride* ride)
+static void ride_ratings_calculate_suspended_swinging_coaster(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -1849,7 +1913,7 @@ static void ride_ratings_calculate_suspended_swinging_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 48036);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(calcData, &ratings, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 6971);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 8, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0xC0000, 2, 2, 2);
@@ -1863,13 +1927,13 @@ static void ride_ratings_calculate_suspended_swinging_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_inverted_roller_coaster(Ride* ride)
+static void ride_ratings_calculate_inverted_roller_coaster(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -1889,7 +1953,7 @@ static void ride_ratings_calculate_inverted_roller_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 29552, 57186);
     ride_ratings_apply_drops(&ratings, ride, 29127, 39009, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 15291, 35108);
-    ride_ratings_apply_proximity(&ratings, 15657);
+    ride_ratings_apply_proximity(calcData, &ratings, 15657);
     ride_ratings_apply_scenery(&ratings, ride, 8366);
 
     if (ride->inversions == 0)
@@ -1906,13 +1970,13 @@ static void ride_ratings_calculate_inverted_roller_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_junior_roller_coaster(Ride* ride)
+static void ride_ratings_calculate_junior_roller_coaster(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -1932,7 +1996,7 @@ static void ride_ratings_calculate_junior_roller_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 25700, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(calcData, &ratings, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 9760);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 6, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0x70000, 2, 2, 2);
@@ -1944,13 +2008,13 @@ static void ride_ratings_calculate_junior_roller_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_miniature_railway(Ride* ride)
+static void ride_ratings_calculate_miniature_railway(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -1966,7 +2030,7 @@ static void ride_ratings_calculate_miniature_railway(Ride* ride)
     ride_ratings_apply_average_speed(&ratings, ride, 291271, 436906);
     ride_ratings_apply_duration(&ratings, ride, 150, 26214);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, -6425, 6553, 23405);
-    ride_ratings_apply_proximity(&ratings, 8946);
+    ride_ratings_apply_proximity(calcData, &ratings, 8946);
     ride_ratings_apply_scenery(&ratings, ride, 20915);
     ride_ratings_apply_first_length_penalty(&ratings, ride, 0xC80000, 2, 2, 2);
 
@@ -1975,7 +2039,7 @@ static void ride_ratings_calculate_miniature_railway(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     auto shelteredEighths = get_num_of_sheltered_eighths(ride);
@@ -1985,7 +2049,7 @@ static void ride_ratings_calculate_miniature_railway(Ride* ride)
     ride->sheltered_eighths = shelteredEighths.TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_monorail(Ride* ride)
+static void ride_ratings_calculate_monorail(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2001,7 +2065,7 @@ static void ride_ratings_calculate_monorail(Ride* ride)
     ride_ratings_apply_average_speed(&ratings, ride, 291271, 218453);
     ride_ratings_apply_duration(&ratings, ride, 150, 21845);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 5140, 6553, 18724);
-    ride_ratings_apply_proximity(&ratings, 8946);
+    ride_ratings_apply_proximity(calcData, &ratings, 8946);
     ride_ratings_apply_scenery(&ratings, ride, 16732);
     ride_ratings_apply_first_length_penalty(&ratings, ride, 0xAA0000, 2, 2, 2);
 
@@ -2010,7 +2074,7 @@ static void ride_ratings_calculate_monorail(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     auto shelteredEighths = get_num_of_sheltered_eighths(ride);
@@ -2020,7 +2084,7 @@ static void ride_ratings_calculate_monorail(Ride* ride)
     ride->sheltered_eighths = shelteredEighths.TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_mini_suspended_coaster(Ride* ride)
+static void ride_ratings_calculate_mini_suspended_coaster(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2040,7 +2104,7 @@ static void ride_ratings_calculate_mini_suspended_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 34179, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 58254, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 19275, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(calcData, &ratings, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 13943);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 6, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0x80000, 2, 2, 2);
@@ -2053,13 +2117,13 @@ static void ride_ratings_calculate_mini_suspended_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_boat_hire(Ride* ride)
+static void ride_ratings_calculate_boat_hire(Ride* ride, RideRatingCalculationData& calcData)
 {
     ride->unreliability_factor = 7;
     set_unreliability_factor(ride);
@@ -2077,7 +2141,7 @@ static void ride_ratings_calculate_boat_hire(Ride* ride)
         ride_ratings_add(&ratings, RIDE_RATING(0, 20), 0, 0);
     }
 
-    ride_ratings_apply_proximity(&ratings, 11183);
+    ride_ratings_apply_proximity(calcData, &ratings, 11183);
     ride_ratings_apply_scenery(&ratings, ride, 22310);
 
     ride_ratings_apply_intensity_penalty(&ratings);
@@ -2085,13 +2149,13 @@ static void ride_ratings_calculate_boat_hire(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 0;
 }
 
-static void ride_ratings_calculate_wooden_wild_mouse(Ride* ride)
+static void ride_ratings_calculate_wooden_wild_mouse(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2111,7 +2175,7 @@ static void ride_ratings_calculate_wooden_wild_mouse(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 29721, 43458, 45749);
     ride_ratings_apply_drops(&ratings, ride, 40777, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 16705, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 17893);
+    ride_ratings_apply_proximity(calcData, &ratings, 17893);
     ride_ratings_apply_scenery(&ratings, ride, 5577);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 8, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0x70000, 2, 2, 2);
@@ -2126,13 +2190,13 @@ static void ride_ratings_calculate_wooden_wild_mouse(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_steeplechase(Ride* ride)
+static void ride_ratings_calculate_steeplechase(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2152,7 +2216,7 @@ static void ride_ratings_calculate_steeplechase(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 25700, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(calcData, &ratings, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 9760);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 4, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0x80000, 2, 2, 2);
@@ -2166,13 +2230,13 @@ static void ride_ratings_calculate_steeplechase(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_car_ride(Ride* ride)
+static void ride_ratings_calculate_car_ride(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2191,7 +2255,7 @@ static void ride_ratings_calculate_car_ride(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 14860, 0, 11437);
     ride_ratings_apply_drops(&ratings, ride, 8738, 0, 0);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 12850, 6553, 4681);
-    ride_ratings_apply_proximity(&ratings, 11183);
+    ride_ratings_apply_proximity(calcData, &ratings, 11183);
     ride_ratings_apply_scenery(&ratings, ride, 8366);
     ride_ratings_apply_first_length_penalty(&ratings, ride, 0xC80000, 8, 2, 2);
 
@@ -2200,13 +2264,13 @@ static void ride_ratings_calculate_car_ride(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_launched_freefall(Ride* ride)
+static void ride_ratings_calculate_launched_freefall(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2243,7 +2307,7 @@ static void ride_ratings_calculate_launched_freefall(Ride* ride)
     }
 #endif
 
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(calcData, &ratings, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 25098);
 
     ride_ratings_apply_intensity_penalty(&ratings);
@@ -2251,13 +2315,13 @@ static void ride_ratings_calculate_launched_freefall(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_bobsleigh_coaster(Ride* ride)
+static void ride_ratings_calculate_bobsleigh_coaster(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2277,7 +2341,7 @@ static void ride_ratings_calculate_bobsleigh_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(calcData, &ratings, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 5577);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0xC0000, 2, 2, 2);
     ride_ratings_apply_max_lateral_g_penalty(&ratings, ride, FIXED_2DP(1, 20), 2, 2, 2);
@@ -2289,13 +2353,13 @@ static void ride_ratings_calculate_bobsleigh_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_observation_tower(Ride* ride)
+static void ride_ratings_calculate_observation_tower(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2307,7 +2371,7 @@ static void ride_ratings_calculate_observation_tower(Ride* ride)
     ride_ratings_set(&ratings, RIDE_RATING(1, 50), RIDE_RATING(0, 00), RIDE_RATING(0, 10));
     ride_ratings_add(
         &ratings, ((ride_get_total_length(ride) >> 16) * 45875) >> 16, 0, ((ride_get_total_length(ride) >> 16) * 26214) >> 16);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(calcData, &ratings, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 83662);
 
     ride_ratings_apply_intensity_penalty(&ratings);
@@ -2315,7 +2379,7 @@ static void ride_ratings_calculate_observation_tower(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 7;
@@ -2325,7 +2389,7 @@ static void ride_ratings_calculate_observation_tower(Ride* ride)
         ride->excitement /= 4;
 }
 
-static void ride_ratings_calculate_looping_roller_coaster(Ride* ride)
+static void ride_ratings_calculate_looping_roller_coaster(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2345,7 +2409,7 @@ static void ride_ratings_calculate_looping_roller_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(calcData, &ratings, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 6693);
 
     if (ride->inversions == 0)
@@ -2365,13 +2429,13 @@ static void ride_ratings_calculate_looping_roller_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_dinghy_slide(Ride* ride)
+static void ride_ratings_calculate_dinghy_slide(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2391,7 +2455,7 @@ static void ride_ratings_calculate_dinghy_slide(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 11183);
+    ride_ratings_apply_proximity(calcData, &ratings, 11183);
     ride_ratings_apply_scenery(&ratings, ride, 5577);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 12, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0x70000, 2, 2, 2);
@@ -2403,13 +2467,13 @@ static void ride_ratings_calculate_dinghy_slide(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_mine_train_coaster(Ride* ride)
+static void ride_ratings_calculate_mine_train_coaster(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2429,7 +2493,7 @@ static void ride_ratings_calculate_mine_train_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 29721, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 19275, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 21472);
+    ride_ratings_apply_proximity(calcData, &ratings, 21472);
     ride_ratings_apply_scenery(&ratings, ride, 16732);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 8, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0xA0000, 2, 2, 2);
@@ -2443,13 +2507,13 @@ static void ride_ratings_calculate_mine_train_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_chairlift(Ride* ride)
+static void ride_ratings_calculate_chairlift(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2466,7 +2530,7 @@ static void ride_ratings_calculate_chairlift(Ride* ride)
     ride_ratings_apply_duration(&ratings, ride, 150, 26214);
     ride_ratings_apply_turns(&ratings, ride, 7430, 3476, 4574);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, -19275, 21845, 23405);
-    ride_ratings_apply_proximity(&ratings, 11183);
+    ride_ratings_apply_proximity(calcData, &ratings, 11183);
     ride_ratings_apply_scenery(&ratings, ride, 25098);
     ride_ratings_apply_first_length_penalty(&ratings, ride, 0x960000, 2, 2, 2);
 
@@ -2481,7 +2545,7 @@ static void ride_ratings_calculate_chairlift(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     auto shelteredEighths = get_num_of_sheltered_eighths(ride);
@@ -2491,7 +2555,7 @@ static void ride_ratings_calculate_chairlift(Ride* ride)
     ride->sheltered_eighths = shelteredEighths.TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_corkscrew_roller_coaster(Ride* ride)
+static void ride_ratings_calculate_corkscrew_roller_coaster(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2511,7 +2575,7 @@ static void ride_ratings_calculate_corkscrew_roller_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(calcData, &ratings, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 6693);
 
     if (ride->inversions == 0)
@@ -2531,13 +2595,13 @@ static void ride_ratings_calculate_corkscrew_roller_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_maze(Ride* ride)
+static void ride_ratings_calculate_maze(Ride* ride, RideRatingCalculationData& calcData)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -2557,13 +2621,13 @@ static void ride_ratings_calculate_maze(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 0;
 }
 
-static void ride_ratings_calculate_spiral_slide(Ride* ride)
+static void ride_ratings_calculate_spiral_slide(Ride* ride, RideRatingCalculationData& calcData)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -2586,13 +2650,13 @@ static void ride_ratings_calculate_spiral_slide(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 2;
 }
 
-static void ride_ratings_calculate_go_karts(Ride* ride)
+static void ride_ratings_calculate_go_karts(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2615,7 +2679,7 @@ static void ride_ratings_calculate_go_karts(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 4458, 3476, 5718);
     ride_ratings_apply_drops(&ratings, ride, 8738, 5461, 6553);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 2570, 8738, 2340);
-    ride_ratings_apply_proximity(&ratings, 11183);
+    ride_ratings_apply_proximity(calcData, &ratings, 11183);
     ride_ratings_apply_scenery(&ratings, ride, 16732);
 
     ride_ratings_apply_intensity_penalty(&ratings);
@@ -2623,7 +2687,7 @@ static void ride_ratings_calculate_go_karts(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     auto shelteredEighths = get_num_of_sheltered_eighths(ride);
@@ -2633,7 +2697,7 @@ static void ride_ratings_calculate_go_karts(Ride* ride)
         ride->excitement /= 2;
 }
 
-static void ride_ratings_calculate_log_flume(Ride* ride)
+static void ride_ratings_calculate_log_flume(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2650,7 +2714,7 @@ static void ride_ratings_calculate_log_flume(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 22291, 20860, 4574);
     ride_ratings_apply_drops(&ratings, ride, 69905, 62415, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 16705, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 22367);
+    ride_ratings_apply_proximity(calcData, &ratings, 22367);
     ride_ratings_apply_scenery(&ratings, ride, 11155);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 2, 2, 2, 2);
 
@@ -2659,13 +2723,13 @@ static void ride_ratings_calculate_log_flume(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_river_rapids(Ride* ride)
+static void ride_ratings_calculate_river_rapids(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2682,7 +2746,7 @@ static void ride_ratings_calculate_river_rapids(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 29721, 22598, 5718);
     ride_ratings_apply_drops(&ratings, ride, 40777, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 16705, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 31314);
+    ride_ratings_apply_proximity(calcData, &ratings, 31314);
     ride_ratings_apply_scenery(&ratings, ride, 13943);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 2, 2, 2, 2);
     ride_ratings_apply_first_length_penalty(&ratings, ride, 0xC80000, 2, 2, 2);
@@ -2692,13 +2756,13 @@ static void ride_ratings_calculate_river_rapids(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_dodgems(Ride* ride)
+static void ride_ratings_calculate_dodgems(Ride* ride, RideRatingCalculationData& calcData)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -2727,13 +2791,13 @@ static void ride_ratings_calculate_dodgems(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 7;
 }
 
-static void ride_ratings_calculate_pirate_ship(Ride* ride)
+static void ride_ratings_calculate_pirate_ship(Ride* ride, RideRatingCalculationData& calcData)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -2752,13 +2816,13 @@ static void ride_ratings_calculate_pirate_ship(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 0;
 }
 
-static void ride_ratings_calculate_inverter_ship(Ride* ride)
+static void ride_ratings_calculate_inverter_ship(Ride* ride, RideRatingCalculationData& calcData)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -2777,31 +2841,31 @@ static void ride_ratings_calculate_inverter_ship(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 0;
 }
 
-static void ride_ratings_calculate_food_stall(Ride* ride)
+static void ride_ratings_calculate_food_stall(Ride* ride, RideRatingCalculationData& calcData)
 {
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 }
 
-static void ride_ratings_calculate_drink_stall(Ride* ride)
+static void ride_ratings_calculate_drink_stall(Ride* ride, RideRatingCalculationData& calcData)
 {
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 }
 
-static void ride_ratings_calculate_shop(Ride* ride)
+static void ride_ratings_calculate_shop(Ride* ride, RideRatingCalculationData& calcData)
 {
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 }
 
-static void ride_ratings_calculate_merry_go_round(Ride* ride)
+static void ride_ratings_calculate_merry_go_round(Ride* ride, RideRatingCalculationData& calcData)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -2817,25 +2881,25 @@ static void ride_ratings_calculate_merry_go_round(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 7;
 }
 
-static void ride_ratings_calculate_information_kiosk(Ride* ride)
+static void ride_ratings_calculate_information_kiosk(Ride* ride, RideRatingCalculationData& calcData)
 {
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 }
 
-static void ride_ratings_calculate_toilets(Ride* ride)
+static void ride_ratings_calculate_toilets(Ride* ride, RideRatingCalculationData& calcData)
 {
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 }
 
-static void ride_ratings_calculate_ferris_wheel(Ride* ride)
+static void ride_ratings_calculate_ferris_wheel(Ride* ride, RideRatingCalculationData& calcData)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -2851,13 +2915,13 @@ static void ride_ratings_calculate_ferris_wheel(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 0;
 }
 
-static void ride_ratings_calculate_motion_simulator(Ride* ride)
+static void ride_ratings_calculate_motion_simulator(Ride* ride, RideRatingCalculationData& calcData)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -2884,13 +2948,13 @@ static void ride_ratings_calculate_motion_simulator(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 7;
 }
 
-static void ride_ratings_calculate_3d_cinema(Ride* ride)
+static void ride_ratings_calculate_3d_cinema(Ride* ride, RideRatingCalculationData& calcData)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -2924,13 +2988,13 @@ static void ride_ratings_calculate_3d_cinema(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths |= 7;
 }
 
-static void ride_ratings_calculate_top_spin(Ride* ride)
+static void ride_ratings_calculate_top_spin(Ride* ride, RideRatingCalculationData& calcData)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -2966,13 +3030,13 @@ static void ride_ratings_calculate_top_spin(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 0;
 }
 
-static void ride_ratings_calculate_space_rings(Ride* ride)
+static void ride_ratings_calculate_space_rings(Ride* ride, RideRatingCalculationData& calcData)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -2988,13 +3052,13 @@ static void ride_ratings_calculate_space_rings(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 0;
 }
 
-static void ride_ratings_calculate_reverse_freefall_coaster(Ride* ride)
+static void ride_ratings_calculate_reverse_freefall_coaster(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3009,7 +3073,7 @@ static void ride_ratings_calculate_reverse_freefall_coaster(Ride* ride)
     ride_ratings_apply_max_speed(&ratings, ride, 436906, 436906, 320398);
     ride_ratings_apply_gforces(&ratings, ride, 24576, 41704, 59578);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 12850, 28398, 11702);
-    ride_ratings_apply_proximity(&ratings, 17893);
+    ride_ratings_apply_proximity(calcData, &ratings, 17893);
     ride_ratings_apply_scenery(&ratings, ride, 11155);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 34, 2, 2, 2);
 
@@ -3018,13 +3082,13 @@ static void ride_ratings_calculate_reverse_freefall_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_lift(Ride* ride)
+static void ride_ratings_calculate_lift(Ride* ride, RideRatingCalculationData& calcData)
 {
     int32_t totalLength;
 
@@ -3040,7 +3104,7 @@ static void ride_ratings_calculate_lift(Ride* ride)
     totalLength = ride_get_total_length(ride) >> 16;
     ride_ratings_add(&ratings, (totalLength * 45875) >> 16, 0, (totalLength * 26214) >> 16);
 
-    ride_ratings_apply_proximity(&ratings, 11183);
+    ride_ratings_apply_proximity(calcData, &ratings, 11183);
     ride_ratings_apply_scenery(&ratings, ride, 83662);
 
     ride_ratings_apply_intensity_penalty(&ratings);
@@ -3048,7 +3112,7 @@ static void ride_ratings_calculate_lift(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 7;
@@ -3057,7 +3121,7 @@ static void ride_ratings_calculate_lift(Ride* ride)
         ride->excitement /= 4;
 }
 
-static void ride_ratings_calculate_vertical_drop_roller_coaster(Ride* ride)
+static void ride_ratings_calculate_vertical_drop_roller_coaster(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3076,7 +3140,7 @@ static void ride_ratings_calculate_vertical_drop_roller_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 58254, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(calcData, &ratings, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 6693);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 20, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0xA0000, 2, 2, 2);
@@ -3089,19 +3153,19 @@ static void ride_ratings_calculate_vertical_drop_roller_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_cash_machine(Ride* ride)
+static void ride_ratings_calculate_cash_machine(Ride* ride, RideRatingCalculationData& calcData)
 {
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 }
 
-static void ride_ratings_calculate_twist(Ride* ride)
+static void ride_ratings_calculate_twist(Ride* ride, RideRatingCalculationData& calcData)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -3117,13 +3181,13 @@ static void ride_ratings_calculate_twist(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 0;
 }
 
-static void ride_ratings_calculate_haunted_house(Ride* ride)
+static void ride_ratings_calculate_haunted_house(Ride* ride, RideRatingCalculationData& calcData)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -3141,13 +3205,13 @@ static void ride_ratings_calculate_haunted_house(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 7;
 }
 
-static void ride_ratings_calculate_flying_roller_coaster(Ride* ride)
+static void ride_ratings_calculate_flying_roller_coaster(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3167,7 +3231,7 @@ static void ride_ratings_calculate_flying_roller_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(calcData, &ratings, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 6693);
 
     if (ride->inversions == 0)
@@ -3186,13 +3250,13 @@ static void ride_ratings_calculate_flying_roller_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_virginia_reel(Ride* ride)
+static void ride_ratings_calculate_virginia_reel(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3212,7 +3276,7 @@ static void ride_ratings_calculate_virginia_reel(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 52012, 26075, 45749);
     ride_ratings_apply_drops(&ratings, ride, 43690, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 16705, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 22367);
+    ride_ratings_apply_proximity(calcData, &ratings, 22367);
     ride_ratings_apply_scenery(&ratings, ride, 11155);
     ride_ratings_apply_first_length_penalty(&ratings, ride, 0xD20000, 2, 2, 2);
     ride_ratings_apply_num_drops_penalty(&ratings, ride, 2, 2, 2, 2);
@@ -3223,13 +3287,13 @@ static void ride_ratings_calculate_virginia_reel(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_splash_boats(Ride* ride)
+static void ride_ratings_calculate_splash_boats(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3246,7 +3310,7 @@ static void ride_ratings_calculate_splash_boats(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 22291, 20860, 4574);
     ride_ratings_apply_drops(&ratings, ride, 87381, 93622, 62259);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 16705, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 22367);
+    ride_ratings_apply_proximity(calcData, &ratings, 22367);
     ride_ratings_apply_scenery(&ratings, ride, 11155);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 6, 2, 2, 2);
 
@@ -3255,13 +3319,13 @@ static void ride_ratings_calculate_splash_boats(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_mini_helicopters(Ride* ride)
+static void ride_ratings_calculate_mini_helicopters(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3280,7 +3344,7 @@ static void ride_ratings_calculate_mini_helicopters(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 14860, 0, 4574);
     ride_ratings_apply_drops(&ratings, ride, 8738, 0, 0);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 12850, 6553, 4681);
-    ride_ratings_apply_proximity(&ratings, 8946);
+    ride_ratings_apply_proximity(calcData, &ratings, 8946);
     ride_ratings_apply_scenery(&ratings, ride, 8366);
     ride_ratings_apply_first_length_penalty(&ratings, ride, 0xA00000, 2, 2, 2);
 
@@ -3289,13 +3353,13 @@ static void ride_ratings_calculate_mini_helicopters(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 6;
 }
 
-static void ride_ratings_calculate_lay_down_roller_coaster(Ride* ride)
+static void ride_ratings_calculate_lay_down_roller_coaster(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3315,7 +3379,7 @@ static void ride_ratings_calculate_lay_down_roller_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(calcData, &ratings, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 6693);
 
     if (ride->inversions == 0)
@@ -3339,13 +3403,13 @@ static void ride_ratings_calculate_lay_down_roller_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_suspended_monorail(Ride* ride)
+static void ride_ratings_calculate_suspended_monorail(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3361,7 +3425,7 @@ static void ride_ratings_calculate_suspended_monorail(Ride* ride)
     ride_ratings_apply_average_speed(&ratings, ride, 291271, 218453);
     ride_ratings_apply_duration(&ratings, ride, 150, 21845);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 5140, 6553, 18724);
-    ride_ratings_apply_proximity(&ratings, 12525);
+    ride_ratings_apply_proximity(calcData, &ratings, 12525);
     ride_ratings_apply_scenery(&ratings, ride, 25098);
     ride_ratings_apply_first_length_penalty(&ratings, ride, 0xAA0000, 2, 2, 2);
 
@@ -3370,7 +3434,7 @@ static void ride_ratings_calculate_suspended_monorail(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     auto shelteredEighths = get_num_of_sheltered_eighths(ride);
@@ -3380,7 +3444,7 @@ static void ride_ratings_calculate_suspended_monorail(Ride* ride)
     ride->sheltered_eighths = shelteredEighths.TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_reverser_roller_coaster(Ride* ride)
+static void ride_ratings_calculate_reverser_roller_coaster(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3396,7 +3460,7 @@ static void ride_ratings_calculate_reverser_roller_coaster(Ride* ride)
     ride_ratings_apply_max_speed(&ratings, ride, 44281, 88562, 35424);
     ride_ratings_apply_average_speed(&ratings, ride, 364088, 655360);
 
-    int32_t numReversers = std::min<uint16_t>(gRideRatingsCalcData.num_reversers, 6);
+    int32_t numReversers = std::min<uint16_t>(calcData.num_reversers, 6);
     ride_rating reverserRating = numReversers * RIDE_RATING(0, 20);
     ride_ratings_add(&ratings, reverserRating, reverserRating, reverserRating);
 
@@ -3405,10 +3469,10 @@ static void ride_ratings_calculate_reverser_roller_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 43458, 45749);
     ride_ratings_apply_drops(&ratings, ride, 40777, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 16705, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 22367);
+    ride_ratings_apply_proximity(calcData, &ratings, 22367);
     ride_ratings_apply_scenery(&ratings, ride, 11155);
 
-    if (gRideRatingsCalcData.num_reversers < 1)
+    if (calcData.num_reversers < 1)
     {
         ratings.excitement /= 8;
     }
@@ -3422,13 +3486,13 @@ static void ride_ratings_calculate_reverser_roller_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_heartline_twister_coaster(Ride* ride)
+static void ride_ratings_calculate_heartline_twister_coaster(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3448,7 +3512,7 @@ static void ride_ratings_calculate_heartline_twister_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 52150, 57186);
     ride_ratings_apply_drops(&ratings, ride, 29127, 53052, 55705);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 34952, 35108);
-    ride_ratings_apply_proximity(&ratings, 9841);
+    ride_ratings_apply_proximity(calcData, &ratings, 9841);
     ride_ratings_apply_scenery(&ratings, ride, 3904);
 
     if (ride->inversions == 0)
@@ -3462,13 +3526,13 @@ static void ride_ratings_calculate_heartline_twister_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_mini_golf(Ride* ride)
+static void ride_ratings_calculate_mini_golf(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3481,7 +3545,7 @@ static void ride_ratings_calculate_mini_golf(Ride* ride)
     ride_ratings_apply_length(&ratings, ride, 6000, 873);
     ride_ratings_apply_turns(&ratings, ride, 14860, 0, 0);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 5140, 6553, 4681);
-    ride_ratings_apply_proximity(&ratings, 15657);
+    ride_ratings_apply_proximity(calcData, &ratings, 15657);
     ride_ratings_apply_scenery(&ratings, ride, 27887);
 
     // Apply golf holes factor
@@ -3500,19 +3564,19 @@ static void ride_ratings_calculate_mini_golf(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_first_aid(Ride* ride)
+static void ride_ratings_calculate_first_aid(Ride* ride, RideRatingCalculationData& calcData)
 {
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 }
 
-static void ride_ratings_calculate_circus_show(Ride* ride)
+static void ride_ratings_calculate_circus_show(Ride* ride, RideRatingCalculationData& calcData)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -3530,13 +3594,13 @@ static void ride_ratings_calculate_circus_show(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 7;
 }
 
-static void ride_ratings_calculate_ghost_train(Ride* ride)
+static void ride_ratings_calculate_ghost_train(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3554,7 +3618,7 @@ static void ride_ratings_calculate_ghost_train(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 14860, 0, 11437);
     ride_ratings_apply_drops(&ratings, ride, 8738, 0, 0);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 25700, 6553, 4681);
-    ride_ratings_apply_proximity(&ratings, 11183);
+    ride_ratings_apply_proximity(calcData, &ratings, 11183);
     ride_ratings_apply_scenery(&ratings, ride, 8366);
     ride_ratings_apply_first_length_penalty(&ratings, ride, 0xB40000, 2, 2, 2);
 
@@ -3563,13 +3627,13 @@ static void ride_ratings_calculate_ghost_train(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_twister_roller_coaster(Ride* ride)
+static void ride_ratings_calculate_twister_roller_coaster(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3589,7 +3653,7 @@ static void ride_ratings_calculate_twister_roller_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(calcData, &ratings, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 6693);
 
     if (ride->inversions == 0)
@@ -3609,13 +3673,13 @@ static void ride_ratings_calculate_twister_roller_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_wooden_roller_coaster(Ride* ride)
+static void ride_ratings_calculate_wooden_roller_coaster(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3635,7 +3699,7 @@ static void ride_ratings_calculate_wooden_roller_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 43458, 45749);
     ride_ratings_apply_drops(&ratings, ride, 40777, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 16705, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 22367);
+    ride_ratings_apply_proximity(calcData, &ratings, 22367);
     ride_ratings_apply_scenery(&ratings, ride, 11155);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 12, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0xA0000, 2, 2, 2);
@@ -3649,13 +3713,13 @@ static void ride_ratings_calculate_wooden_roller_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_side_friction_roller_coaster(Ride* ride)
+static void ride_ratings_calculate_side_friction_roller_coaster(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3675,7 +3739,7 @@ static void ride_ratings_calculate_side_friction_roller_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 43458, 45749);
     ride_ratings_apply_drops(&ratings, ride, 40777, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 16705, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 22367);
+    ride_ratings_apply_proximity(calcData, &ratings, 22367);
     ride_ratings_apply_scenery(&ratings, ride, 11155);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 6, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0x50000, 2, 2, 2);
@@ -3688,13 +3752,13 @@ static void ride_ratings_calculate_side_friction_roller_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_wild_mouse(Ride* ride)
+static void ride_ratings_calculate_wild_mouse(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3714,7 +3778,7 @@ static void ride_ratings_calculate_wild_mouse(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 29721, 43458, 45749);
     ride_ratings_apply_drops(&ratings, ride, 40777, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 16705, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 17893);
+    ride_ratings_apply_proximity(calcData, &ratings, 17893);
     ride_ratings_apply_scenery(&ratings, ride, 5577);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 6, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0x70000, 2, 2, 2);
@@ -3728,13 +3792,13 @@ static void ride_ratings_calculate_wild_mouse(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_multi_dimension_roller_coaster(Ride* ride)
+static void ride_ratings_calculate_multi_dimension_roller_coaster(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3754,7 +3818,7 @@ static void ride_ratings_calculate_multi_dimension_roller_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(calcData, &ratings, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 6693);
 
     if (ride->inversions == 0)
@@ -3773,13 +3837,13 @@ static void ride_ratings_calculate_multi_dimension_roller_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_giga_coaster(Ride* ride)
+static void ride_ratings_calculate_giga_coaster(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3799,7 +3863,7 @@ static void ride_ratings_calculate_giga_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 28235, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 43690, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(calcData, &ratings, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 6693);
 
     if (ride->inversions == 0)
@@ -3819,13 +3883,13 @@ static void ride_ratings_calculate_giga_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_roto_drop(Ride* ride)
+static void ride_ratings_calculate_roto_drop(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3839,7 +3903,7 @@ static void ride_ratings_calculate_roto_drop(Ride* ride)
     int32_t lengthFactor = ((ride_get_total_length(ride) >> 16) * 209715) >> 16;
     ride_ratings_add(&ratings, lengthFactor, lengthFactor * 2, lengthFactor * 2);
 
-    ride_ratings_apply_proximity(&ratings, 11183);
+    ride_ratings_apply_proximity(calcData, &ratings, 11183);
     ride_ratings_apply_scenery(&ratings, ride, 25098);
 
     ride_ratings_apply_intensity_penalty(&ratings);
@@ -3847,13 +3911,13 @@ static void ride_ratings_calculate_roto_drop(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_flying_saucers(Ride* ride)
+static void ride_ratings_calculate_flying_saucers(Ride* ride, RideRatingCalculationData& calcData)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -3885,13 +3949,13 @@ static void ride_ratings_calculate_flying_saucers(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 0;
 }
 
-static void ride_ratings_calculate_crooked_house(Ride* ride)
+static void ride_ratings_calculate_crooked_house(Ride* ride, RideRatingCalculationData& calcData)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -3909,13 +3973,13 @@ static void ride_ratings_calculate_crooked_house(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 7;
 }
 
-static void ride_ratings_calculate_monorail_cycles(Ride* ride)
+static void ride_ratings_calculate_monorail_cycles(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3934,7 +3998,7 @@ static void ride_ratings_calculate_monorail_cycles(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 14860, 0, 4574);
     ride_ratings_apply_drops(&ratings, ride, 8738, 0, 0);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 5140, 6553, 2340);
-    ride_ratings_apply_proximity(&ratings, 8946);
+    ride_ratings_apply_proximity(calcData, &ratings, 8946);
     ride_ratings_apply_scenery(&ratings, ride, 11155);
     ride_ratings_apply_first_length_penalty(&ratings, ride, 0x8C0000, 2, 2, 2);
 
@@ -3943,13 +4007,13 @@ static void ride_ratings_calculate_monorail_cycles(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_compact_inverted_coaster(Ride* ride)
+static void ride_ratings_calculate_compact_inverted_coaster(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3969,7 +4033,7 @@ static void ride_ratings_calculate_compact_inverted_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 29552, 57186);
     ride_ratings_apply_drops(&ratings, ride, 29127, 39009, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 15291, 35108);
-    ride_ratings_apply_proximity(&ratings, 15657);
+    ride_ratings_apply_proximity(calcData, &ratings, 15657);
     ride_ratings_apply_scenery(&ratings, ride, 8366);
 
     if (ride->inversions == 0)
@@ -3986,13 +4050,13 @@ static void ride_ratings_calculate_compact_inverted_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_water_coaster(Ride* ride)
+static void ride_ratings_calculate_water_coaster(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -4012,7 +4076,7 @@ static void ride_ratings_calculate_water_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 25700, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(calcData, &ratings, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 9760);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 8, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0x70000, 2, 2, 2);
@@ -4027,13 +4091,13 @@ static void ride_ratings_calculate_water_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_air_powered_vertical_coaster(Ride* ride)
+static void ride_ratings_calculate_air_powered_vertical_coaster(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -4048,7 +4112,7 @@ static void ride_ratings_calculate_air_powered_vertical_coaster(Ride* ride)
     ride_ratings_apply_max_speed(&ratings, ride, 509724, 364088, 320398);
     ride_ratings_apply_gforces(&ratings, ride, 24576, 35746, 59578);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 21845, 11702);
-    ride_ratings_apply_proximity(&ratings, 17893);
+    ride_ratings_apply_proximity(calcData, &ratings, 17893);
     ride_ratings_apply_scenery(&ratings, ride, 11155);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 34, 2, 1, 1);
 
@@ -4058,13 +4122,13 @@ static void ride_ratings_calculate_air_powered_vertical_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_inverted_hairpin_coaster(Ride* ride)
+static void ride_ratings_calculate_inverted_hairpin_coaster(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -4084,7 +4148,7 @@ static void ride_ratings_calculate_inverted_hairpin_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 29721, 43458, 45749);
     ride_ratings_apply_drops(&ratings, ride, 40777, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 16705, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 17893);
+    ride_ratings_apply_proximity(calcData, &ratings, 17893);
     ride_ratings_apply_scenery(&ratings, ride, 5577);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 8, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0x70000, 2, 2, 2);
@@ -4099,13 +4163,13 @@ static void ride_ratings_calculate_inverted_hairpin_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_magic_carpet(Ride* ride)
+static void ride_ratings_calculate_magic_carpet(Ride* ride, RideRatingCalculationData& calcData)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -4124,13 +4188,13 @@ static void ride_ratings_calculate_magic_carpet(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 0;
 }
 
-static void ride_ratings_calculate_submarine_ride(Ride* ride)
+static void ride_ratings_calculate_submarine_ride(Ride* ride, RideRatingCalculationData& calcData)
 {
     ride->unreliability_factor = 7;
     set_unreliability_factor(ride);
@@ -4140,7 +4204,7 @@ static void ride_ratings_calculate_submarine_ride(Ride* ride)
     rating_tuple ratings;
     ride_ratings_set(&ratings, RIDE_RATING(2, 20), RIDE_RATING(1, 80), RIDE_RATING(1, 40));
     ride_ratings_apply_length(&ratings, ride, 6000, 764);
-    ride_ratings_apply_proximity(&ratings, 11183);
+    ride_ratings_apply_proximity(calcData, &ratings, 11183);
     ride_ratings_apply_scenery(&ratings, ride, 22310);
 
     ride_ratings_apply_intensity_penalty(&ratings);
@@ -4148,14 +4212,14 @@ static void ride_ratings_calculate_submarine_ride(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     // Originally, this was always to zero, even though the default vehicle is completely enclosed.
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_river_rafts(Ride* ride)
+static void ride_ratings_calculate_river_rafts(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -4171,7 +4235,7 @@ static void ride_ratings_calculate_river_rafts(Ride* ride)
     ride_ratings_apply_duration(&ratings, ride, 500, 13107);
     ride_ratings_apply_turns(&ratings, ride, 22291, 20860, 4574);
     ride_ratings_apply_drops(&ratings, ride, 78643, 93622, 62259);
-    ride_ratings_apply_proximity(&ratings, 13420);
+    ride_ratings_apply_proximity(calcData, &ratings, 13420);
     ride_ratings_apply_scenery(&ratings, ride, 11155);
 
     ride_ratings_apply_intensity_penalty(&ratings);
@@ -4179,13 +4243,13 @@ static void ride_ratings_calculate_river_rafts(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_enterprise(Ride* ride)
+static void ride_ratings_calculate_enterprise(Ride* ride, RideRatingCalculationData& calcData)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -4208,13 +4272,13 @@ static void ride_ratings_calculate_enterprise(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 3;
 }
 
-static void ride_ratings_calculate_inverted_impulse_coaster(Ride* ride)
+static void ride_ratings_calculate_inverted_impulse_coaster(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -4234,7 +4298,7 @@ static void ride_ratings_calculate_inverted_impulse_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 29552, 57186);
     ride_ratings_apply_drops(&ratings, ride, 29127, 39009, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 15291, 35108);
-    ride_ratings_apply_proximity(&ratings, 15657);
+    ride_ratings_apply_proximity(calcData, &ratings, 15657);
     ride_ratings_apply_scenery(&ratings, ride, 9760);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 20, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0xA0000, 2, 2, 2);
@@ -4245,13 +4309,13 @@ static void ride_ratings_calculate_inverted_impulse_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_mini_roller_coaster(Ride* ride)
+static void ride_ratings_calculate_mini_roller_coaster(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -4271,7 +4335,7 @@ static void ride_ratings_calculate_mini_roller_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 25700, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(calcData, &ratings, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 9760);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 12, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0x70000, 2, 2, 2);
@@ -4284,13 +4348,13 @@ static void ride_ratings_calculate_mini_roller_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_mine_ride(Ride* ride)
+static void ride_ratings_calculate_mine_ride(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -4310,7 +4374,7 @@ static void ride_ratings_calculate_mine_ride(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 29721, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 19275, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 21472);
+    ride_ratings_apply_proximity(calcData, &ratings, 21472);
     ride_ratings_apply_scenery(&ratings, ride, 16732);
     ride_ratings_apply_first_length_penalty(&ratings, ride, 0x10E0000, 2, 2, 2);
 
@@ -4320,13 +4384,13 @@ static void ride_ratings_calculate_mine_ride(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_lim_launched_roller_coaster(Ride* ride)
+static void ride_ratings_calculate_lim_launched_roller_coaster(Ride* ride, RideRatingCalculationData& calcData)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -4346,7 +4410,7 @@ static void ride_ratings_calculate_lim_launched_roller_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(calcData, &ratings, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 6693);
 
     if (ride->inversions == 0)
@@ -4366,7 +4430,7 @@ static void ride_ratings_calculate_lim_launched_roller_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, calcData);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
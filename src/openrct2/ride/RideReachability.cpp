@@ -0,0 +1,284 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "RideReachability.h"
+
+#include "../world/Map.h"
+#include "Ride.h"
+#include "RideData.h"
+#include "TrackData.h"
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <vector>
+
+static_assert(MAX_STATIONS * 2 <= 8, "The flags of all entrances and exits must fit in a byte");
+
+// Marking more tiles than this between two checks rechecks every ride instead.
+constexpr size_t MAX_DIRTY_TILES = 4096;
+
+/**
+ * A footpath the entrance or exit of a ride needs in front of it to be connected. Shops are connected if any of their
+ * probes finds a footpath, other rides need one for every probe.
+ */
+struct ReachabilityProbe
+{
+    TileCoordsXYZ Loc;
+    Direction FaceDirection;
+    uint8_t Flag;
+
+    bool operator==(const ReachabilityProbe& other) const
+    {
+        return Loc == other.Loc && FaceDirection == other.FaceDirection && Flag == other.Flag;
+    }
+};
+
+struct RideReachability
+{
+    std::array<ReachabilityProbe, MAX_STATIONS * 2> Probes;
+    uint8_t NumProbes;
+    bool IsShop;
+
+    bool operator==(const RideReachability& other) const
+    {
+        return NumProbes == other.NumProbes && IsShop == other.IsShop
+            && std::equal(Probes.begin(), Probes.begin() + NumProbes, other.Probes.begin());
+    }
+};
+
+struct RideReachabilityEntry
+{
+    RideReachability Reachability;
+    uint8_t Unreachable;
+    bool Valid;
+};
+
+// Results are kept per ride index even when a ride is removed, the probes tell whether they belong to a new ride.
+static std::array<RideReachabilityEntry, MAX_RIDES> _entries;
+static std::vector<TileCoordsXY> _dirtyTiles;
+static std::bitset<256> _changedPathHeights;
+static bool _allDirty = true;
+
+static bool CompareTiles(const TileCoordsXY& a, const TileCoordsXY& b)
+{
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+static void AddProbe(RideReachability& reachability, const TileCoordsXYZ& loc, Direction faceDirection, uint8_t flag)
+{
+    reachability.Probes[reachability.NumProbes++] = { loc, faceDirection, flag };
+}
+
+/**
+ *
+ *  rct2: 0x006B7C59
+ */
+static void AddEntranceExitProbe(RideReachability& reachability, const TileCoordsXYZD& coordinates, uint8_t flag)
+{
+    if (coordinates.isNull())
+        return;
+
+    TileCoordsXYZ loc{ coordinates.x, coordinates.y, coordinates.z };
+    loc -= TileDirectionDelta[coordinates.direction];
+    AddProbe(reachability, loc, coordinates.direction, flag);
+}
+
+static void AddShopProbes(RideReachability& reachability, const Ride& ride)
+{
+    auto shopLoc = TileCoordsXY(ride.stations[0].Start);
+    if (shopLoc.isNull())
+        return;
+
+    TrackElement* trackElement = nullptr;
+    TileElement* tileElement = map_get_first_element_at(shopLoc.ToCoordsXY());
+    do
+    {
+        if (tileElement == nullptr)
+            break;
+        if (tileElement->GetType() == TILE_ELEMENT_TYPE_TRACK && tileElement->AsTrack()->GetRideIndex() == ride.id)
+        {
+            trackElement = tileElement->AsTrack();
+            break;
+        }
+    } while (!(tileElement++)->IsLastForTile());
+
+    if (trackElement == nullptr)
+        return;
+
+    uint8_t entrance_directions = 0;
+    auto track_type = trackElement->GetTrackType();
+    if (ride_type_has_flag(ride.type, RIDE_TYPE_FLAG_FLAT_RIDE))
+    {
+        entrance_directions = FlatRideTrackSequenceProperties[track_type][0] & 0xF;
+    }
+    else
+    {
+        entrance_directions = TrackSequenceProperties[track_type][0] & 0xF;
+    }
+
+    uint8_t tile_direction = trackElement->GetDirection();
+    entrance_directions = rol4(entrance_directions, tile_direction);
+
+    // Now each bit in entrance_directions stands for an entrance direction to check
+    for (auto count = 0; entrance_directions != 0; count++)
+    {
+        if (!(entrance_directions & 1))
+        {
+            entrance_directions >>= 1;
+            continue;
+        }
+        entrance_directions >>= 1;
+
+        // Flip direction north<->south, east<->west
+        uint8_t face_direction = direction_reverse(count);
+
+        int32_t y2 = shopLoc.y - TileDirectionDelta[face_direction].y;
+        int32_t x2 = shopLoc.x - TileDirectionDelta[face_direction].x;
+        AddProbe(reachability, { x2, y2, trackElement->base_height }, face_direction, ride_reachability_entrance_flag(0));
+    }
+}
+
+/**
+ * Gets where the map is looked at to tell whether a ride is connected, this only reads the ride and for shops the
+ * tile they are on.
+ */
+static RideReachability GetRideReachability(const Ride& ride)
+{
+    RideReachability reachability{};
+    reachability.IsShop = ride_type_has_flag(ride.type, RIDE_TYPE_FLAG_IS_SHOP);
+    if (reachability.IsShop)
+    {
+        AddShopProbes(reachability, ride);
+        return reachability;
+    }
+
+    for (int32_t i = 0; i < MAX_STATIONS; ++i)
+    {
+        if (ride.stations[i].Start.isNull())
+            continue;
+        AddEntranceExitProbe(reachability, ride.stations[i].Entrance, ride_reachability_entrance_flag(i));
+        AddEntranceExitProbe(reachability, ride.stations[i].Exit, ride_reachability_exit_flag(i));
+    }
+    return reachability;
+}
+
+static uint8_t CalculateUnreachable(const RideReachability& reachability)
+{
+    uint8_t unreachable = 0;
+    for (uint8_t i = 0; i < reachability.NumProbes; i++)
+    {
+        const auto& probe = reachability.Probes[i];
+        bool connected = map_coord_is_connected(probe.Loc, probe.FaceDirection);
+        if (reachability.IsShop && connected)
+            return 0;
+        if (!connected)
+            unreachable |= probe.Flag;
+    }
+    return unreachable;
+}
+
+/**
+ * Whether a probe may give a different result since the last check. Sloped footpaths connect to entrances two units
+ * above them.
+ */
+static bool IsProbeDirty(const ReachabilityProbe& probe)
+{
+    if (std::binary_search(_dirtyTiles.begin(), _dirtyTiles.end(), TileCoordsXY{ probe.Loc.x, probe.Loc.y }, CompareTiles))
+        return true;
+
+    const auto z = probe.Loc.z;
+    return (z >= 0 && z < static_cast<int32_t>(_changedPathHeights.size()) && _changedPathHeights[z])
+        || (z >= 2 && z - 2 < static_cast<int32_t>(_changedPathHeights.size()) && _changedPathHeights[z - 2]);
+}
+
+/**
+ * Drops the results of rides that look at any footpath changed since the last check.
+ */
+static void ProcessChanges()
+{
+    if (_allDirty)
+    {
+        for (auto& entry : _entries)
+        {
+            entry.Valid = false;
+        }
+        _allDirty = false;
+        _dirtyTiles.clear();
+        _changedPathHeights.reset();
+        return;
+    }
+
+    if (_dirtyTiles.empty() && _changedPathHeights.none())
+        return;
+
+    std::sort(_dirtyTiles.begin(), _dirtyTiles.end(), CompareTiles);
+    for (auto& entry : _entries)
+    {
+        if (!entry.Valid)
+            continue;
+
+        const auto& reachability = entry.Reachability;
+        entry.Valid = std::none_of(
+            reachability.Probes.begin(), reachability.Probes.begin() + reachability.NumProbes, IsProbeDirty);
+    }
+    _dirtyTiles.clear();
+    _changedPathHeights.reset();
+}
+
+void ride_reachability_invalidate_all()
+{
+    _allDirty = true;
+    _dirtyTiles.clear();
+    _changedPathHeights.reset();
+}
+
+void ride_reachability_invalidate_tile(const CoordsXY& loc)
+{
+    if (_allDirty || !map_is_location_valid(loc))
+        return;
+
+    if (_dirtyTiles.size() >= MAX_DIRTY_TILES)
+    {
+        ride_reachability_invalidate_all();
+        return;
+    }
+    _dirtyTiles.push_back(TileCoordsXY(loc));
+}
+
+/**
+ * Called before an element is removed from its tile. The tile is not known here, so every ride looking for a footpath
+ * at the height of a removed one is checked again.
+ */
+void ride_reachability_on_element_removed(const TileElement* tileElement)
+{
+    if (tileElement->GetType() == TILE_ELEMENT_TYPE_PATH)
+    {
+        _changedPathHeights[tileElement->base_height] = true;
+    }
+}
+
+/**
+ * Gets the flags of the entrances and exits of a ride that are not connected to a footpath. The map is only looked at
+ * again if the ride changed or footpaths it needs were changed since it was last checked.
+ */
+uint8_t ride_reachability_get_unreachable(const Ride& ride)
+{
+    ProcessChanges();
+
+    auto reachability = GetRideReachability(ride);
+    auto& entry = _entries[ride.id];
+    if (!entry.Valid || !(entry.Reachability == reachability))
+    {
+        entry.Reachability = reachability;
+        entry.Unreachable = CalculateUnreachable(reachability);
+        entry.Valid = true;
+    }
+    return entry.Unreachable;
+}
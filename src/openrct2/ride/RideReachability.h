@@ -0,0 +1,32 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "../world/Location.hpp"
+
+struct Ride;
+struct TileElement;
+
+// Flags for the entrances and exits of a ride that are not connected to a footpath. Shops only use the entrance flag of
+// the first station.
+constexpr uint8_t ride_reachability_entrance_flag(int32_t stationIndex)
+{
+    return 1 << (stationIndex * 2);
+}
+constexpr uint8_t ride_reachability_exit_flag(int32_t stationIndex)
+{
+    return 1 << (stationIndex * 2 + 1);
+}
+
+void ride_reachability_invalidate_all();
+void ride_reachability_invalidate_tile(const CoordsXY& loc);
+void ride_reachability_on_element_removed(const TileElement* tileElement);
+uint8_t ride_reachability_get_unreachable(const Ride& ride);
@@ -71,6 +71,8 @@ uint8_t _vehicleF64E2C;
 Vehicle* _vehicleFrontVehicle;
 CoordsXYZ unk_F64E20;
 
+bool gVehicleSkipTrackSubpositions = true;
+
 // clang-format off
 static constexpr const SoundId byte_9A3A14[] = { SoundId::Scream8, SoundId::Scream1 };
 static constexpr const SoundId byte_9A3A16[] = { SoundId::Scream1, SoundId::Scream6 };
@@ -732,73 +734,40 @@ template<> bool SpriteBase::Is<Vehicle>() const
     return sprite_identifier == SPRITE_IDENTIFIER_VEHICLE;
 }
 
-static bool vehicle_move_info_valid(int32_t trackSubposition, int32_t typeAndDirection, int32_t offset)
+static const rct_vehicle_info_piece* vehicle_get_move_info_piece(int32_t trackSubposition, int32_t typeAndDirection)
 {
-    if (trackSubposition >= static_cast<int32_t>(std::size(gTrackVehicleInfo)))
-    {
-        return false;
-    }
-    int32_t size = 0;
-    switch (trackSubposition)
-    {
-        case VEHICLE_TRACK_SUBPOSITION_0:
-            size = 1024;
-            break;
-        case VEHICLE_TRACK_SUBPOSITION_CHAIRLIFT_GOING_OUT:
-            size = 692;
-            break;
-        case VEHICLE_TRACK_SUBPOSITION_CHAIRLIFT_GOING_BACK:
-        case VEHICLE_TRACK_SUBPOSITION_CHAIRLIFT_END_BULLWHEEL:
-        case VEHICLE_TRACK_SUBPOSITION_CHAIRLIFT_START_BULLWHEEL:
-            size = 404;
-            break;
-        case VEHICLE_TRACK_SUBPOSITION_GO_KARTS_LEFT_LANE:
-        case VEHICLE_TRACK_SUBPOSITION_GO_KARTS_RIGHT_LANE:
-        case VEHICLE_TRACK_SUBPOSITION_GO_KARTS_MOVING_TO_RIGHT_LANE:
-        case VEHICLE_TRACK_SUBPOSITION_GO_KARTS_MOVING_TO_LEFT_LANE:
-            size = 208;
-            break;
-        case VEHICLE_TRACK_SUBPOSITION_MINI_GOLF_PATH_A_9: // VEHICLE_TRACK_SUBPOSITION_MINI_GOLF_START_9
-        case VEHICLE_TRACK_SUBPOSITION_MINI_GOLF_BALL_PATH_A_10:
-        case VEHICLE_TRACK_SUBPOSITION_MINI_GOLF_PATH_B_11:
-        case VEHICLE_TRACK_SUBPOSITION_MINI_GOLF_BALL_PATH_B_12:
-        case VEHICLE_TRACK_SUBPOSITION_MINI_GOLF_PATH_C_13:
-        case VEHICLE_TRACK_SUBPOSITION_MINI_GOLF_BALL_PATH_C_14:
-            size = 824;
-            break;
-        case VEHICLE_TRACK_SUBPOSITION_REVERSER_RC_FRONT_BOGIE:
-        case VEHICLE_TRACK_SUBPOSITION_REVERSER_RC_REAR_BOGIE:
-            size = 868;
-            break;
-    }
-    if (typeAndDirection >= size)
+    if (trackSubposition < 0 || trackSubposition >= VEHICLE_TRACK_SUBPOSITION_COUNT || typeAndDirection < 0)
     {
-        return false;
+        return nullptr;
     }
-    if (offset >= gTrackVehicleInfo[trackSubposition][typeAndDirection]->size)
+    const auto& table = vehicle_get_move_info_table();
+    uint32_t index = table.SubpositionStart[trackSubposition] + typeAndDirection;
+    if (index >= table.SubpositionStart[trackSubposition + 1])
     {
-        return false;
+        return nullptr;
     }
-    return true;
+    return &table.Pieces[index];
 }
 
 const rct_vehicle_info* vehicle_get_move_info(int32_t trackSubposition, int32_t typeAndDirection, int32_t offset)
 {
-    if (!vehicle_move_info_valid(trackSubposition, typeAndDirection, offset))
+    const rct_vehicle_info_piece* piece = vehicle_get_move_info_piece(trackSubposition, typeAndDirection);
+    if (piece == nullptr || offset < 0 || offset >= piece->size)
     {
         static constexpr const rct_vehicle_info zero = {};
         return &zero;
     }
-    return &gTrackVehicleInfo[trackSubposition][typeAndDirection]->info[offset];
+    return &piece->info[offset];
 }
 
 uint16_t vehicle_get_move_info_size(int32_t trackSubposition, int32_t typeAndDirection)
 {
-    if (!vehicle_move_info_valid(trackSubposition, typeAndDirection, 0))
+    const rct_vehicle_info_piece* piece = vehicle_get_move_info_piece(trackSubposition, typeAndDirection);
+    if (piece == nullptr)
     {
         return 0;
     }
-    return gTrackVehicleInfo[trackSubposition][typeAndDirection]->size;
+    return piece->size;
 }
 
 Vehicle* try_get_vehicle(uint16_t spriteIndex)
@@ -1402,6 +1371,10 @@ void vehicle_update_all()
     if ((gScreenFlags & SCREEN_FLAGS_TRACK_DESIGNER) && gS6Info.editor_step != EDITOR_STEP_ROLLERCOASTER_DESIGNER)
         return;
 
+    // Trains have to be updated one at a time, in sprite list order. Besides sharing the track motion state at the top of
+    // this file, updating a train draws from scenario_rand, moves sprites in the spatial index, looks for vehicles of any
+    // ride in the quadrants it moves through and loads and unloads guests. All of that has to happen in the same order on
+    // every client.
     sprite_index = gSpriteListHead[SPRITE_LIST_TRAIN_HEAD];
     while (sprite_index != SPRITE_INDEX_NULL)
     {
@@ -8146,6 +8119,132 @@ bool Vehicle::UpdateTrackMotionForwardsGetNewTrack(uint16_t trackType, Ride* cur
     return true;
 }
 
+/**
+ * Whether the track motion loops would do nothing else than move this car along its current piece of track, so runs of
+ * subposition steps can be skipped at once.
+ */
+bool Vehicle::CanSkipTrackSubpositions(
+    const rct_ride_entry_vehicle* vehicleEntry, const Ride* curRide, const rct_vehicle_info_piece* piece) const
+{
+    if (!gVehicleSkipTrackSubpositions)
+    {
+        return false;
+    }
+
+    // The front car checks for collisions at every step.
+    if (this == _vehicleFrontVehicle || (vehicleEntry->flags & VEHICLE_ENTRY_FLAG_25))
+    {
+        return false;
+    }
+    int32_t trackType = GetTrackType();
+    if (trackType == TRACK_ELEM_BRAKES || track_element_is_booster(curRide->type, trackType)
+        || (trackType == TRACK_ELEM_FLAT && curRide->type == RIDE_TYPE_REVERSE_FREEFALL_COASTER))
+    {
+        return false;
+    }
+
+    // The last position moved to must be the current step for the distances to add up.
+    const rct_vehicle_info& moveInfo = piece->info[track_progress];
+    int16_t curX = TrackLocation.x + moveInfo.x;
+    int16_t curY = TrackLocation.y + moveInfo.y;
+    int16_t curZ = TrackLocation.z + moveInfo.z + RideData5[curRide->type].z_offset;
+    return curX == unk_F64E20.x && curY == unk_F64E20.y && curZ == unk_F64E20.z;
+}
+
+void Vehicle::MoveToTrackSubposition(const Ride* curRide, const rct_vehicle_info_piece* piece, uint16_t progress)
+{
+    const rct_vehicle_info& moveInfo = piece->info[progress];
+    int16_t curX = TrackLocation.x + moveInfo.x;
+    int16_t curY = TrackLocation.y + moveInfo.y;
+    int16_t curZ = TrackLocation.z + moveInfo.z + RideData5[curRide->type].z_offset;
+    track_progress = progress;
+    unk_F64E20.x = curX;
+    unk_F64E20.y = curY;
+    unk_F64E20.z = curZ;
+    sprite_direction = moveInfo.direction;
+    bank_rotation = moveInfo.bank_rotation;
+    vehicle_sprite_type = moveInfo.vehicle_sprite_type;
+}
+
+/**
+ * Moves forwards all the subposition steps UpdateTrackMotionForwards would move along the current piece of track
+ * without anything else happening at once, fast cars move through many steps every tick.
+ */
+void Vehicle::UpdateTrackMotionForwardsSkip(
+    const rct_ride_entry_vehicle* vehicleEntry, const Ride* curRide, const rct_ride_entry* rideEntry)
+{
+    const rct_vehicle_info_piece* piece = vehicle_get_move_info_piece(TrackSubposition, track_type);
+    if (piece == nullptr || rideEntry == nullptr || track_progress + 1 >= piece->size)
+    {
+        return;
+    }
+    int32_t trackType = GetTrackType();
+    if (TrackSubposition == VEHICLE_TRACK_SUBPOSITION_REVERSER_RC_FRONT_BOGIE
+        || TrackSubposition == VEHICLE_TRACK_SUBPOSITION_REVERSER_RC_REAR_BOGIE
+        || trackType == TRACK_ELEM_HEARTLINE_TRANSFER_UP || trackType == TRACK_ELEM_HEARTLINE_TRANSFER_DOWN
+        || trackType == TRACK_ELEM_POWERED_LIFT || trackType == TRACK_ELEM_BRAKE_FOR_DROP
+        || trackType == TRACK_ELEM_LOG_FLUME_REVERSER || trackType == TRACK_ELEM_WATER_SPLASH
+        || (rideEntry->flags & (RIDE_ENTRY_FLAG_PLAY_SPLASH_SOUND | RIDE_ENTRY_FLAG_PLAY_SPLASH_SOUND_SLIDE)))
+    {
+        return;
+    }
+    if (!CanSkipTrackSubpositions(vehicleEntry, curRide, piece))
+    {
+        return;
+    }
+
+    // The loop carries on after every step that leaves at least 0x368A of the remaining distance.
+    const auto& table = vehicle_get_move_info_table();
+    const int32_t* distances = &table.Distances[piece->totals];
+    const int64_t furthest = static_cast<int64_t>(distances[track_progress]) + remaining_distance - 0x368A;
+    const int32_t* end = std::upper_bound(distances + track_progress + 1, distances + piece->size, furthest);
+    uint16_t progress = static_cast<uint16_t>(end - distances - 1);
+    if (progress == track_progress)
+    {
+        return;
+    }
+
+    const int32_t* accelerations = &table.Accelerations[piece->totals];
+    remaining_distance -= distances[progress] - distances[track_progress];
+    acceleration += accelerations[progress + 1] - accelerations[track_progress + 1];
+    _vehicleUnkF64E10 += progress - track_progress;
+    MoveToTrackSubposition(curRide, piece, progress);
+}
+
+/**
+ * Moves backwards all the subposition steps UpdateTrackMotionBackwards would move along the current piece of track
+ * without anything else happening at once.
+ */
+void Vehicle::UpdateTrackMotionBackwardsSkip(const rct_ride_entry_vehicle* vehicleEntry, const Ride* curRide)
+{
+    const rct_vehicle_info_piece* piece = vehicle_get_move_info_piece(TrackSubposition, track_type);
+    if (piece == nullptr || track_progress == 0 || track_progress >= piece->size)
+    {
+        return;
+    }
+    if (!CanSkipTrackSubpositions(vehicleEntry, curRide, piece))
+    {
+        return;
+    }
+
+    // The loop carries on after every step that leaves the remaining distance below zero.
+    const auto& table = vehicle_get_move_info_table();
+    const int32_t* distances = &table.Distances[piece->totals];
+    const int64_t furthest = static_cast<int64_t>(distances[track_progress]) + remaining_distance;
+    const int32_t* begin = std::upper_bound(distances, distances + track_progress, furthest);
+    uint16_t progress = static_cast<uint16_t>(begin - distances);
+    if (progress == track_progress)
+    {
+        return;
+    }
+
+    const int32_t* accelerations = &table.Accelerations[piece->totals];
+    remaining_distance += distances[track_progress] - distances[progress];
+    acceleration += accelerations[track_progress] - accelerations[progress];
+    _vehicleUnkF64E10 += track_progress - progress;
+    MoveToTrackSubposition(curRide, piece, progress);
+}
+
 /**
  *
  *  rct2: 0x006DAEB9
@@ -8155,6 +8254,7 @@ bool Vehicle::UpdateTrackMotionForwards(rct_ride_entry_vehicle* vehicleEntry, Ri
     registers regs = {};
     uint16_t otherVehicleIndex = SPRITE_INDEX_NULL;
 loc_6DAEB9:
+    UpdateTrackMotionForwardsSkip(vehicleEntry, curRide, rideEntry);
     regs.cx = GetTrackType();
     int32_t trackType = GetTrackType();
     if (trackType == TRACK_ELEM_HEARTLINE_TRANSFER_UP || trackType == TRACK_ELEM_HEARTLINE_TRANSFER_DOWN)
@@ -8548,6 +8648,7 @@ bool Vehicle::UpdateTrackMotionBackwards(rct_ride_entry_vehicle* vehicleEntry, R
     uint16_t otherVehicleIndex = SPRITE_INDEX_NULL;
 
 loc_6DBA33:;
+    UpdateTrackMotionBackwardsSkip(vehicleEntry, curRide);
     uint16_t trackType = GetTrackType();
     if (trackType == TRACK_ELEM_FLAT && curRide->type == RIDE_TYPE_REVERSE_FREEFALL_COASTER)
     {
@@ -180,6 +180,7 @@ enum VEHICLE_TRACK_SUBPOSITION : uint8_t
 
 struct Ride;
 struct rct_ride_entry;
+struct rct_vehicle_info_piece;
 
 struct GForces
 {
@@ -393,6 +394,12 @@ private:
     bool CurrentTowerElementIsTop();
     bool UpdateTrackMotionForwards(rct_ride_entry_vehicle* vehicleEntry, Ride* curRide, rct_ride_entry* rideEntry);
     bool UpdateTrackMotionBackwards(rct_ride_entry_vehicle* vehicleEntry, Ride* curRide, rct_ride_entry* rideEntry);
+    bool CanSkipTrackSubpositions(
+        const rct_ride_entry_vehicle* vehicleEntry, const Ride* curRide, const rct_vehicle_info_piece* piece) const;
+    void MoveToTrackSubposition(const Ride* curRide, const rct_vehicle_info_piece* piece, uint16_t progress);
+    void UpdateTrackMotionForwardsSkip(
+        const rct_ride_entry_vehicle* vehicleEntry, const Ride* curRide, const rct_ride_entry* rideEntry);
+    void UpdateTrackMotionBackwardsSkip(const rct_ride_entry_vehicle* vehicleEntry, const Ride* curRide);
     int32_t UpdateTrackMotionPoweredRideAcceleration(
         rct_ride_entry_vehicle* vehicleEntry, uint32_t totalMass, const int32_t curAcceleration);
     int32_t NumPeepsUntilTrainTail() const;
@@ -629,6 +636,10 @@ extern uint8_t _vehicleF64E2C;
 extern Vehicle* _vehicleFrontVehicle;
 extern CoordsXYZ unk_F64E20;
 
+// Whether cars move over runs of track subpositions at once. Turning it off steps through every subposition, which gives
+// the same result.
+extern bool gVehicleSkipTrackSubpositions;
+
 /** Helper macro until rides are stored in this module. */
 #define GET_VEHICLE(sprite_index) &(get_sprite(sprite_index)->vehicle)
 
@@ -9,6 +9,10 @@
 
 #include "VehicleSubpositionData.h"
 
+#include "VehicleData.h"
+
+#include <unordered_map>
+
 #define CREATE_VEHICLE_INFO(VAR, ...)                                                                                          \
     static constexpr const rct_vehicle_info VAR##_data[] = __VA_ARGS__;                                                        \
     static constexpr const rct_vehicle_info_list VAR = { static_cast<uint16_t>(std::size(VAR##_data)), VAR##_data };
@@ -25745,3 +25749,75 @@ constexpr const rct_vehicle_info_list * const * gTrackVehicleInfo[VEHICLE_TRACK_
 };
 
 // clang-format on
+
+static VehicleMoveInfoTable vehicle_create_move_info_table()
+{
+    static constexpr size_t numPieces[VEHICLE_TRACK_SUBPOSITION_COUNT] = {
+        std::size(TrackVehicleInfoListDefault),
+        std::size(TrackVehicleInfoListChairliftGoingOut),
+        std::size(TrackVehicleInfoListChairliftGoingBack),
+        std::size(TrackVehicleInfoListChairliftEndBullwheel),
+        std::size(TrackVehicleInfoListChairliftStartBullwheel),
+        std::size(TrackVehicleInfoListGoKartsLeftLane),
+        std::size(TrackVehicleInfoListGoKartsRightLane),
+        std::size(TrackVehicleInfoListGoKartsMovingToRightLane),
+        std::size(TrackVehicleInfoListGoKartsMovingToLeftLane),
+        std::size(TrackVehicleInfoListMiniGolfStartPathA9),
+        std::size(TrackVehicleInfoListMiniGolfBallPathA10),
+        std::size(TrackVehicleInfoListMiniGolfPathB11),
+        std::size(TrackVehicleInfoListMiniGolfBallPathB12),
+        std::size(TrackVehicleInfoListMiniGolfPathC13),
+        std::size(TrackVehicleInfoListMiniGolfPathC14),
+        std::size(TrackVehicleInfoListReverserRCFrontBogie),
+        std::size(TrackVehicleInfoListReverserRCRearBogie),
+    };
+
+    VehicleMoveInfoTable table;
+    std::unordered_map<const rct_vehicle_info_list*, uint32_t> totalsIndex;
+    for (size_t subposition = 0; subposition < VEHICLE_TRACK_SUBPOSITION_COUNT; subposition++)
+    {
+        table.SubpositionStart[subposition] = static_cast<uint32_t>(table.Pieces.size());
+        for (size_t i = 0; i < numPieces[subposition]; i++)
+        {
+            const rct_vehicle_info_list* list = gTrackVehicleInfo[subposition][i];
+            // Many pieces share the same list, their totals only need to be stored once.
+            auto found = totalsIndex.find(list);
+            if (found != totalsIndex.end())
+            {
+                table.Pieces.push_back({ list->info, found->second, list->size });
+                continue;
+            }
+            uint32_t totals = static_cast<uint32_t>(table.Distances.size());
+            totalsIndex.emplace(list, totals);
+            table.Pieces.push_back({ list->info, totals, list->size });
+
+            int32_t distance = 0;
+            int32_t acceleration = 0;
+            for (uint16_t step = 0; step < list->size; step++)
+            {
+                const rct_vehicle_info& info = list->info[step];
+                if (step > 0)
+                {
+                    // The same as the track motion works out from the change in position.
+                    const rct_vehicle_info& prevInfo = list->info[step - 1];
+                    int32_t moved = (info.x != prevInfo.x ? 1 : 0) | (info.y != prevInfo.y ? 2 : 0)
+                        | (info.z != prevInfo.z ? 4 : 0);
+                    distance += dword_9A2930[moved];
+                }
+                table.Distances.push_back(distance);
+                table.Accelerations.push_back(acceleration);
+                acceleration += dword_9A2970[info.vehicle_sprite_type];
+            }
+            table.Distances.push_back(distance);
+            table.Accelerations.push_back(acceleration);
+        }
+    }
+    table.SubpositionStart[VEHICLE_TRACK_SUBPOSITION_COUNT] = static_cast<uint32_t>(table.Pieces.size());
+    return table;
+}
+
+const VehicleMoveInfoTable& vehicle_get_move_info_table()
+{
+    static const VehicleMoveInfoTable table = vehicle_create_move_info_table();
+    return table;
+}
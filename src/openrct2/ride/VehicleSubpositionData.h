@@ -11,7 +11,9 @@
 
 #include "Vehicle.h"
 
+#include <array>
 #include <cstdint>
+#include <vector>
 
 struct rct_vehicle_info_list
 {
@@ -20,3 +22,30 @@ struct rct_vehicle_info_list
 };
 
 extern const rct_vehicle_info_list* const* const gTrackVehicleInfo[17];
+
+/**
+ * The subposition steps of one track type and direction, and where its running totals start in the move info table.
+ */
+struct rct_vehicle_info_piece
+{
+    const rct_vehicle_info* info;
+    uint32_t totals;
+    uint16_t size;
+};
+
+/**
+ * gTrackVehicleInfo flattened into one contiguous list of pieces, with the distance and acceleration the track motion
+ * adds up for every step stored as running totals, so that a run of steps can be moved along at once.
+ */
+struct VehicleMoveInfoTable
+{
+    // Index of the first piece of each subposition, the last one is the number of pieces.
+    std::array<uint32_t, VEHICLE_TRACK_SUBPOSITION_COUNT + 1> SubpositionStart;
+    std::vector<rct_vehicle_info_piece> Pieces;
+    // Each piece has size + 1 entries from its totals index. The distance travelled from the first step to each step.
+    std::vector<int32_t> Distances;
+    // The acceleration of all the steps before each step.
+    std::vector<int32_t> Accelerations;
+};
+
+const VehicleMoveInfoTable& vehicle_get_move_info_table();
@@ -24,6 +24,8 @@
 #include "../world/MapAnimation.h"
 #include "../world/Sprite.h"
 
+#include <future>
+
 using random_engine_t = Random::Rct2::Engine;
 
 struct ParkLoadResult;
@@ -414,6 +416,7 @@ uint32_t scenario_rand_max(uint32_t max);
 
 bool scenario_prepare_for_save();
 int32_t scenario_save(const utf8* path, int32_t flags);
+std::future<bool> scenario_save_in_background(const utf8* path, int32_t flags);
 void scenario_remove_trackless_rides(rct_s6_data* s6);
 void scenario_fix_ghosts(rct_s6_data* s6);
 void scenario_failure();
@@ -55,6 +55,10 @@ namespace OpenRCT2::Scripting
                 ctx, &ScCheats::enableChainLiftOnAllTrack_get, &ScCheats::enableChainLiftOnAllTrack_set,
                 "enableChainLiftOnAllTrack");
             dukglue_register_property(ctx, &ScCheats::fastLiftHill_get, &ScCheats::fastLiftHill_set, "fastLiftHill");
+            dukglue_register_property(
+                ctx, &ScCheats::fastPathfinding_get, &ScCheats::fastPathfinding_set, "fastPathfinding");
+            dukglue_register_property(
+                ctx, &ScCheats::fastRideRatings_get, &ScCheats::fastRideRatings_set, "fastRideRatings");
             dukglue_register_property(ctx, &ScCheats::freezeWeather_get, &ScCheats::freezeWeather_set, "freezeWeather");
             dukglue_register_property(
                 ctx, &ScCheats::ignoreResearchStatus_get, &ScCheats::ignoreResearchStatus_set, "ignoreResearchStatus");
@@ -236,6 +240,28 @@ namespace OpenRCT2::Scripting
             gCheatsFastLiftHill = value;
         }
 
+        bool fastPathfinding_get()
+        {
+            return gCheatsFastPathfinding;
+        }
+
+        void fastPathfinding_set(bool value)
+        {
+            ThrowIfGameStateNotMutable();
+            gCheatsFastPathfinding = value;
+        }
+
+        bool fastRideRatings_get()
+        {
+            return gCheatsFastRideRatings;
+        }
+
+        void fastRideRatings_set(bool value)
+        {
+            ThrowIfGameStateNotMutable();
+            gCheatsFastRideRatings = value;
+        }
+
         bool freezeWeather_get()
         {
             return gCheatsFreezeWeather;
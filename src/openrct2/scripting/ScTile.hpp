@@ -14,7 +14,10 @@
 #    include "../Context.h"
 #    include "../common.h"
 #    include "../core/Guard.hpp"
+#    include "../ride/RideProximity.h"
+#    include "../ride/RideReachability.h"
 #    include "../world/Footpath.h"
+#    include "../world/FootpathGraph.h"
 #    include "../world/Scenery.h"
 #    include "../world/Sprite.h"
 #    include "../world/Surface.h"
@@ -98,6 +101,9 @@ namespace OpenRCT2::Scripting
             }
 
             _element->type = type;
+            ride_proximity_invalidate_tile(_coords);
+            ride_reachability_invalidate_tile(_coords);
+            footpath_graph_invalidate_tile(_coords);
             Invalidate();
         }
 
@@ -109,6 +115,8 @@ namespace OpenRCT2::Scripting
         {
             ThrowIfGameStateNotMutable();
             _element->base_height = newBaseHeight;
+            ride_reachability_invalidate_tile(_coords);
+            footpath_graph_invalidate_tile(_coords);
             Invalidate();
         }
 
@@ -357,6 +365,7 @@ namespace OpenRCT2::Scripting
                 {
                     auto el = _element->AsPath();
                     el->SetRideIndex(value);
+                    footpath_graph_invalidate_tile(_coords);
                     Invalidate();
                     break;
                 }
@@ -364,6 +373,7 @@ namespace OpenRCT2::Scripting
                 {
                     auto el = _element->AsTrack();
                     el->SetRideIndex(value);
+                    ride_proximity_invalidate_tile(_coords);
                     Invalidate();
                     break;
                 }
@@ -721,6 +731,7 @@ namespace OpenRCT2::Scripting
             if (el != nullptr)
             {
                 el->SetEdgesAndCorners(value);
+                footpath_graph_invalidate_tile(_coords);
                 Invalidate();
             }
         }
@@ -754,6 +765,8 @@ namespace OpenRCT2::Scripting
                     el->SetSloped(false);
                     el->SetSlopeDirection(0);
                 }
+                ride_reachability_invalidate_tile(_coords);
+                footpath_graph_invalidate_tile(_coords);
                 Invalidate();
             }
         }
@@ -770,6 +783,7 @@ namespace OpenRCT2::Scripting
             if (el != nullptr)
             {
                 el->SetIsQueue(value);
+                footpath_graph_invalidate_tile(_coords);
                 Invalidate();
             }
         }
@@ -1123,6 +1137,9 @@ namespace OpenRCT2::Scripting
                         first[numElements - 1].SetLastForTile(true);
                     }
                 }
+                ride_proximity_invalidate_tile(_coords);
+                ride_reachability_invalidate_tile(_coords);
+                footpath_graph_invalidate_tile(_coords);
                 map_invalidate_tile_full(_coords);
             }
         }
@@ -0,0 +1,235 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "../common.h"
+#include "../core/Guard.hpp"
+#include "SawyerCoding.h"
+#include "Util.h"
+
+#ifdef __SSE4_1__
+
+#    include <cstring>
+#    include <immintrin.h>
+
+/**
+ * Gets how many of the bytes from src up to end are equal to value, stopping at the first one that is not.
+ */
+static size_t count_equal(const uint8_t* src, const uint8_t* end, uint8_t value)
+{
+    const uint8_t* p = src;
+    const __m128i needle = _mm_set1_epi8(static_cast<char>(value));
+    for (; p + 16 <= end; p += 16)
+    {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const int32_t mismatch = ~_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, needle)) & 0xFFFF;
+        if (mismatch != 0)
+            return (p - src) + bitscanforward(mismatch);
+    }
+    for (; p < end && *p == value; p++)
+    {
+    }
+    return p - src;
+}
+
+/**
+ * Gets the index of the first of the next limit bytes that is equal to the byte after it, limit if there is none. The
+ * byte after the last one is read.
+ */
+static size_t find_pair(const uint8_t* src, size_t limit)
+{
+    size_t i = 0;
+    for (; i + 16 <= limit; i += 16)
+    {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 1));
+        const int32_t pairs = _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, next));
+        if (pairs != 0)
+            return i + bitscanforward(pairs);
+    }
+    for (; i < limit && src[i] != src[i + 1]; i++)
+    {
+    }
+    return i;
+}
+
+size_t sawyercoding_encode_rle_sse4_1(const uint8_t* src_buffer, uint8_t* dst_buffer, size_t length)
+{
+    const uint8_t* src = src_buffer;
+    uint8_t* dst = dst_buffer;
+    const uint8_t* end_src = src + length;
+    size_t count = 0;
+    const uint8_t* src_norm_start = src;
+
+    while (src < end_src - 1)
+    {
+        if ((count && *src == src[1]) || count > 125)
+        {
+            *dst++ = static_cast<uint8_t>(count - 1);
+            std::memcpy(dst, src_norm_start, count);
+            dst += count;
+            src_norm_start += count;
+            count = 0;
+        }
+        if (*src == src[1])
+        {
+            count = count_equal(src, src + std::min<size_t>(125, end_src - src), *src);
+            *dst++ = static_cast<uint8_t>(257 - count);
+            *dst++ = *src;
+            src += count;
+            src_norm_start = src;
+            count = 0;
+        }
+        else
+        {
+            // Take all bytes up to the next pair at once, as long as they fit in this literal run.
+            size_t limit = std::min<size_t>(126 - count, (end_src - 1) - src);
+            size_t n = find_pair(src, limit);
+            count += n;
+            src += n;
+        }
+    }
+    if (src == end_src - 1)
+        count++;
+    if (count)
+    {
+        *dst++ = static_cast<uint8_t>(count - 1);
+        std::memcpy(dst, src_norm_start, count);
+        dst += count;
+    }
+    return dst - dst_buffer;
+}
+
+size_t sawyercoding_encode_repeat_sse4_1(const uint8_t* src_buffer, uint8_t* dst_buffer, size_t length)
+{
+    if (length == 0)
+        return 0;
+
+    uint8_t* dst = dst_buffer;
+    *dst++ = 255;
+    *dst++ = src_buffer[0];
+
+    // Lane l of the 32 candidates holds the run starting 32 - l bytes back, so a run of j + 1 bytes is only allowed in
+    // lanes up to 31 - j or it would overlap the bytes it repeats.
+    __m128i allowedLo[8];
+    __m128i allowedHi[8];
+    for (int32_t j = 0; j < 8; j++)
+    {
+        alignas(16) uint8_t allowed[32];
+        for (int32_t l = 0; l < 32; l++)
+        {
+            allowed[l] = l <= 31 - j ? 0xFF : 0;
+        }
+        allowedLo[j] = _mm_load_si128(reinterpret_cast<const __m128i*>(allowed));
+        allowedHi[j] = _mm_load_si128(reinterpret_cast<const __m128i*>(allowed + 16));
+    }
+
+    for (size_t i = 1; i < length;)
+    {
+        size_t bestRepeatIndex = 0;
+        size_t bestRepeatCount = 0;
+        if (i >= 32 && i + 8 <= length)
+        {
+            const uint8_t* window = src_buffer + i - 32;
+            __m128i matchLo = _mm_set1_epi8(-1);
+            __m128i matchHi = _mm_set1_epi8(-1);
+            for (int32_t j = 0; j < 8; j++)
+            {
+                const __m128i needle = _mm_set1_epi8(static_cast<char>(src_buffer[i + j]));
+                const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(window + j));
+                const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(window + j + 16));
+                matchLo = _mm_and_si128(_mm_and_si128(matchLo, _mm_cmpeq_epi8(lo, needle)), allowedLo[j]);
+                matchHi = _mm_and_si128(_mm_and_si128(matchHi, _mm_cmpeq_epi8(hi, needle)), allowedHi[j]);
+                const int32_t mask = _mm_movemask_epi8(matchLo) | (_mm_movemask_epi8(matchHi) << 16);
+                if (mask == 0)
+                    break;
+                bestRepeatIndex = i - 32 + bitscanforward(mask);
+                bestRepeatCount = j + 1;
+            }
+        }
+        else
+        {
+            bestRepeatCount = sawyercoding_find_repeat(src_buffer, length, i, &bestRepeatIndex);
+        }
+
+        if (bestRepeatCount == 0)
+        {
+            *dst++ = 255;
+            *dst++ = src_buffer[i];
+            i++;
+        }
+        else
+        {
+            *dst++ = static_cast<uint8_t>((bestRepeatCount - 1) | ((32 - (i - bestRepeatIndex)) << 3));
+            i += bestRepeatCount;
+        }
+    }
+    return dst - dst_buffer;
+}
+
+/**
+ * Rotates every byte of the vector left by TShift bits.
+ */
+template<int32_t TShift> static __m128i rotate_bytes(__m128i bytes)
+{
+    const __m128i left = _mm_and_si128(_mm_slli_epi16(bytes, TShift), _mm_set1_epi8(static_cast<char>(0xFF << TShift)));
+    const __m128i right = _mm_and_si128(_mm_srli_epi16(bytes, 8 - TShift), _mm_set1_epi8(0xFF >> (8 - TShift)));
+    return _mm_or_si128(left, right);
+}
+
+void sawyercoding_rotate_sse4_1(uint8_t* dst, const uint8_t* src, size_t length, bool decode)
+{
+    // Every fourth byte is rotated by the same amount, decoding rotates right which is the same as rotating left by the
+    // remaining bits.
+    const __m128i lane0 = _mm_set1_epi32(0x000000FF);
+    const __m128i lane1 = _mm_set1_epi32(0x0000FF00);
+    const __m128i lane2 = _mm_set1_epi32(0x00FF0000);
+    const __m128i lane3 = _mm_set1_epi32(static_cast<int32_t>(0xFF000000));
+    const __m128i mask1 = decode ? lane3 : lane0;
+    const __m128i mask3 = decode ? lane2 : lane1;
+    const __m128i mask5 = decode ? lane1 : lane2;
+    const __m128i mask7 = decode ? lane0 : lane3;
+
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16)
+    {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i result = _mm_and_si128(rotate_bytes<1>(bytes), mask1);
+        result = _mm_or_si128(result, _mm_and_si128(rotate_bytes<3>(bytes), mask3));
+        result = _mm_or_si128(result, _mm_and_si128(rotate_bytes<5>(bytes), mask5));
+        result = _mm_or_si128(result, _mm_and_si128(rotate_bytes<7>(bytes), mask7));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), result);
+    }
+    // The pattern repeats every four bytes, so the rest starts at the beginning of it again.
+    sawyercoding_rotate_scalar(dst + i, src + i, length - i, decode);
+}
+
+#else
+
+#    ifdef OPENRCT2_X86
+#        error You have to compile this file with SSE4.1 enabled, when targetting x86!
+#    endif
+
+size_t sawyercoding_encode_rle_sse4_1(const uint8_t* src_buffer, uint8_t* dst_buffer, size_t length)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+    return 0;
+}
+
+size_t sawyercoding_encode_repeat_sse4_1(const uint8_t* src_buffer, uint8_t* dst_buffer, size_t length)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+    return 0;
+}
+
+void sawyercoding_rotate_sse4_1(uint8_t* dst, const uint8_t* src, size_t length, bool decode)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+}
+
+#endif // __SSE4_1__
@@ -36,14 +36,28 @@ uint32_t sawyercoding_calculate_checksum(const uint8_t* buffer, size_t length)
 }
 
 /**
- *
- *  rct2: 0x006762E1
- *
+ * Gets the largest size data of the given length can grow to when it is RLE encoded.
  */
-size_t sawyercoding_write_chunk_buffer(uint8_t* dst_file, const uint8_t* buffer, sawyercoding_chunk_header chunkHeader)
+static size_t get_max_rle_length(size_t length)
 {
-    uint8_t *encode_buffer, *encode_buffer2;
+    // At worst a single byte followed by a pair of equal bytes, which takes four bytes for three.
+    return length + length / 2 + 2;
+}
 
+// The size of the blocks RLE compressed chunks are encoded in.
+static constexpr size_t RLE_COMPRESSED_BLOCK_SIZE = 64 * 1024;
+
+/**
+ * Encodes the data of a chunk, the encoding and length of chunkHeader are updated for the encoded data. The encoded
+ * data is stored in buffer, tempBuffer is needed for RLE compressed chunks. Both buffers are only ever grown so they
+ * can be reused for all chunks that are written. Encoding needs the encoded chunk and the working buffers of a single
+ * block in memory, never a buffer proportional to the length of the unencoded chunk.
+ * @returns the encoded data, this is src itself for chunks that are not encoded.
+ */
+const uint8_t* sawyercoding_encode_chunk(
+    sawyercoding_chunk_header& chunkHeader, const uint8_t* src, std::vector<uint8_t>& buffer,
+    std::vector<uint8_t>& tempBuffer)
+{
     if (!gUseRLE)
     {
         if (chunkHeader.encoding == CHUNK_ENCODING_RLE || chunkHeader.encoding == CHUNK_ENCODING_RLECOMPRESSED)
@@ -51,48 +65,55 @@ size_t sawyercoding_write_chunk_buffer(uint8_t* dst_file, const uint8_t* buffer,
             chunkHeader.encoding = CHUNK_ENCODING_NONE;
         }
     }
+
+    const size_t length = chunkHeader.length;
     switch (chunkHeader.encoding)
     {
-        case CHUNK_ENCODING_NONE:
-            std::memcpy(dst_file, &chunkHeader, sizeof(sawyercoding_chunk_header));
-            dst_file += sizeof(sawyercoding_chunk_header);
-            std::memcpy(dst_file, buffer, chunkHeader.length);
-            // fwrite(&chunkHeader, sizeof(sawyercoding_chunk_header), 1, file);
-            // fwrite(buffer, 1, chunkHeader.length, file);
-            break;
         case CHUNK_ENCODING_RLE:
-            encode_buffer = static_cast<uint8_t*>(malloc(0x600000));
-            chunkHeader.length = static_cast<uint32_t>(encode_chunk_rle(buffer, encode_buffer, chunkHeader.length));
-            std::memcpy(dst_file, &chunkHeader, sizeof(sawyercoding_chunk_header));
-            dst_file += sizeof(sawyercoding_chunk_header);
-            std::memcpy(dst_file, encode_buffer, chunkHeader.length);
-
-            free(encode_buffer);
-            break;
+            buffer.resize(std::max(buffer.size(), get_max_rle_length(length)));
+            chunkHeader.length = static_cast<uint32_t>(encode_chunk_rle(src, buffer.data(), length));
+            return buffer.data();
         case CHUNK_ENCODING_RLECOMPRESSED:
-            encode_buffer = static_cast<uint8_t*>(malloc(chunkHeader.length * 2));
-            encode_buffer2 = static_cast<uint8_t*>(malloc(0x600000));
-            chunkHeader.length = static_cast<uint32_t>(encode_chunk_repeat(buffer, encode_buffer, chunkHeader.length));
-            chunkHeader.length = static_cast<uint32_t>(encode_chunk_rle(encode_buffer, encode_buffer2, chunkHeader.length));
-            std::memcpy(dst_file, &chunkHeader, sizeof(sawyercoding_chunk_header));
-            dst_file += sizeof(sawyercoding_chunk_header);
-            std::memcpy(dst_file, encode_buffer2, chunkHeader.length);
-
-            free(encode_buffer2);
-            free(encode_buffer);
-            break;
+        {
+            // Encoded a block at a time, so only the encoded data grows with the length of the chunk. Repeats are not
+            // looked for before the start of a block, the encoded blocks decode the same as one encoded whole.
+            size_t encodedLength = 0;
+            for (size_t offset = 0; offset < length; offset += RLE_COMPRESSED_BLOCK_SIZE)
+            {
+                const size_t blockLength = std::min(length - offset, RLE_COMPRESSED_BLOCK_SIZE);
+                // Repeat encoding uses at most two bytes per byte.
+                tempBuffer.resize(std::max(tempBuffer.size(), blockLength * 2));
+                size_t repeatLength = encode_chunk_repeat(src + offset, tempBuffer.data(), blockLength);
+                buffer.resize(std::max(buffer.size(), encodedLength + get_max_rle_length(repeatLength)));
+                encodedLength += encode_chunk_rle(tempBuffer.data(), buffer.data() + encodedLength, repeatLength);
+            }
+            chunkHeader.length = static_cast<uint32_t>(encodedLength);
+            return buffer.data();
+        }
         case CHUNK_ENCODING_ROTATE:
-            encode_buffer = static_cast<uint8_t*>(malloc(chunkHeader.length));
-            std::memcpy(encode_buffer, buffer, chunkHeader.length);
-            encode_chunk_rotate(encode_buffer, chunkHeader.length);
-            std::memcpy(dst_file, &chunkHeader, sizeof(sawyercoding_chunk_header));
-            dst_file += sizeof(sawyercoding_chunk_header);
-            std::memcpy(dst_file, encode_buffer, chunkHeader.length);
-
-            free(encode_buffer);
-            break;
+            buffer.resize(std::max(buffer.size(), length));
+            std::memcpy(buffer.data(), src, length);
+            encode_chunk_rotate(buffer.data(), length);
+            return buffer.data();
+        default:
+            return src;
     }
+}
 
+/**
+ *
+ *  rct2: 0x006762E1
+ *
+ */
+size_t sawyercoding_write_chunk_buffer(uint8_t* dst_file, const uint8_t* buffer, sawyercoding_chunk_header chunkHeader)
+{
+    std::vector<uint8_t> encodeBuffer;
+    std::vector<uint8_t> tempBuffer;
+    const uint8_t* data = sawyercoding_encode_chunk(chunkHeader, buffer, encodeBuffer, tempBuffer);
+
+    std::memcpy(dst_file, &chunkHeader, sizeof(sawyercoding_chunk_header));
+    dst_file += sizeof(sawyercoding_chunk_header);
+    std::memcpy(dst_file, data, chunkHeader.length);
     return chunkHeader.length + sizeof(sawyercoding_chunk_header);
 }
 
@@ -262,11 +283,44 @@ static size_t decode_chunk_rle_with_size(const uint8_t* src_buffer, uint8_t* dst
 
 #pragma region Encoding
 
+static size_t encode_chunk_rle(const uint8_t* src_buffer, uint8_t* dst_buffer, size_t length)
+{
+    static const auto encode = avx2_available()
+        ? sawyercoding_encode_rle_avx2
+        : (sse41_available() ? sawyercoding_encode_rle_sse4_1 : sawyercoding_encode_rle_scalar);
+    return encode(src_buffer, dst_buffer, length);
+}
+
+static size_t encode_chunk_repeat(const uint8_t* src_buffer, uint8_t* dst_buffer, size_t length)
+{
+    static const auto encode = avx2_available()
+        ? sawyercoding_encode_repeat_avx2
+        : (sse41_available() ? sawyercoding_encode_repeat_sse4_1 : sawyercoding_encode_repeat_scalar);
+    return encode(src_buffer, dst_buffer, length);
+}
+
+static void rotate_chunk(uint8_t* dst, const uint8_t* src, size_t length, bool decode)
+{
+    static const auto rotate = avx2_available() ? sawyercoding_rotate_avx2
+                                                : (sse41_available() ? sawyercoding_rotate_sse4_1 : sawyercoding_rotate_scalar);
+    rotate(dst, src, length, decode);
+}
+
+static void encode_chunk_rotate(uint8_t* buffer, size_t length)
+{
+    rotate_chunk(buffer, buffer, length, false);
+}
+
+void sawyercoding_decode_rotate(uint8_t* dst, const uint8_t* src, size_t length)
+{
+    rotate_chunk(dst, src, length, true);
+}
+
 /**
  * Ensure dst_buffer is bigger than src_buffer then resize afterwards
  * returns length of dst_buffer
  */
-static size_t encode_chunk_rle(const uint8_t* src_buffer, uint8_t* dst_buffer, size_t length)
+size_t sawyercoding_encode_rle_scalar(const uint8_t* src_buffer, uint8_t* dst_buffer, size_t length)
 {
     const uint8_t* src = src_buffer;
     uint8_t* dst = dst_buffer;
@@ -314,7 +368,51 @@ static size_t encode_chunk_rle(const uint8_t* src_buffer, uint8_t* dst_buffer, s
     return dst - dst_buffer;
 }
 
-static size_t encode_chunk_repeat(const uint8_t* src_buffer, uint8_t* dst_buffer, size_t length)
+/**
+ * Finds the longest run of up to 8 bytes before index that repeats the bytes at index, the earliest one if there are
+ * several. Runs start at most 32 bytes back and may not overlap the bytes they repeat.
+ * @returns the length of the run, 0 if there is none.
+ */
+size_t sawyercoding_find_repeat(const uint8_t* src, size_t length, size_t index, size_t* repeatIndex)
+{
+    size_t searchIndex = (index < 32) ? 0 : (index - 32);
+    size_t searchEnd = index - 1;
+
+    size_t bestRepeatIndex = 0;
+    size_t bestRepeatCount = 0;
+    for (size_t i = searchIndex; i <= searchEnd; i++)
+    {
+        size_t repeatCount = 0;
+        size_t maxRepeatCount = std::min(std::min(static_cast<size_t>(7), searchEnd - i), length - index - 1);
+        // maxRepeatCount should not exceed length
+        assert(i + maxRepeatCount < length);
+        assert(index + maxRepeatCount < length);
+        for (size_t j = 0; j <= maxRepeatCount; j++)
+        {
+            if (src[i + j] == src[index + j])
+            {
+                repeatCount++;
+            }
+            else
+            {
+                break;
+            }
+        }
+        if (repeatCount > bestRepeatCount)
+        {
+            bestRepeatIndex = i;
+            bestRepeatCount = repeatCount;
+
+            // Maximum repeat count is 8
+            if (repeatCount == 8)
+                break;
+        }
+    }
+    *repeatIndex = bestRepeatIndex;
+    return bestRepeatCount;
+}
+
+size_t sawyercoding_encode_repeat_scalar(const uint8_t* src_buffer, uint8_t* dst_buffer, size_t length)
 {
     if (length == 0)
         return 0;
@@ -329,40 +427,8 @@ static size_t encode_chunk_repeat(const uint8_t* src_buffer, uint8_t* dst_buffer
     // Iterate through remainder of the source buffer
     for (size_t i = 1; i < length;)
     {
-        size_t searchIndex = (i < 32) ? 0 : (i - 32);
-        size_t searchEnd = i - 1;
-
-        size_t bestRepeatIndex = 0;
-        size_t bestRepeatCount = 0;
-        for (size_t repeatIndex = searchIndex; repeatIndex <= searchEnd; repeatIndex++)
-        {
-            size_t repeatCount = 0;
-            size_t maxRepeatCount = std::min(std::min(static_cast<size_t>(7), searchEnd - repeatIndex), length - i - 1);
-            // maxRepeatCount should not exceed length
-            assert(repeatIndex + maxRepeatCount < length);
-            assert(i + maxRepeatCount < length);
-            for (size_t j = 0; j <= maxRepeatCount; j++)
-            {
-                if (src_buffer[repeatIndex + j] == src_buffer[i + j])
-                {
-                    repeatCount++;
-                }
-                else
-                {
-                    break;
-                }
-            }
-            if (repeatCount > bestRepeatCount)
-            {
-                bestRepeatIndex = repeatIndex;
-                bestRepeatCount = repeatCount;
-
-                // Maximum repeat count is 8
-                if (repeatCount == 8)
-                    break;
-            }
-        }
-
+        size_t bestRepeatIndex;
+        size_t bestRepeatCount = sawyercoding_find_repeat(src_buffer, length, i, &bestRepeatIndex);
         if (bestRepeatCount == 0)
         {
             *dst_buffer++ = 255;
@@ -381,13 +447,15 @@ static size_t encode_chunk_repeat(const uint8_t* src_buffer, uint8_t* dst_buffer
     return outLength;
 }
 
-static void encode_chunk_rotate(uint8_t* buffer, size_t length)
+/**
+ * Rotates every byte left by 1, 3, 5 and 7 bits in turn, or right when decoding. dst and src may be the same.
+ */
+void sawyercoding_rotate_scalar(uint8_t* dst, const uint8_t* src, size_t length, bool decode)
 {
-    size_t i;
     uint8_t code = 1;
-    for (i = 0; i < length; i++)
+    for (size_t i = 0; i < length; i++)
     {
-        buffer[i] = rol8(buffer[i], code);
+        dst[i] = decode ? ror8(src[i], code) : rol8(src[i], code);
         code = (code + 2) % 8;
     }
 }
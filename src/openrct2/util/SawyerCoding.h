@@ -12,6 +12,8 @@
 
 #include "../common.h"
 
+#include <vector>
+
 #pragma pack(push, 1)
 struct sawyercoding_chunk_header
 {
@@ -45,6 +47,9 @@ enum
 extern bool gUseRLE;
 
 uint32_t sawyercoding_calculate_checksum(const uint8_t* buffer, size_t length);
+const uint8_t* sawyercoding_encode_chunk(
+    sawyercoding_chunk_header& chunkHeader, const uint8_t* src, std::vector<uint8_t>& buffer,
+    std::vector<uint8_t>& tempBuffer);
 size_t sawyercoding_write_chunk_buffer(uint8_t* dst_file, const uint8_t* src_buffer, sawyercoding_chunk_header chunkHeader);
 size_t sawyercoding_decode_sv4(const uint8_t* src, uint8_t* dst, size_t length, size_t bufferLength);
 size_t sawyercoding_decode_sc4(const uint8_t* src, uint8_t* dst, size_t length, size_t bufferLength);
@@ -56,4 +61,19 @@ int32_t sawyercoding_validate_track_checksum(const uint8_t* src, size_t length);
 int32_t sawyercoding_detect_file_type(const uint8_t* src, size_t length);
 int32_t sawyercoding_detect_rct1_version(int32_t gameVersion);
 
+void sawyercoding_decode_rotate(uint8_t* dst, const uint8_t* src, size_t length);
+
+// The encoding loops have versions for instruction sets that may be available, the fastest one the CPU supports is
+// picked at runtime. All versions produce the same output.
+size_t sawyercoding_encode_rle_scalar(const uint8_t* src, uint8_t* dst, size_t length);
+size_t sawyercoding_encode_rle_sse4_1(const uint8_t* src, uint8_t* dst, size_t length);
+size_t sawyercoding_encode_rle_avx2(const uint8_t* src, uint8_t* dst, size_t length);
+size_t sawyercoding_encode_repeat_scalar(const uint8_t* src, uint8_t* dst, size_t length);
+size_t sawyercoding_encode_repeat_sse4_1(const uint8_t* src, uint8_t* dst, size_t length);
+size_t sawyercoding_encode_repeat_avx2(const uint8_t* src, uint8_t* dst, size_t length);
+size_t sawyercoding_find_repeat(const uint8_t* src, size_t length, size_t index, size_t* repeatIndex);
+void sawyercoding_rotate_scalar(uint8_t* dst, const uint8_t* src, size_t length, bool decode);
+void sawyercoding_rotate_sse4_1(uint8_t* dst, const uint8_t* src, size_t length, bool decode);
+void sawyercoding_rotate_avx2(uint8_t* dst, const uint8_t* src, size_t length, bool decode);
+
 #endif
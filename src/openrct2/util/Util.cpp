@@ -587,14 +587,15 @@ uint8_t* util_zlib_inflate(uint8_t* data, size_t data_in_size, size_t* data_out_
  * @param data Data to be compressed
  * @param data_in_size Size of data to be compressed
  * @param data_out_size Pointer to a variable where output size will be written
+ * @param level Compression level from 1 (fastest) to 9 (smallest), -1 for zlib's default
  * @return Returns a pointer to memory holding compressed data or NULL on failure.
  * @note It is caller's responsibility to free() the returned pointer once done with it.
  */
-uint8_t* util_zlib_deflate(const uint8_t* data, size_t data_in_size, size_t* data_out_size)
+uint8_t* util_zlib_deflate(const uint8_t* data, size_t data_in_size, size_t* data_out_size, int32_t level)
 {
     int32_t ret = Z_OK;
-    uLongf out_size = static_cast<uLongf>(*data_out_size);
     uLong buffer_size = compressBound(static_cast<uLong>(data_in_size));
+    uLongf out_size = buffer_size;
     uint8_t* buffer = static_cast<uint8_t*>(malloc(buffer_size));
     do
     {
@@ -610,7 +611,7 @@ uint8_t* util_zlib_deflate(const uint8_t* data, size_t data_in_size, size_t* dat
             free(buffer);
             return nullptr;
         }
-        ret = compress(buffer, &out_size, data, static_cast<uLong>(data_in_size));
+        ret = compress2(buffer, &out_size, data, static_cast<uLong>(data_in_size), level);
     } while (ret != Z_OK);
     *data_out_size = out_size;
     buffer = static_cast<uint8_t*>(realloc(buffer, *data_out_size));
@@ -22,10 +22,12 @@
 #include "../object/ObjectList.h"
 #include "../object/ObjectManager.h"
 #include "../paint/VirtualFloor.h"
+#include "../ride/RideReachability.h"
 #include "../ride/Station.h"
 #include "../ride/Track.h"
 #include "../ride/TrackData.h"
 #include "../util/Util.h"
+#include "FootpathGraph.h"
 #include "Map.h"
 #include "MapAnimation.h"
 #include "Park.h"
@@ -725,6 +727,9 @@ static bool footpath_reconnect_queue_to_path(
             tileElement->AsPath()->SetEdges(tileElement->AsPath()->GetEdges() | (1 << direction));
             targetQueueElement->SetEdges(targetQueueElement->GetEdges() | (1 << (direction_reverse(direction) & 3)));
         }
+        ride_reachability_invalidate_tile(footpathPos);
+        footpath_graph_invalidate_tile(footpathPos);
+        footpath_graph_invalidate_tile(targetQueuePos);
         if (action != 0)
             map_invalidate_tile_full(targetQueuePos);
         return true;
@@ -901,6 +906,7 @@ static void loc_6A6D7E(
         {
             footpath_disconnect_queue_from_path(targetPos, tileElement, 1 + ((flags >> 6) & 1));
             tileElement->AsPath()->SetEdges(tileElement->AsPath()->GetEdges() | (1 << direction_reverse(direction)));
+            footpath_graph_invalidate_tile(targetPos);
             if (tileElement->AsPath()->IsQueue())
             {
                 footpath_queue_chain_push(tileElement->AsPath()->GetRideIndex());
@@ -919,6 +925,7 @@ loc_6A6FD2:
         if (!query)
         {
             initialTileElement->AsPath()->SetEdges(initialTileElement->AsPath()->GetEdges() | (1 << direction));
+            footpath_graph_invalidate_tile(initialTileElementPos);
             map_invalidate_element(initialTileElementPos, initialTileElement);
         }
     }
@@ -1131,6 +1138,7 @@ void footpath_chain_ride_queue(
             tileElement->AsPath()->SetStationIndex(entranceIndex);
 
             curQueuePos = targetQueuePos;
+            footpath_graph_invalidate_tile(targetQueuePos);
             map_invalidate_element(targetQueuePos, tileElement);
 
             if (lastQueuePathElement == nullptr)
@@ -1878,6 +1886,7 @@ void footpath_update_queue_entrance_banner(const CoordsXY& footpathPos, TileElem
                     }
                 }
                 tileElement->AsPath()->SetRideIndex(RIDE_ID_NULL);
+                footpath_graph_invalidate_tile(footpathPos);
             }
             break;
         case TILE_ELEMENT_TYPE_ENTRANCE:
@@ -1908,6 +1917,7 @@ static void footpath_remove_edges_towards_here(
     tileElement->AsPath()->SetCorners(tileElement->AsPath()->GetCorners() & ~(1 << cd));
     cd = ((cd + 1) & 3);
     tileElement->AsPath()->SetCorners(tileElement->AsPath()->GetCorners() & ~(1 << cd));
+    footpath_graph_invalidate_tile(footpathPos);
     map_invalidate_tile({ footpathPos, tileElement->GetBaseZ(), tileElement->GetClearanceZ() });
 
     if (isQueue)
@@ -2159,7 +2169,10 @@ void footpath_remove_edges_at(const CoordsXY& footpathPos, TileElement* tileElem
     }
 
     if (tileElement->GetType() == TILE_ELEMENT_TYPE_PATH)
+    {
         tileElement->AsPath()->SetEdgesAndCorners(0);
+        footpath_graph_invalidate_tile(footpathPos);
+    }
 }
 
 PathSurfaceEntry* get_path_surface_entry(PathSurfaceIndex entryIndex)
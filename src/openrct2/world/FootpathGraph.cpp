@@ -0,0 +1,523 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "FootpathGraph.h"
+
+#include "../ride/Ride.h"
+#include "../ride/RideData.h"
+#include "../ride/Track.h"
+#include "../util/Util.h"
+#include "Entrance.h"
+#include "Footpath.h"
+#include "Map.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <vector>
+
+// Every path element a guest can walk on is a node, together with everything the pathfinding reads from it. The
+// nodes of a tile are kept in element order so overlaid paths behave the same way as when reading the map.
+struct PathNode
+{
+    uint8_t X;
+    uint8_t Y;
+    uint8_t BaseZ;
+    uint8_t Edges;
+    uint8_t NumEdges;
+    bool IsSloped;
+    Direction SlopeDirection;
+    bool IsQueue;
+    ride_id_t RideIndex;
+
+    bool operator==(const PathNode& other) const
+    {
+        return X == other.X && Y == other.Y && BaseZ == other.BaseZ && Edges == other.Edges && NumEdges == other.NumEdges
+            && IsSloped == other.IsSloped && SlopeDirection == other.SlopeDirection && IsQueue == other.IsQueue
+            && RideIndex == other.RideIndex;
+    }
+};
+
+constexpr int32_t MAP_TILES = MAXIMUM_MAP_SIZE_TECHNICAL;
+constexpr uint32_t NO_DISTANCE = std::numeric_limits<uint32_t>::max();
+constexpr uint32_t NO_TILE = std::numeric_limits<uint32_t>::max();
+
+// Marking more tiles than this between two updates rebuilds the whole graph instead.
+constexpr size_t MAX_DIRTY_TILES = 4096;
+
+static std::vector<PathNode> _nodes;
+static std::vector<uint32_t> _freeNodes;
+static std::vector<std::vector<uint32_t>> _tileNodes;
+static std::vector<TileCoordsXY> _dirtyTiles;
+static bool _allDirty = true;
+static uint32_t _version;
+
+// The tile of every element as of when its tile was last read, so a changed element only marks its own tile dirty.
+// Elements are only moved to other slots by changes that mark their tile dirty as well.
+static std::vector<uint32_t> _elementTiles;
+
+static std::vector<PathNode> _tileScratch;
+static std::vector<uint32_t> _searchQueue;
+
+// The distance from every node to a goal, shared by all peeps heading there until the graph changes.
+struct DistanceField
+{
+    TileCoordsXYZ Goal;
+    ride_id_t QueueRideIndex;
+    bool IgnoreForeignQueues;
+    uint64_t LastUsed;
+    std::vector<uint32_t> Distances;
+};
+
+// Keeping more distance fields than this evicts the least recently used one.
+constexpr size_t MAX_DISTANCE_FIELDS = 64;
+
+static std::vector<DistanceField> _distanceFields;
+static uint64_t _distanceFieldUseCount;
+static FootpathGraphCacheStats _cacheStats;
+
+static std::vector<uint32_t>& GetTileNodes(int32_t x, int32_t y)
+{
+    return _tileNodes[x * MAP_TILES + y];
+}
+
+/**
+ * Gets the edges of a path that guests may leave through, this excludes edges closed by banners placed above the
+ * path but below the next path on the tile.
+ */
+static uint8_t GetGuestPermittedEdges(const TileElement* pathElement)
+{
+    uint8_t edges = pathElement->AsPath()->GetEdgesAndCorners() & 0x0F;
+    for (auto tileElement = pathElement; !tileElement->IsLastForTile();)
+    {
+        tileElement++;
+        if (tileElement->GetType() == TILE_ELEMENT_TYPE_PATH)
+            break;
+        if (tileElement->GetType() == TILE_ELEMENT_TYPE_BANNER)
+            edges &= tileElement->AsBanner()->GetAllowedEdges();
+    }
+    return edges;
+}
+
+static void ReadTileNodes(int32_t x, int32_t y, std::vector<PathNode>& nodes)
+{
+    nodes.clear();
+    auto tileElement = map_get_first_element_at(TileCoordsXY{ x, y }.ToCoordsXY());
+    if (tileElement == nullptr)
+        return;
+    do
+    {
+        _elementTiles[tileElement - gTileElements] = x * MAP_TILES + y;
+        if (tileElement->GetType() != TILE_ELEMENT_TYPE_PATH || tileElement->IsGhost())
+            continue;
+
+        auto pathElement = tileElement->AsPath();
+        PathNode node{};
+        node.X = static_cast<uint8_t>(x);
+        node.Y = static_cast<uint8_t>(y);
+        node.BaseZ = tileElement->base_height;
+        node.Edges = GetGuestPermittedEdges(tileElement);
+        node.NumEdges = static_cast<uint8_t>(bitcount(pathElement->GetEdges()));
+        node.IsSloped = pathElement->IsSloped();
+        node.SlopeDirection = pathElement->GetSlopeDirection();
+        node.IsQueue = pathElement->IsQueue();
+        node.RideIndex = pathElement->GetRideIndex();
+        nodes.push_back(node);
+    } while (!(tileElement++)->IsLastForTile());
+}
+
+/**
+ * Re-reads the nodes of a tile from the map, returns whether they changed.
+ */
+static bool UpdateTile(int32_t x, int32_t y)
+{
+    ReadTileNodes(x, y, _tileScratch);
+
+    auto& tileNodes = GetTileNodes(x, y);
+    if (tileNodes.size() == _tileScratch.size()
+        && std::equal(
+            tileNodes.begin(), tileNodes.end(), _tileScratch.begin(),
+            [](uint32_t index, const PathNode& node) { return _nodes[index] == node; }))
+    {
+        return false;
+    }
+
+    _freeNodes.insert(_freeNodes.end(), tileNodes.begin(), tileNodes.end());
+    tileNodes.clear();
+    for (const auto& node : _tileScratch)
+    {
+        uint32_t index;
+        if (_freeNodes.empty())
+        {
+            index = static_cast<uint32_t>(_nodes.size());
+            _nodes.push_back(node);
+        }
+        else
+        {
+            index = _freeNodes.back();
+            _freeNodes.pop_back();
+            _nodes[index] = node;
+        }
+        tileNodes.push_back(index);
+    }
+    return true;
+}
+
+void footpath_graph_invalidate_all()
+{
+    _allDirty = true;
+    _dirtyTiles.clear();
+}
+
+static void InvalidateTile(const TileCoordsXY& tile)
+{
+    if (_dirtyTiles.size() >= MAX_DIRTY_TILES)
+    {
+        footpath_graph_invalidate_all();
+        return;
+    }
+    _dirtyTiles.push_back(tile);
+}
+
+void footpath_graph_invalidate_tile(const CoordsXY& loc)
+{
+    if (_allDirty || !map_is_location_valid(loc))
+        return;
+
+    InvalidateTile(TileCoordsXY(loc));
+}
+
+/**
+ * Called before an element is removed from its tile. Only removing a path or a banner changes the graph. The tile is
+ * looked up from where the element is stored, elements that have not been read yet are on tiles that are already dirty.
+ */
+void footpath_graph_on_element_removed(const TileElement* tileElement)
+{
+    const auto type = tileElement->GetType();
+    if (type != TILE_ELEMENT_TYPE_PATH && type != TILE_ELEMENT_TYPE_BANNER)
+        return;
+    if (_allDirty || tileElement < gTileElements || tileElement >= gTileElements + MAX_TILE_ELEMENTS_WITH_SPARE_ROOM)
+        return;
+
+    const auto tile = _elementTiles[tileElement - gTileElements];
+    if (tile != NO_TILE)
+    {
+        InvalidateTile({ static_cast<int32_t>(tile / MAP_TILES), static_cast<int32_t>(tile % MAP_TILES) });
+    }
+}
+
+/**
+ * Brings the graph up to date with the map.
+ */
+void footpath_graph_update()
+{
+    if (_tileNodes.empty())
+    {
+        _tileNodes.resize(MAP_TILES * MAP_TILES);
+        _allDirty = true;
+    }
+
+    if (_allDirty)
+    {
+        _nodes.clear();
+        _freeNodes.clear();
+        _elementTiles.assign(MAX_TILE_ELEMENTS_WITH_SPARE_ROOM, NO_TILE);
+        for (int32_t x = 0; x < MAP_TILES; x++)
+        {
+            for (int32_t y = 0; y < MAP_TILES; y++)
+            {
+                GetTileNodes(x, y).clear();
+                UpdateTile(x, y);
+            }
+        }
+        _allDirty = false;
+        _dirtyTiles.clear();
+        _distanceFields.clear();
+        _version++;
+        return;
+    }
+
+    bool changed = false;
+    for (const auto& tile : _dirtyTiles)
+    {
+        changed |= UpdateTile(tile.x, tile.y);
+    }
+    _dirtyTiles.clear();
+
+    if (changed)
+    {
+        _distanceFields.clear();
+        _version++;
+    }
+}
+
+/**
+ * Gets a number that changes every time the connectivity of the paths changes.
+ */
+uint32_t footpath_graph_get_version()
+{
+    footpath_graph_update();
+    return _version;
+}
+
+/**
+ * Gets the height a peep walking off the node in the given direction leaves the tile at.
+ */
+static int32_t GetExitHeight(const PathNode& node, Direction direction)
+{
+    if (node.IsSloped && node.SlopeDirection == direction)
+        return node.BaseZ + 2;
+    return node.BaseZ;
+}
+
+/**
+ * Same as is_valid_path_z_and_direction.
+ */
+static bool CanEnter(const PathNode& node, int32_t z, Direction direction)
+{
+    if (node.IsSloped)
+    {
+        if (node.SlopeDirection == direction)
+            return z == node.BaseZ;
+        if (direction_reverse(node.SlopeDirection) == direction)
+            return z == node.BaseZ + 2;
+        return false;
+    }
+    return z == node.BaseZ;
+}
+
+static bool IsForeignQueue(const PathNode& node, ride_id_t queueRideIndex, bool ignoreForeignQueues)
+{
+    return ignoreForeignQueues && node.IsQueue && node.NumEdges == 2 && node.RideIndex != queueRideIndex
+        && node.RideIndex != RIDE_ID_NULL;
+}
+
+/**
+ * Whether a peep walking onto the goal tile in the given direction at the goal height arrives at a ride entrance,
+ * ride exit, park entrance or shop, the same way the heuristic search recognises them.
+ */
+static bool CanArriveAtGoal(const TileCoordsXYZ& goal, Direction direction)
+{
+    auto tileElement = map_get_first_element_at(goal.ToCoordsXY());
+    if (tileElement == nullptr)
+        return false;
+    do
+    {
+        if (tileElement->IsGhost() || tileElement->base_height != goal.z)
+            continue;
+
+        switch (tileElement->GetType())
+        {
+            case TILE_ELEMENT_TYPE_TRACK:
+            {
+                auto ride = get_ride(tileElement->AsTrack()->GetRideIndex());
+                if (ride != nullptr && ride_type_has_flag(ride->type, RIDE_TYPE_FLAG_IS_SHOP))
+                    return true;
+                break;
+            }
+            case TILE_ELEMENT_TYPE_ENTRANCE:
+                switch (tileElement->AsEntrance()->GetEntranceType())
+                {
+                    case ENTRANCE_TYPE_RIDE_ENTRANCE:
+                    case ENTRANCE_TYPE_RIDE_EXIT:
+                        if (tileElement->GetDirection() == direction)
+                            return true;
+                        break;
+                    case ENTRANCE_TYPE_PARK_ENTRANCE:
+                        return true;
+                }
+                break;
+        }
+    } while (!(tileElement++)->IsLastForTile());
+    return false;
+}
+
+/**
+ * Calculates the fewest steps from every node to the goal by searching the path graph backwards from it. Like the
+ * heuristic search, it does not pass through the queues of other rides.
+ */
+static void BuildDistanceField(DistanceField& field)
+{
+    const auto& goal = field.Goal;
+    auto& distances = field.Distances;
+    distances.assign(_nodes.size(), NO_DISTANCE);
+    _searchQueue.clear();
+
+    for (auto index : GetTileNodes(goal.x, goal.y))
+    {
+        if (_nodes[index].BaseZ == goal.z)
+        {
+            distances[index] = 0;
+            _searchQueue.push_back(index);
+        }
+    }
+    if (_searchQueue.empty())
+    {
+        // The goal is not a path, start from the paths a peep can arrive at it from.
+        for (Direction direction : ALL_DIRECTIONS)
+        {
+            auto previous = TileCoordsXY{ goal.x, goal.y } - TileDirectionDelta[direction];
+            if (!map_is_location_valid(previous.ToCoordsXY()) || !CanArriveAtGoal(goal, direction))
+                continue;
+            for (auto index : GetTileNodes(previous.x, previous.y))
+            {
+                const auto& node = _nodes[index];
+                if (distances[index] == NO_DISTANCE && (node.Edges & (1 << direction))
+                    && !IsForeignQueue(node, field.QueueRideIndex, field.IgnoreForeignQueues)
+                    && GetExitHeight(node, direction) == goal.z)
+                {
+                    distances[index] = 1;
+                    _searchQueue.push_back(index);
+                }
+            }
+        }
+    }
+
+    for (size_t i = 0; i < _searchQueue.size(); i++)
+    {
+        const uint32_t index = _searchQueue[i];
+        const uint32_t distance = distances[index];
+
+        // Look for nodes a peep could walk from onto this one.
+        const PathNode node = _nodes[index];
+        for (Direction direction : ALL_DIRECTIONS)
+        {
+            auto previous = TileCoordsXY{ node.X, node.Y } - TileDirectionDelta[direction];
+            if (!map_is_location_valid(previous.ToCoordsXY()))
+                continue;
+            for (auto previousIndex : GetTileNodes(previous.x, previous.y))
+            {
+                if (distances[previousIndex] != NO_DISTANCE)
+                    continue;
+                const auto& previousNode = _nodes[previousIndex];
+                if (!(previousNode.Edges & (1 << direction)))
+                    continue;
+                if (IsForeignQueue(previousNode, field.QueueRideIndex, field.IgnoreForeignQueues))
+                    continue;
+                if (!CanEnter(node, GetExitHeight(previousNode, direction), direction))
+                    continue;
+                distances[previousIndex] = distance + 1;
+                _searchQueue.push_back(previousIndex);
+            }
+        }
+    }
+}
+
+static const DistanceField& GetDistanceField(const TileCoordsXYZ& goal, ride_id_t queueRideIndex, bool ignoreForeignQueues)
+{
+    _distanceFieldUseCount++;
+    for (auto& field : _distanceFields)
+    {
+        if (field.Goal == goal && field.QueueRideIndex == queueRideIndex && field.IgnoreForeignQueues == ignoreForeignQueues)
+        {
+            field.LastUsed = _distanceFieldUseCount;
+            _cacheStats.Hits++;
+            if (_cacheStats.Misses != 0)
+            {
+                _cacheStats.EstimatedSecondsSaved += _cacheStats.SecondsBuilding / _cacheStats.Misses;
+            }
+            return field;
+        }
+    }
+
+    DistanceField* field;
+    if (_distanceFields.size() < MAX_DISTANCE_FIELDS)
+    {
+        field = &_distanceFields.emplace_back();
+    }
+    else
+    {
+        field = &*std::min_element(_distanceFields.begin(), _distanceFields.end(), [](const auto& a, const auto& b) {
+            return a.LastUsed < b.LastUsed;
+        });
+    }
+    field->Goal = goal;
+    field->QueueRideIndex = queueRideIndex;
+    field->IgnoreForeignQueues = ignoreForeignQueues;
+    field->LastUsed = _distanceFieldUseCount;
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+    BuildDistanceField(*field);
+    auto duration = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - startTime);
+    _cacheStats.Misses++;
+    _cacheStats.SecondsBuilding += duration.count();
+    return *field;
+}
+
+/**
+ * Chooses the direction out of edges that leads to goal in the fewest steps. The distances to the goal are kept for
+ * every peep heading there, so only the first one pays for searching the path graph. Returns INVALID_DIRECTION if the
+ * goal cannot be reached through any of the edges.
+ */
+Direction footpath_graph_choose_direction(
+    const TileCoordsXYZ& loc, uint8_t edges, const TileCoordsXYZ& goal, ride_id_t queueRideIndex, bool ignoreForeignQueues)
+{
+    if (loc == goal || !map_is_location_valid(loc.ToCoordsXY()) || !map_is_location_valid(goal.ToCoordsXY()))
+        return INVALID_DIRECTION;
+
+    footpath_graph_update();
+
+    // Like the heuristic search, the first path at the peep's height decides the slope it leaves on.
+    const PathNode* start = nullptr;
+    for (auto index : GetTileNodes(loc.x, loc.y))
+    {
+        if (_nodes[index].BaseZ == loc.z)
+        {
+            start = &_nodes[index];
+            break;
+        }
+    }
+    if (start == nullptr)
+        return INVALID_DIRECTION;
+
+    // Stepping straight onto a goal that is not a path is not covered by the distances.
+    for (Direction direction : ALL_DIRECTIONS)
+    {
+        if (!(edges & (1 << direction)))
+            continue;
+        auto next = TileCoordsXY{ loc.x, loc.y } + TileDirectionDelta[direction];
+        if (next.x == goal.x && next.y == goal.y && GetExitHeight(*start, direction) == goal.z
+            && CanArriveAtGoal(goal, direction))
+        {
+            return direction;
+        }
+    }
+
+    const auto& distances = GetDistanceField(goal, queueRideIndex, ignoreForeignQueues).Distances;
+    Direction bestDirection = INVALID_DIRECTION;
+    uint32_t bestDistance = NO_DISTANCE;
+    for (Direction direction : ALL_DIRECTIONS)
+    {
+        if (!(edges & (1 << direction)))
+            continue;
+        auto next = TileCoordsXY{ loc.x, loc.y } + TileDirectionDelta[direction];
+        if (!map_is_location_valid(next.ToCoordsXY()))
+            continue;
+        const int32_t z = GetExitHeight(*start, direction);
+        for (auto index : GetTileNodes(next.x, next.y))
+        {
+            if (distances[index] < bestDistance && CanEnter(_nodes[index], z, direction))
+            {
+                bestDistance = distances[index];
+                bestDirection = direction;
+            }
+        }
+    }
+    return bestDirection;
+}
+
+FootpathGraphCacheStats footpath_graph_get_cache_stats()
+{
+    return _cacheStats;
+}
+
+void footpath_graph_reset_cache_stats()
+{
+    _cacheStats = {};
+}
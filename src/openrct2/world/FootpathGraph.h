@@ -0,0 +1,35 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "../ride/RideTypes.h"
+#include "Location.hpp"
+
+struct TileElement;
+
+struct FootpathGraphCacheStats
+{
+    uint64_t Hits;
+    uint64_t Misses;
+    double SecondsBuilding;
+    // Estimated from the average time it took to build a distance field.
+    double EstimatedSecondsSaved;
+};
+
+void footpath_graph_invalidate_all();
+void footpath_graph_invalidate_tile(const CoordsXY& loc);
+void footpath_graph_on_element_removed(const TileElement* tileElement);
+void footpath_graph_update();
+uint32_t footpath_graph_get_version();
+Direction footpath_graph_choose_direction(
+    const TileCoordsXYZ& loc, uint8_t edges, const TileCoordsXYZ& goal, ride_id_t queueRideIndex, bool ignoreForeignQueues);
+FootpathGraphCacheStats footpath_graph_get_cache_stats();
+void footpath_graph_reset_cache_stats();
@@ -262,6 +262,11 @@ struct TileCoordsXY
         return { x + rhs.x, y + rhs.y };
     }
 
+    const TileCoordsXY operator-(const TileCoordsXY& rhs) const
+    {
+        return { x - rhs.x, y - rhs.y };
+    }
+
     TileCoordsXY& operator+=(const TileCoordsXY& rhs)
     {
         x += rhs.x;
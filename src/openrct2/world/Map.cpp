@@ -36,7 +36,10 @@
 #include "../network/network.h"
 #include "../object/ObjectManager.h"
 #include "../object/TerrainSurfaceObject.h"
+#include "../paint/PaintCache.h"
 #include "../ride/RideData.h"
+#include "../ride/RideProximity.h"
+#include "../ride/RideReachability.h"
 #include "../ride/Track.h"
 #include "../ride/TrackData.h"
 #include "../ride/TrackDesign.h"
@@ -46,6 +49,7 @@
 #include "Banner.h"
 #include "Climate.h"
 #include "Footpath.h"
+#include "FootpathGraph.h"
 #include "LargeScenery.h"
 #include "MapAnimation.h"
 #include "Park.h"
@@ -403,6 +407,9 @@ void map_update_tile_pointers()
     }
 
     gNextFreeTileElement = tileElement;
+    ride_proximity_invalidate_all();
+    ride_reachability_invalidate_all();
+    footpath_graph_invalidate_all();
 }
 
 /**
@@ -943,6 +950,10 @@ bool map_is_location_at_edge(const CoordsXY& loc)
  */
 void tile_element_remove(TileElement* tileElement)
 {
+    ride_proximity_on_element_removed(tileElement);
+    ride_reachability_on_element_removed(tileElement);
+    footpath_graph_on_element_removed(tileElement);
+
     // Replace Nth element by (N+1)th element.
     // This loop will make tileElement point to the old last element position,
     // after copy it to it's new position
@@ -982,6 +993,7 @@ void map_remove_all_rides()
                 {
                     it.element->AsPath()->SetHasQueueBanner(false);
                     it.element->AsPath()->SetRideIndex(RIDE_ID_NULL);
+                    footpath_graph_invalidate_tile(TileCoordsXY{ it.x, it.y }.ToCoordsXY());
                 }
                 break;
             case TILE_ELEMENT_TYPE_ENTRANCE:
@@ -1059,6 +1071,8 @@ void map_invalidate_selection_rect()
     bottom += 32;
     top -= 32 + 2080;
 
+    paint_cache_invalidate(left, top, right, bottom);
+
     for (int32_t i = 0; i < MAX_VIEWPORT_COUNT; i++)
     {
         rct_viewport* viewport = &g_viewport_list[i];
@@ -1158,6 +1172,10 @@ TileElement* tile_element_insert(const CoordsXYZ& loc, int32_t occupiedQuadrants
         return nullptr;
     }
 
+    ride_proximity_invalidate_tile(loc);
+    ride_reachability_invalidate_tile(loc);
+    footpath_graph_invalidate_tile(loc);
+
     newTileElement = gNextFreeTileElement;
     originalTileElement = gTileElementTilePointers[tileLoc.y * MAXIMUM_MAP_SIZE_TECHNICAL + tileLoc.x];
 
@@ -2018,9 +2036,6 @@ ScreenCoordsXY translate_3d_to_2d_with_z(int32_t rotation, const CoordsXYZ& pos)
 
 static void map_invalidate_tile_under_zoom(int32_t x, int32_t y, int32_t z0, int32_t z1, int32_t maxZoom)
 {
-    if (gOpenRCT2Headless)
-        return;
-
     int32_t x1, y1, x2, y2;
 
     x += 16;
@@ -2032,6 +2047,12 @@ static void map_invalidate_tile_under_zoom(int32_t x, int32_t y, int32_t z0, int
     x2 = screenCoord.x + 32;
     y2 = screenCoord.y + 32 - z0;
 
+    if (gOpenRCT2Headless)
+        return;
+
+    // Cached paint lists are kept for all zoom levels.
+    paint_cache_invalidate(x1, y1, x2, y2);
+
     for (int32_t i = 0; i < MAX_VIEWPORT_COUNT; i++)
     {
         rct_viewport* viewport = &g_viewport_list[i];
@@ -2100,6 +2121,8 @@ void map_invalidate_region(const CoordsXY& mins, const CoordsXY& maxs)
     bottom += 32;
     top -= 32 + 2080;
 
+    paint_cache_invalidate(left, top, right, bottom);
+
     for (int32_t i = 0; i < MAX_VIEWPORT_COUNT; i++)
     {
         rct_viewport* viewport = &g_viewport_list[i];
@@ -18,12 +18,14 @@
 #include "../interface/Viewport.h"
 #include "../localisation/Date.h"
 #include "../localisation/Localisation.h"
+#include "../paint/PaintCache.h"
 #include "../scenario/Scenario.h"
 #include "Fountain.h"
 
 #include <algorithm>
 #include <cmath>
 #include <iterator>
+#include <vector>
 
 uint16_t gSpriteListHead[SPRITE_LIST_COUNT];
 uint16_t gSpriteListCount[SPRITE_LIST_COUNT];
@@ -33,6 +35,20 @@ static bool _spriteFlashingList[MAX_SPRITES];
 
 uint16_t gSpriteSpatialIndex[SPATIAL_INDEX_SIZE];
 
+// Contiguous copy of each next_in_quadrant chain, in chain order. The chains themselves are kept up to date as they
+// are saved with the park and are part of the sprite checksum, the cells are used for all searches.
+static std::vector<uint16_t> _spriteSpatialCells[SPATIAL_INDEX_SIZE];
+
+// Litter grouped in blocks of 4x4 tiles so handymen and guests only look at the litter around them.
+constexpr int32_t LITTER_CELL_SIZE = 4 * COORDS_XY_STEP;
+constexpr int32_t LITTER_CELLS_PER_AXIS = MAXIMUM_MAP_SIZE_BIG / LITTER_CELL_SIZE;
+static std::vector<uint16_t> _litterCells[LITTER_CELLS_PER_AXIS * LITTER_CELLS_PER_AXIS];
+
+// Increases every time a sprite enters the litter list. The list is ordered newest first, so comparing these gives the
+// same order as walking SPRITE_LIST_LITTER without having to walk it.
+static uint32_t _litterListOrder[MAX_SPRITES];
+static uint32_t _litterListOrderNext;
+
 const rct_string_id litterNames[12] = { STR_LITTER_VOMIT,
                                         STR_LITTER_VOMIT,
                                         STR_SHOP_ITEM_SINGULAR_EMPTY_CAN,
@@ -50,6 +66,8 @@ static CoordsXYZ _spritelocations1[MAX_SPRITES];
 static CoordsXYZ _spritelocations2[MAX_SPRITES];
 
 static size_t GetSpatialIndexOffset(int32_t x, int32_t y);
+static void LitterCellInsert(SpriteBase* sprite);
+static void LitterCellRemove(SpriteBase* sprite);
 static void move_sprite_to_list(SpriteBase* sprite, SPRITE_LIST newListIndex);
 
 template<> bool SpriteBase::Is<Litter>() const
@@ -116,11 +134,26 @@ uint16_t sprite_get_first_in_quadrant(int32_t x, int32_t y)
     return gSpriteSpatialIndex[GetSpatialIndexOffset(x, y)];
 }
 
+/**
+ * Drops the cached paint lists covering the sprite. Unlike viewports, which may skip redrawing sprites at zoom levels
+ * they barely show at, cached cells are kept indefinitely so they are dropped for every zoom level.
+ */
+static void invalidate_sprite_paint_cache(const SpriteBase* sprite)
+{
+    // Sprites move all the time, so don't look for cells when nothing is cached, as always with the cache disabled.
+    if (sprite->sprite_left == LOCATION_NULL || paint_cache_is_empty())
+        return;
+
+    paint_cache_invalidate(sprite->sprite_left, sprite->sprite_top, sprite->sprite_right, sprite->sprite_bottom);
+}
+
 static void invalidate_sprite_max_zoom(SpriteBase* sprite, int32_t maxZoom)
 {
     if (sprite->sprite_left == LOCATION_NULL)
         return;
 
+    invalidate_sprite_paint_cache(sprite);
+
     for (int32_t i = 0; i < MAX_VIEWPORT_COUNT; i++)
     {
         rct_viewport* viewport = &g_viewport_list[i];
@@ -223,6 +256,105 @@ void reset_sprite_spatial_index()
             spr->generic.next_in_quadrant = nextSpriteId;
         }
     }
+    sprite_spatial_rebuild_cells();
+}
+
+/**
+ * Rebuilds the spatial cells and litter cells from the quadrant chains and the litter list.
+ */
+void sprite_spatial_rebuild_cells()
+{
+    for (size_t i = 0; i < SPATIAL_INDEX_SIZE; i++)
+    {
+        auto& cell = _spriteSpatialCells[i];
+        cell.clear();
+
+        // Bounded walk, the chains may still contain cycles when this is called on a loaded park.
+        uint16_t spriteIndex = gSpriteSpatialIndex[i];
+        while (spriteIndex < MAX_SPRITES && cell.size() < MAX_SPRITES)
+        {
+            cell.push_back(spriteIndex);
+            spriteIndex = get_sprite(spriteIndex)->generic.next_in_quadrant;
+        }
+    }
+
+    for (auto& cell : _litterCells)
+    {
+        cell.clear();
+    }
+
+    std::vector<uint16_t> litterList;
+    for (uint16_t spriteIndex = gSpriteListHead[SPRITE_LIST_LITTER];
+         spriteIndex < MAX_SPRITES && litterList.size() < MAX_SPRITES; spriteIndex = get_sprite(spriteIndex)->generic.next)
+    {
+        litterList.push_back(spriteIndex);
+    }
+    _litterListOrderNext = 0;
+    for (auto it = litterList.rbegin(); it != litterList.rend(); it++)
+    {
+        auto sprite = &get_sprite(*it)->generic;
+        _litterListOrder[*it] = ++_litterListOrderNext;
+        LitterCellInsert(sprite);
+    }
+}
+
+static std::vector<uint16_t>* GetLitterCell(int32_t x, int32_t y)
+{
+    if (x < 0 || y < 0 || x >= MAXIMUM_MAP_SIZE_BIG || y >= MAXIMUM_MAP_SIZE_BIG)
+        return nullptr;
+
+    return &_litterCells[(x / LITTER_CELL_SIZE) * LITTER_CELLS_PER_AXIS + (y / LITTER_CELL_SIZE)];
+}
+
+static void LitterCellInsert(SpriteBase* sprite)
+{
+    auto cell = GetLitterCell(sprite->x, sprite->y);
+    if (cell != nullptr)
+    {
+        cell->push_back(sprite->sprite_index);
+    }
+}
+
+static void LitterCellRemove(SpriteBase* sprite)
+{
+    auto cell = GetLitterCell(sprite->x, sprite->y);
+    if (cell != nullptr)
+    {
+        auto it = std::find(cell->begin(), cell->end(), sprite->sprite_index);
+        if (it != cell->end())
+        {
+            *it = cell->back();
+            cell->pop_back();
+        }
+    }
+}
+
+/**
+ * Calls fn for each sprite of the litter list that is inside the given area, in no particular order.
+ */
+template<typename TFunc> static void LitterCellsForEach(const MapRange& range, TFunc fn)
+{
+    const int32_t left = std::max(range.GetLeft(), 0);
+    const int32_t top = std::max(range.GetTop(), 0);
+    const int32_t right = std::min(range.GetRight(), MAXIMUM_MAP_SIZE_BIG - 1);
+    const int32_t bottom = std::min(range.GetBottom(), MAXIMUM_MAP_SIZE_BIG - 1);
+    if (left > right || top > bottom)
+        return;
+
+    for (int32_t cellX = left / LITTER_CELL_SIZE; cellX <= right / LITTER_CELL_SIZE; cellX++)
+    {
+        for (int32_t cellY = top / LITTER_CELL_SIZE; cellY <= bottom / LITTER_CELL_SIZE; cellY++)
+        {
+            for (auto spriteIndex : _litterCells[cellX * LITTER_CELLS_PER_AXIS + cellY])
+            {
+                auto litter = &get_sprite(spriteIndex)->litter;
+                if (litter->x >= left && litter->x <= right && litter->y >= top && litter->y <= bottom)
+                {
+                    fn(litter);
+                }
+            }
+        }
+    }
 }
 
 static size_t GetSpatialIndexOffset(int32_t x, int32_t y)
@@ -476,6 +608,15 @@ static void move_sprite_to_list(SpriteBase* sprite, SPRITE_LIST newListIndex)
         get_sprite(sprite->next)->generic.previous = sprite->previous;
     }
 
+    if (oldListIndex == SPRITE_LIST_LITTER)
+    {
+        LitterCellRemove(sprite);
+    }
+    if (newListIndex == SPRITE_LIST_LITTER)
+    {
+        _litterListOrder[sprite->sprite_index] = ++_litterListOrderNext;
+    }
+
     sprite->previous = SPRITE_INDEX_NULL; // We become the new head of the target list, so there's no previous sprite
     sprite->linked_list_index = newListIndex;
 
@@ -639,45 +780,63 @@ void sprite_misc_update_all()
     }
 }
 
+/**
+ * Points the chain entry in front of position in the cell at nextSpriteIndex.
+ */
+static void SpriteSpatialLink(size_t cellIndex, size_t position, uint16_t nextSpriteIndex)
+{
+    const auto& cell = _spriteSpatialCells[cellIndex];
+    if (position == 0)
+    {
+        gSpriteSpatialIndex[cellIndex] = nextSpriteIndex;
+    }
+    else
+    {
+        get_sprite(cell[position - 1])->generic.next_in_quadrant = nextSpriteIndex;
+    }
+}
+
 // Performs a search to ensure that insert keeps next_in_quadrant in sprite_index order
 static void SpriteSpatialInsert(SpriteBase* sprite, const CoordsXY& newLoc)
 {
     size_t newIndex = GetSpatialIndexOffset(newLoc.x, newLoc.y);
+    auto& cell = _spriteSpatialCells[newIndex];
 
-    auto* next = &gSpriteSpatialIndex[newIndex];
-    while (sprite->sprite_index < *next && *next != SPRITE_INDEX_NULL)
-    {
-        auto sprite2 = &get_sprite(*next)->generic;
-        next = &sprite2->next_in_quadrant;
-    }
+    auto it = std::find_if(
+        cell.begin(), cell.end(), [sprite](uint16_t spriteIndex) { return !(sprite->sprite_index < spriteIndex); });
+    size_t position = std::distance(cell.begin(), it);
+    cell.insert(it, sprite->sprite_index);
 
-    sprite->next_in_quadrant = *next;
-    *next = sprite->sprite_index;
+    sprite->next_in_quadrant = position + 1 < cell.size() ? cell[position + 1] : SPRITE_INDEX_NULL;
+    SpriteSpatialLink(newIndex, position, sprite->sprite_index);
 }
 
-static void SpriteSpatialRemove(SpriteBase* sprite)
+static bool SpriteSpatialUnlink(SpriteBase* sprite)
 {
     size_t currentIndex = GetSpatialIndexOffset(sprite->x, sprite->y);
-    auto* index = &gSpriteSpatialIndex[currentIndex];
+    auto& cell = _spriteSpatialCells[currentIndex];
 
-    // This indicates that the spatial index data is incorrect.
-    if (*index == SPRITE_INDEX_NULL)
+    auto it = std::find(cell.begin(), cell.end(), sprite->sprite_index);
+    if (it == cell.end())
     {
-        log_warning("Bad sprite spatial index. Rebuilding the spatial index...");
-        reset_sprite_spatial_index();
+        return false;
     }
 
-    auto* sprite2 = &get_sprite(*index)->generic;
-    while (sprite != sprite2)
+    size_t position = std::distance(cell.begin(), it);
+    cell.erase(it);
+    SpriteSpatialLink(currentIndex, position, position < cell.size() ? cell[position] : SPRITE_INDEX_NULL);
+    return true;
+}
+
+static void SpriteSpatialRemove(SpriteBase* sprite)
+{
+    if (!SpriteSpatialUnlink(sprite))
     {
-        index = &sprite2->next_in_quadrant;
-        if (*index == SPRITE_INDEX_NULL)
-        {
-            break;
-        }
-        sprite2 = &get_sprite(*index)->generic;
+        // This indicates that the spatial index data is incorrect.
+        log_warning("Bad sprite spatial index. Rebuilding the spatial index...");
+        reset_sprite_spatial_index();
+        SpriteSpatialUnlink(sprite);
     }
-    *index = sprite->next_in_quadrant;
 }
 
 static void SpriteSpatialMove(SpriteBase* sprite, const CoordsXY& newLoc)
@@ -710,8 +869,15 @@ void SpriteBase::MoveTo(const CoordsXYZ& newLocation)
 
     SpriteSpatialMove(this, loc);
 
+    const bool isInLitterList = linked_list_index == SPRITE_LIST_LITTER;
+    if (isInLitterList)
+    {
+        LitterCellRemove(this);
+    }
+
     if (loc.x == LOCATION_NULL)
     {
+        invalidate_sprite_paint_cache(this);
         sprite_left = LOCATION_NULL;
         x = loc.x;
         y = loc.y;
@@ -721,6 +887,11 @@ void SpriteBase::MoveTo(const CoordsXYZ& newLocation)
     {
         sprite_set_coordinates(loc.x, loc.y, loc.z, this);
     }
+
+    if (isInLitterList)
+    {
+        LitterCellInsert(this);
+    }
 }
 
 void sprite_set_coordinates(int16_t x, int16_t y, int16_t z, SpriteBase* sprite)
@@ -728,6 +899,7 @@ void sprite_set_coordinates(int16_t x, int16_t y, int16_t z, SpriteBase* sprite)
     CoordsXYZ coords3d = { x, y, z };
     auto screenCoords = translate_3d_to_2d_with_z(get_current_rotation(), coords3d);
 
+    invalidate_sprite_paint_cache(sprite);
     sprite->sprite_left = screenCoords.x - sprite->sprite_width;
     sprite->sprite_right = screenCoords.x + sprite->sprite_width;
     sprite->sprite_top = screenCoords.y - sprite->sprite_height_negative;
@@ -735,6 +907,7 @@ void sprite_set_coordinates(int16_t x, int16_t y, int16_t z, SpriteBase* sprite)
     sprite->x = x;
     sprite->y = y;
     sprite->z = z;
+    invalidate_sprite_paint_cache(sprite);
 }
 
 /**
@@ -749,18 +922,58 @@ void sprite_remove(SpriteBase* sprite)
         peep->SetName({});
     }
 
+    invalidate_sprite_paint_cache(sprite);
     move_sprite_to_list(sprite, SPRITE_LIST_FREE);
     sprite->sprite_identifier = SPRITE_IDENTIFIER_NULL;
     _spriteFlashingList[sprite->sprite_index] = false;
 
-    size_t quadrantIndex = GetSpatialIndexOffset(sprite->x, sprite->y);
-    uint16_t* spriteIndex = &gSpriteSpatialIndex[quadrantIndex];
-    SpriteBase* quadrantSprite;
-    while (*spriteIndex != SPRITE_INDEX_NULL && (quadrantSprite = &get_sprite(*spriteIndex)->generic) != sprite)
+    SpriteSpatialUnlink(sprite);
+}
+
+std::vector<uint16_t> sprite_query_rect(const MapRange& range)
+{
+    std::vector<uint16_t> result;
+
+    const int32_t left = std::max(range.GetLeft(), 0);
+    const int32_t top = std::max(range.GetTop(), 0);
+    const int32_t right = std::min(range.GetRight(), MAXIMUM_MAP_SIZE_BIG - 1);
+    const int32_t bottom = std::min(range.GetBottom(), MAXIMUM_MAP_SIZE_BIG - 1);
+    if (left > right || top > bottom)
+        return result;
+
+    for (int32_t tileX = left / COORDS_XY_STEP; tileX <= right / COORDS_XY_STEP; tileX++)
     {
-        spriteIndex = &quadrantSprite->next_in_quadrant;
+        for (int32_t tileY = top / COORDS_XY_STEP; tileY <= bottom / COORDS_XY_STEP; tileY++)
+        {
+            const auto& cell = _spriteSpatialCells[GetSpatialIndexOffset(tileX * COORDS_XY_STEP, tileY * COORDS_XY_STEP)];
+            for (auto spriteIndex : cell)
+            {
+                const auto& sprite = get_sprite(spriteIndex)->generic;
+                if (sprite.x >= left && sprite.x <= right && sprite.y >= top && sprite.y <= bottom)
+                {
+                    result.push_back(spriteIndex);
+                }
+            }
+        }
     }
-    *spriteIndex = sprite->next_in_quadrant;
+    return result;
+}
+
+std::vector<uint16_t> sprite_query_radius(const CoordsXY& centre, int32_t radius)
+{
+    auto result = sprite_query_rect({ centre.x - radius, centre.y - radius, centre.x + radius, centre.y + radius });
+    const int64_t radiusSquared = static_cast<int64_t>(radius) * radius;
+    result.erase(
+        std::remove_if(
+            result.begin(), result.end(),
+            [&centre, radiusSquared](uint16_t spriteIndex) {
+                const auto& sprite = get_sprite(spriteIndex)->generic;
+                const int64_t dx = sprite.x - centre.x;
+                const int64_t dy = sprite.y - centre.y;
+                return dx * dx + dy * dy > radiusSquared;
+            }),
+        result.end());
+    return result;
 }
 
 static bool litter_can_be_at(int32_t x, int32_t y, int32_t z)
@@ -868,6 +1081,37 @@ void litter_remove_at(int32_t x, int32_t y, int32_t z)
     }
 }
 
+/**
+ * Finds the litter with the lowest distance to loc, measured as dx + dy + 4 * dz. Litter further away than
+ * maxDistance is ignored. Ties go to the litter that comes first in the litter sprite list.
+ */
+Litter* litter_get_nearest(const CoordsXYZ& loc, int32_t maxDistance)
+{
+    Litter* nearestLitter = nullptr;
+    int32_t nearestLitterDist = maxDistance + 1;
+    uint32_t nearestLitterOrder = 0;
+
+    LitterCellsForEach(
+        { loc.x - maxDistance, loc.y - maxDistance, loc.x + maxDistance, loc.y + maxDistance }, [&](Litter* litter) {
+            int32_t distance = abs(litter->x - loc.x) + abs(litter->y - loc.y) + abs(litter->z - loc.z) * 4;
+            uint32_t order = _litterListOrder[litter->sprite_index];
+            if (distance < nearestLitterDist || (distance == nearestLitterDist && order > nearestLitterOrder))
+            {
+                nearestLitterDist = distance;
+                nearestLitterOrder = order;
+                nearestLitter = litter;
+            }
+        });
+    return nearestLitter;
+}
+
+int32_t litter_count_in_range(const MapRange& range)
+{
+    int32_t count = 0;
+    LitterCellsForEach(range, [&count](Litter*) { count++; });
+    return count;
+}
+
 /**
  * Loops through all sprites, finds floating objects and removes them.
  * Returns the amount of removed objects as feedback.
@@ -1121,10 +1365,15 @@ int32_t check_for_sprite_list_cycles(bool fix)
                     spr->generic.next = SPRITE_INDEX_NULL;
                     cycle_start = spr;
                 }
+                sprite_spatial_rebuild_cells();
             }
             return i;
         }
     }
+    if (fix)
+    {
+        sprite_spatial_rebuild_cells();
+    }
     return -1;
 }
 
@@ -1198,6 +1447,8 @@ int32_t check_for_spatial_index_cycles(bool fix)
                     spr->generic.next_in_quadrant = SPRITE_INDEX_NULL;
                     cycle_start = spr;
                 }
+                // The cells were built from the chain that still had the cycle.
+                sprite_spatial_rebuild_cells();
             }
             return i;
         }
@@ -16,6 +16,8 @@
 #include "Fountain.h"
 #include "SpriteBase.h"
 
+#include <vector>
+
 #define SPRITE_INDEX_NULL 0xFFFF
 #define MAX_SPRITES 10000
 
@@ -206,16 +208,21 @@ rct_sprite* create_sprite(SPRITE_IDENTIFIER spriteIdentifier);
 rct_sprite* create_sprite(SPRITE_IDENTIFIER spriteIdentifier, SPRITE_LIST linkedListIndex);
 void reset_sprite_list();
 void reset_sprite_spatial_index();
+void sprite_spatial_rebuild_cells();
 void sprite_clear_all_unused();
 void sprite_misc_update_all();
 void sprite_set_coordinates(int16_t x, int16_t y, int16_t z, SpriteBase* sprite);
 void sprite_remove(SpriteBase* sprite);
 void litter_create(int32_t x, int32_t y, int32_t z, int32_t direction, int32_t type);
 void litter_remove_at(int32_t x, int32_t y, int32_t z);
+Litter* litter_get_nearest(const CoordsXYZ& loc, int32_t maxDistance);
+int32_t litter_count_in_range(const MapRange& range);
 uint16_t remove_floating_sprites();
 void sprite_misc_explosion_cloud_create(int32_t x, int32_t y, int32_t z);
 void sprite_misc_explosion_flare_create(int32_t x, int32_t y, int32_t z);
 uint16_t sprite_get_first_in_quadrant(int32_t x, int32_t y);
+std::vector<uint16_t> sprite_query_rect(const MapRange& range);
+std::vector<uint16_t> sprite_query_radius(const CoordsXY& centre, int32_t radius);
 void sprite_position_tween_store_a();
 void sprite_position_tween_store_b();
 void sprite_position_tween_all(float nudge);
@@ -17,12 +17,14 @@
 #include "../interface/Window.h"
 #include "../interface/Window_internal.h"
 #include "../localisation/Localisation.h"
+#include "../ride/RideReachability.h"
 #include "../ride/Station.h"
 #include "../ride/Track.h"
 #include "../windows/Intent.h"
 #include "../windows/tile_inspector.h"
 #include "Banner.h"
 #include "Footpath.h"
+#include "FootpathGraph.h"
 #include "LargeScenery.h"
 #include "Map.h"
 #include "Park.h"
@@ -69,6 +71,7 @@ static bool map_swap_elements_at(const CoordsXY& loc, int16_t first, int16_t sec
         secondElement->SetLastForTile(!secondElement->IsLastForTile());
     }
 
+    footpath_graph_invalidate_tile(loc);
     return true;
 }
 
@@ -343,6 +346,8 @@ GameActionResult::Ptr tile_inspector_rotate_element_at(const CoordsXY& loc, int3
             }
         }
 
+        ride_reachability_invalidate_tile(loc);
+        footpath_graph_invalidate_tile(loc);
         map_invalidate_tile_full(loc);
 
         if (static_cast<uint32_t>(loc.x / 32) == windowTileInspectorTileX
@@ -521,6 +526,8 @@ GameActionResult::Ptr tile_inspector_any_base_height_offset(
         tileElement->clearance_height += heightOffset;
 
         map_invalidate_tile_full(loc);
+        ride_reachability_invalidate_tile(loc);
+        footpath_graph_invalidate_tile(loc);
 
         rct_window* const tileInspectorWindow = window_find_by_class(WC_TILE_INSPECTOR);
         if (tileInspectorWindow != nullptr && static_cast<uint32_t>(loc.x / 32) == windowTileInspectorTileX
@@ -677,6 +684,8 @@ GameActionResult::Ptr tile_inspector_path_set_sloped(const CoordsXY& loc, int32_
     {
         pathElement->AsPath()->SetSloped(sloped);
 
+        ride_reachability_invalidate_tile(loc);
+        footpath_graph_invalidate_tile(loc);
         map_invalidate_tile_full(loc);
 
         rct_window* const tileInspectorWindow = window_find_by_class(WC_TILE_INSPECTOR);
@@ -727,6 +736,7 @@ GameActionResult::Ptr tile_inspector_path_toggle_edge(
         uint8_t newEdges = pathElement->AsPath()->GetEdgesAndCorners() ^ (1 << edgeIndex);
         pathElement->AsPath()->SetEdgesAndCorners(newEdges);
 
+        footpath_graph_invalidate_tile(loc);
         map_invalidate_tile_full(loc);
 
         rct_window* const tileInspectorWindow = window_find_by_class(WC_TILE_INSPECTOR);
@@ -1157,6 +1167,7 @@ GameActionResult::Ptr tile_inspector_banner_toggle_blocking_edge(
         uint8_t edges = bannerElement->AsBanner()->GetAllowedEdges();
         edges ^= (1 << edgeIndex);
         bannerElement->AsBanner()->SetAllowedEdges(edges);
+        footpath_graph_invalidate_tile(loc);
 
         if (static_cast<uint32_t>(loc.x / 32) == windowTileInspectorTileX
             && static_cast<uint32_t>(loc.y / 32) == windowTileInspectorTileY)
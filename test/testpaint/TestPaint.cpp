@@ -44,6 +44,10 @@ namespace TestPaint
         dpi.zoom_level = 1;
         RCT2_Unk140E9A8 = &dpi;
         gPaintSession.DPI = dpi;
+        // Start over from the first paint struct of the default arena.
+        gPaintSession.PaintStructArena = nullptr;
+        gPaintSession.NextFreePaintStruct = nullptr;
+        gPaintSession.EndOfPaintStructArray = nullptr;
 
         {
             static rct_ride_entry rideEntry = {};
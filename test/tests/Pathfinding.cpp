@@ -5,12 +5,14 @@
 #include "openrct2/scenario/Scenario.h"
 
 #include <gtest/gtest.h>
+#include <openrct2/Cheats.h>
 #include <openrct2/Context.h>
 #include <openrct2/Game.h>
 #include <openrct2/OpenRCT2.h>
 #include <openrct2/ParkImporter.h>
 #include <openrct2/platform/platform.h>
 #include <openrct2/world/Footpath.h>
+#include <openrct2/world/FootpathGraph.h>
 #include <openrct2/world/Map.h>
 
 using namespace OpenRCT2;
@@ -63,7 +65,9 @@ protected:
         return nullptr;
     }
 
-    static bool FindPath(TileCoordsXYZ* pos, const TileCoordsXYZ& goal, int expectedSteps, int targetRideID)
+    static bool FindPath(
+        TileCoordsXYZ* pos, const TileCoordsXYZ& goal, int expectedSteps, int targetRideID, bool exactSteps = true,
+        int* stepsTaken = nullptr)
     {
         // Our start position is in tile coordinates, but we need to give the peep spawn
         // position in actual world coords (32 units per tile X/Y, 8 per Z level).
@@ -126,7 +130,14 @@ protected:
         // such a change in the number of steps taken on one of these paths needs to be reviewed. For the negative
         // tests, we will not have reached the goal but we still expect the loop to have run for the total number
         // of steps requested before giving up.
-        EXPECT_EQ(step, expectedSteps);
+        if (exactSteps)
+        {
+            EXPECT_EQ(step, expectedSteps);
+        }
+        if (stepsTaken != nullptr)
+        {
+            *stepsTaken = step;
+        }
 
         return *pos == goal;
     }
@@ -211,17 +222,97 @@ TEST_P(SimplePathfindingTest, CanFindPathFromStartToGoal)
     EXPECT_TRUE(succeeded);
 }
 
+static const SimplePathfindingScenario SimplePathfindingScenarios[] = {
+    SimplePathfindingScenario("StraightFlat", { 19, 15, 14 }, 24),
+    SimplePathfindingScenario("SBend", { 15, 12, 14 }, 88),
+    SimplePathfindingScenario("UBend", { 17, 9, 14 }, 86),
+    SimplePathfindingScenario("CBend", { 14, 5, 14 }, 164),
+    SimplePathfindingScenario("TwoEqualRoutes", { 9, 13, 14 }, 87),
+    SimplePathfindingScenario("TwoUnequalRoutes", { 3, 13, 14 }, 87),
+    SimplePathfindingScenario("StraightUpBridge", { 12, 15, 14 }, 24),
+    SimplePathfindingScenario("StraightUpSlope", { 14, 15, 14 }, 24),
+    SimplePathfindingScenario("SelfCrossingPath", { 6, 5, 14 }, 213),
+};
+
 INSTANTIATE_TEST_CASE_P(
-    ForScenario, SimplePathfindingTest,
-    ::testing::Values(
-        SimplePathfindingScenario("StraightFlat", { 19, 15, 14 }, 24), SimplePathfindingScenario("SBend", { 15, 12, 14 }, 88),
-        SimplePathfindingScenario("UBend", { 17, 9, 14 }, 86), SimplePathfindingScenario("CBend", { 14, 5, 14 }, 164),
-        SimplePathfindingScenario("TwoEqualRoutes", { 9, 13, 14 }, 87),
-        SimplePathfindingScenario("TwoUnequalRoutes", { 3, 13, 14 }, 87),
-        SimplePathfindingScenario("StraightUpBridge", { 12, 15, 14 }, 24),
-        SimplePathfindingScenario("StraightUpSlope", { 14, 15, 14 }, 24),
-        SimplePathfindingScenario("SelfCrossingPath", { 6, 5, 14 }, 213)),
-    SimplePathfindingScenario::ToName);
+    ForScenario, SimplePathfindingTest, ::testing::ValuesIn(SimplePathfindingScenarios), SimplePathfindingScenario::ToName);
+
+class FastPathfindingTest : public SimplePathfindingTest
+{
+public:
+    void SetUp() override
+    {
+        SimplePathfindingTest::SetUp();
+        gCheatsFastPathfinding = true;
+    }
+
+    void TearDown() override
+    {
+        gCheatsFastPathfinding = false;
+        SimplePathfindingTest::TearDown();
+    }
+};
+
+TEST_P(FastPathfindingTest, FindsPathNoLongerThanHeuristicSearch)
+{
+    const SimplePathfindingScenario& scenario = GetParam();
+
+    ASSERT_PRED_FORMAT1(AssertIsStartPosition, scenario.start);
+    TileCoordsXYZ pos = scenario.start;
+
+    auto ride = FindRideByName(scenario.name);
+    ASSERT_NE(ride, nullptr);
+
+    auto entrancePos = ride_get_entrance_location(ride, 0);
+    TileCoordsXYZ goal = TileCoordsXYZ(
+        entrancePos.x - TileDirectionDelta[entrancePos.direction].x,
+        entrancePos.y - TileDirectionDelta[entrancePos.direction].y, entrancePos.z);
+
+    // Walk the same path with the heuristic search first.
+    gCheatsFastPathfinding = false;
+    int heuristicSteps = 0;
+    ASSERT_TRUE(FindPath(&pos, goal, scenario.steps, ride->id, true, &heuristicSteps));
+
+    gCheatsFastPathfinding = true;
+    scenario_rand_seed(0x12345678, 0x87654321);
+    pos = scenario.start;
+    int fastSteps = 0;
+    EXPECT_TRUE(FindPath(&pos, goal, scenario.steps, ride->id, false, &fastSteps))
+        << "Failed to find path from " << scenario.start << " to " << goal << " in " << scenario.steps << " steps; reached "
+        << pos << " before giving up.";
+
+    // The shortest route is never longer than the one the heuristic search finds.
+    EXPECT_LE(fastSteps, heuristicSteps);
+}
+
+TEST_P(FastPathfindingTest, ReusesDistancesForSameGoal)
+{
+    const SimplePathfindingScenario& scenario = GetParam();
+
+    auto ride = FindRideByName(scenario.name);
+    ASSERT_NE(ride, nullptr);
+
+    auto entrancePos = ride_get_entrance_location(ride, 0);
+    TileCoordsXYZ goal = TileCoordsXYZ(
+        entrancePos.x - TileDirectionDelta[entrancePos.direction].x,
+        entrancePos.y - TileDirectionDelta[entrancePos.direction].y, entrancePos.z);
+
+    // Rebuilding the graph drops the distances kept by earlier tests.
+    footpath_graph_invalidate_all();
+    footpath_graph_update();
+    footpath_graph_reset_cache_stats();
+    auto firstDirection = footpath_graph_choose_direction(scenario.start, 0x0F, goal, ride->id, true);
+    auto secondDirection = footpath_graph_choose_direction(scenario.start, 0x0F, goal, ride->id, true);
+    auto stats = footpath_graph_get_cache_stats();
+
+    EXPECT_NE(firstDirection, INVALID_DIRECTION);
+    EXPECT_EQ(firstDirection, secondDirection);
+    EXPECT_EQ(stats.Misses, 1u);
+    EXPECT_EQ(stats.Hits, 1u);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    ForScenario, FastPathfindingTest, ::testing::ValuesIn(SimplePathfindingScenarios), SimplePathfindingScenario::ToName);
 
 class ImpossiblePathfindingTest : public PathfindingTestBase, public ::testing::WithParamInterface<SimplePathfindingScenario>
 {
@@ -10,6 +10,7 @@
 #include "TestData.h"
 
 #include <gtest/gtest.h>
+#include <openrct2/Cheats.h>
 #include <openrct2/Context.h>
 #include <openrct2/Game.h>
 #include <openrct2/OpenRCT2.h>
@@ -19,6 +20,8 @@
 #include <openrct2/core/String.hpp>
 #include <openrct2/platform/platform.h>
 #include <openrct2/ride/Ride.h>
+#include <openrct2/ride/RideRatings.h>
+#include <memory>
 #include <string>
 
 using namespace OpenRCT2;
@@ -26,6 +29,32 @@ using namespace OpenRCT2;
 class RideRatings : public testing::Test
 {
 protected:
+    std::unique_ptr<IContext> _context;
+
+    void SetUp() override
+    {
+        std::string path = TestData::GetParkPath("bpb.sv6");
+
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = true;
+
+        core_init();
+        _context = CreateContext();
+        bool initialised = _context->Initialise();
+        ASSERT_TRUE(initialised);
+
+        load_from_sv6(path.c_str());
+
+        // Check ride count to check load was successful
+        ASSERT_EQ(ride_get_count(), 134);
+    }
+
+    void TearDown() override
+    {
+        gCheatsFastRideRatings = false;
+        _context = nullptr;
+    }
+
     void CalculateRatingsForAllRides()
     {
         for (const auto& ride : GetRideManager())
@@ -51,39 +80,52 @@ protected:
             (int)ratings.nausea);
         return line;
     }
-};
-
-TEST_F(RideRatings, all)
-{
-    std::string path = TestData::GetParkPath("bpb.sv6");
-
-    gOpenRCT2Headless = true;
-    gOpenRCT2NoGraphics = true;
 
-    core_init();
-    auto context = CreateContext();
-    bool initialised = context->Initialise();
-    ASSERT_TRUE(initialised);
+    void CheckRatings(const std::string& expectedFileName)
+    {
+        // Load expected ratings
+        auto expectedDataPath = Path::Combine(TestData::GetBasePath(), "ratings", expectedFileName);
+        auto expectedRatings = File::ReadAllLines(expectedDataPath);
 
-    load_from_sv6(path.c_str());
+        // Check ride ratings
+        int expI = 0;
+        for (const auto& ride : GetRideManager())
+        {
+            auto actual = FormatRatings(ride);
+            auto expected = expectedRatings[expI];
+            ASSERT_STREQ(actual.c_str(), expected.c_str());
 
-    // Check ride count to check load was successful
-    ASSERT_EQ(ride_get_count(), 134);
+            expI++;
+        }
+    }
+};
 
+TEST_F(RideRatings, all)
+{
     CalculateRatingsForAllRides();
+    CheckRatings("bpb.sv6.txt");
+}
 
-    // Load expected ratings
-    auto expectedDataPath = Path::Combine(TestData::GetBasePath(), "ratings", "bpb.sv6.txt");
-    auto expectedRatings = File::ReadAllLines(expectedDataPath);
-
-    // Check ride ratings
-    int expI = 0;
-    for (const auto& ride : GetRideManager())
+TEST_F(RideRatings, fast_ride_ratings)
+{
+    // Clear the ratings stored in the park, so only rides rated by the batches can match. Closed rides are never rated.
+    for (auto& ride : GetRideManager())
     {
-        auto actual = FormatRatings(ride);
-        auto expected = expectedRatings[expI];
-        ASSERT_STREQ(actual.c_str(), expected.c_str());
+        if (ride.status != RIDE_STATUS_CLOSED)
+        {
+            ride.ratings.excitement = RIDE_RATING_UNDEFINED;
+            ride.ratings.intensity = RIDE_RATING_UNDEFINED;
+            ride.ratings.nausea = RIDE_RATING_UNDEFINED;
+        }
+    }
 
-        expI++;
+    // Several rides are rated every tick, more than enough ticks to go round all of them.
+    gCheatsFastRideRatings = true;
+    for (int32_t i = 0; i < 32; i++)
+    {
+        ride_ratings_update_all();
     }
+
+    // The same ratings as the rides being rated one after the other.
+    CheckRatings("bpb.sv6.txt");
 }
@@ -29,6 +29,7 @@
 #include <openrct2/ride/Ride.h>
 #include <openrct2/world/Park.h>
 #include <openrct2/world/Sprite.h>
+#include <cstring>
 #include <stdio.h>
 #include <string>
 
@@ -566,3 +567,75 @@ TEST(S6ImportExportAdvanceTicks, all)
 
     SUCCEED();
 }
+
+// Puts the parallel park loading option back when the test ends, also when an assertion returns early.
+struct ParallelParkLoadingRestorer
+{
+    const bool ParallelParkLoading = gConfigGeneral.parallel_park_loading;
+
+    ~ParallelParkLoadingRestorer()
+    {
+        gConfigGeneral.parallel_park_loading = ParallelParkLoading;
+    }
+};
+
+TEST(S6ImportExportParallelLoad, all)
+{
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    core_init();
+
+    MemoryStream importBuffer;
+    MemoryStream serialExportBuffer;
+    MemoryStream parallelExportBuffer;
+
+    std::unique_ptr<GameState_t> serialState;
+    std::unique_ptr<GameState_t> parallelState;
+
+    ParallelParkLoadingRestorer parallelParkLoadingRestorer;
+
+    std::string testParkPath = TestData::GetParkPath("BigMapTest.sv6");
+    ASSERT_TRUE(LoadFileToBuffer(importBuffer, testParkPath));
+
+    // Load the park with the chunks decoded one after another.
+    {
+        std::unique_ptr<IContext> context = CreateContext();
+        EXPECT_NE(context, nullptr);
+
+        bool initialised = context->Initialise();
+        ASSERT_TRUE(initialised);
+
+        gConfigGeneral.parallel_park_loading = false;
+        ASSERT_TRUE(ImportSave(importBuffer, context, false));
+        serialState = GetGameState(context);
+        ASSERT_NE(serialState, nullptr);
+
+        ASSERT_TRUE(ExportSave(serialExportBuffer, context));
+    }
+
+    // Load the same park with the chunks decoded in parallel.
+    {
+        std::unique_ptr<IContext> context = CreateContext();
+        EXPECT_NE(context, nullptr);
+
+        bool initialised = context->Initialise();
+        ASSERT_TRUE(initialised);
+
+        gConfigGeneral.parallel_park_loading = true;
+        ASSERT_TRUE(ImportSave(importBuffer, context, false));
+        parallelState = GetGameState(context);
+        ASSERT_NE(parallelState, nullptr);
+
+        ASSERT_TRUE(ExportSave(parallelExportBuffer, context));
+    }
+
+    CompareStates(serialExportBuffer, parallelExportBuffer, serialState, parallelState);
+
+    // Both loads have to result in exactly the same park.
+    ASSERT_EQ(serialExportBuffer.GetLength(), parallelExportBuffer.GetLength());
+    ASSERT_EQ(
+        std::memcmp(serialExportBuffer.GetData(), parallelExportBuffer.GetData(), serialExportBuffer.GetLength()), 0);
+
+    SUCCEED();
+}
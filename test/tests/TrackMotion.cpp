@@ -0,0 +1,128 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2020 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TestData.h"
+
+#include <gtest/gtest.h>
+#include <openrct2/Context.h>
+#include <openrct2/Game.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/platform/platform.h>
+#include <openrct2/ride/Vehicle.h>
+#include <openrct2/world/Sprite.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace OpenRCT2;
+
+struct CarState
+{
+    uint16_t SpriteIndex;
+    CoordsXYZ Position;
+    CoordsXYZ TrackLocation;
+    int16_t TrackType;
+    uint16_t TrackProgress;
+    uint8_t TrackSubposition;
+    int32_t RemainingDistance;
+    int32_t Velocity;
+    int32_t Acceleration;
+};
+
+static bool operator==(const CarState& a, const CarState& b)
+{
+    return a.SpriteIndex == b.SpriteIndex && a.Position == b.Position && a.TrackLocation == b.TrackLocation
+        && a.TrackType == b.TrackType && a.TrackProgress == b.TrackProgress && a.TrackSubposition == b.TrackSubposition
+        && a.RemainingDistance == b.RemainingDistance && a.Velocity == b.Velocity && a.Acceleration == b.Acceleration;
+}
+
+static std::ostream& operator<<(std::ostream& os, const CarState& car)
+{
+    return os << "car " << car.SpriteIndex << " at (" << car.Position.x << ", " << car.Position.y << ", " << car.Position.z
+              << ") track type " << car.TrackType << " progress " << car.TrackProgress << " subposition "
+              << static_cast<int32_t>(car.TrackSubposition) << " remaining distance " << car.RemainingDistance
+              << " velocity " << car.Velocity << " acceleration " << car.Acceleration;
+}
+
+class TrackMotion : public testing::Test
+{
+protected:
+    static constexpr int32_t NumTicks = 2000;
+
+    std::unique_ptr<IContext> _context;
+
+    void SetUp() override
+    {
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = true;
+
+        core_init();
+        _context = CreateContext();
+        bool initialised = _context->Initialise();
+        ASSERT_TRUE(initialised);
+    }
+
+    void TearDown() override
+    {
+        gVehicleSkipTrackSubpositions = true;
+        _context = nullptr;
+    }
+
+    static std::vector<CarState> GetCars()
+    {
+        std::vector<CarState> cars;
+        for (uint16_t spriteIndex = gSpriteListHead[SPRITE_LIST_VEHICLE]; spriteIndex != SPRITE_INDEX_NULL;)
+        {
+            const Vehicle* vehicle = GET_VEHICLE(spriteIndex);
+            cars.push_back({ vehicle->sprite_index, { vehicle->x, vehicle->y, vehicle->z }, vehicle->TrackLocation,
+                             vehicle->track_type, vehicle->track_progress, vehicle->TrackSubposition,
+                             vehicle->remaining_distance, vehicle->velocity, vehicle->acceleration });
+            spriteIndex = vehicle->next;
+        }
+        return cars;
+    }
+
+    /**
+     * Loads the park and moves all its trains for a number of ticks, then returns where every car ended up.
+     */
+    static std::vector<CarState> DriveCars(const std::string& parkFileName, bool skipSubpositions)
+    {
+        load_from_sv6(parkFileName.c_str());
+        gVehicleSkipTrackSubpositions = skipSubpositions;
+        for (int32_t i = 0; i < NumTicks; i++)
+        {
+            vehicle_update_all();
+        }
+        return GetCars();
+    }
+};
+
+TEST_F(TrackMotion, skipping_subpositions_matches_stepping)
+{
+    std::string path = TestData::GetParkPath("bpb.sv6");
+
+    load_from_sv6(path.c_str());
+    auto startCars = GetCars();
+    ASSERT_FALSE(startCars.empty());
+
+    auto steppedCars = DriveCars(path, false);
+    auto skippedCars = DriveCars(path, true);
+    ASSERT_EQ(steppedCars.size(), skippedCars.size());
+
+    size_t numMoved = 0;
+    for (size_t i = 0; i < steppedCars.size(); i++)
+    {
+        ASSERT_EQ(steppedCars[i], skippedCars[i]);
+        if (i < startCars.size() && !(startCars[i] == steppedCars[i]))
+        {
+            numMoved++;
+        }
+    }
+    ASSERT_GT(numMoved, 0U);
+}
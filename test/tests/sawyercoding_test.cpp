@@ -7,10 +7,16 @@
  * OpenRCT2 is licensed under the GNU General Public License version 3.
  *****************************************************************************/
 
+#include <algorithm>
+#include <cstring>
 #include <gtest/gtest.h>
 #include <openrct2/core/MemoryStream.h>
 #include <openrct2/rct12/SawyerChunkReader.h>
 #include <openrct2/util/SawyerCoding.h>
+#include <openrct2/util/Util.h>
+#include <random>
+#include <string>
+#include <vector>
 
 constexpr size_t BUFFER_SIZE = 0x600000;
 
@@ -106,6 +112,220 @@ TEST_F(SawyerCodingTest, decode_chunk_rotate)
     test_decode(rotatedata, sizeof(rotatedata));
 }
 
+using EncodeFunction = size_t (*)(const uint8_t*, uint8_t*, size_t);
+using RotateFunction = void (*)(uint8_t*, const uint8_t*, size_t, bool);
+
+struct EncodeVersion
+{
+    const char* Name;
+    EncodeFunction EncodeRLE;
+    EncodeFunction EncodeRepeat;
+    RotateFunction Rotate;
+};
+
+static std::vector<EncodeVersion> get_encode_versions()
+{
+    std::vector<EncodeVersion> versions;
+    versions.push_back(
+        { "scalar", sawyercoding_encode_rle_scalar, sawyercoding_encode_repeat_scalar, sawyercoding_rotate_scalar });
+    if (sse41_available())
+    {
+        versions.push_back(
+            { "sse4_1", sawyercoding_encode_rle_sse4_1, sawyercoding_encode_repeat_sse4_1, sawyercoding_rotate_sse4_1 });
+    }
+    if (avx2_available())
+    {
+        versions.push_back({ "avx2", sawyercoding_encode_rle_avx2, sawyercoding_encode_repeat_avx2, sawyercoding_rotate_avx2 });
+    }
+    return versions;
+}
+
+/**
+ * Makes data that looks a bit like a park, runs of the same byte, repeated sequences and noise mixed together.
+ */
+static std::vector<uint8_t> make_fuzz_data(std::mt19937& rng, size_t length)
+{
+    std::vector<uint8_t> data(length);
+    std::uniform_int_distribution<int> byteDist(0, 255);
+    std::uniform_int_distribution<int> kindDist(0, 3);
+    std::uniform_int_distribution<size_t> runDist(1, 300);
+    size_t i = 0;
+    while (i < length)
+    {
+        size_t runLength = std::min(runDist(rng), length - i);
+        switch (kindDist(rng))
+        {
+            case 0:
+                std::fill_n(data.begin() + i, runLength, static_cast<uint8_t>(byteDist(rng)));
+                break;
+            case 1:
+                if (i > 0)
+                {
+                    size_t distance = std::uniform_int_distribution<size_t>(1, std::min<size_t>(i, 40))(rng);
+                    for (size_t j = 0; j < runLength; j++)
+                    {
+                        data[i + j] = data[i + j - distance];
+                    }
+                    break;
+                }
+                [[fallthrough]];
+            case 2:
+                for (size_t j = 0; j < runLength; j++)
+                {
+                    data[i + j] = static_cast<uint8_t>(byteDist(rng) & 3);
+                }
+                break;
+            default:
+                for (size_t j = 0; j < runLength; j++)
+                {
+                    data[i + j] = static_cast<uint8_t>(byteDist(rng));
+                }
+                break;
+        }
+        i += runLength;
+    }
+    return data;
+}
+
+static void test_round_trip(const std::vector<uint8_t>& data, uint8_t encoding)
+{
+    sawyercoding_chunk_header header;
+    header.encoding = encoding;
+    header.length = static_cast<uint32_t>(data.size());
+    std::vector<uint8_t> encoded(sizeof(sawyercoding_chunk_header) + data.size() * 3 + 16);
+    size_t encodedLength = sawyercoding_write_chunk_buffer(encoded.data(), data.data(), header);
+
+    MemoryStream ms(encoded.data(), encodedLength);
+    SawyerChunkReader reader(&ms);
+    auto chunk = reader.ReadChunk();
+    ASSERT_EQ(chunk->GetLength(), data.size());
+    ASSERT_EQ(std::memcmp(chunk->GetData(), data.data(), data.size()), 0);
+}
+
+TEST_F(SawyerCodingTest, fuzz_encode_versions_match)
+{
+    auto versions = get_encode_versions();
+    std::mt19937 rng(0x5A3E);
+    for (size_t iteration = 0; iteration < 400; iteration++)
+    {
+        size_t length = iteration < 100 ? iteration + 1 : std::uniform_int_distribution<size_t>(100, 20000)(rng);
+        auto data = make_fuzz_data(rng, length);
+
+        std::vector<uint8_t> expected(length * 2 + 16);
+        std::vector<uint8_t> actual(length * 2 + 16);
+        const auto& scalar = versions[0];
+        for (const auto& version : versions)
+        {
+            SCOPED_TRACE(std::string(version.Name) + " length " + std::to_string(length));
+
+            size_t expectedLength = scalar.EncodeRLE(data.data(), expected.data(), length);
+            size_t actualLength = version.EncodeRLE(data.data(), actual.data(), length);
+            ASSERT_EQ(actualLength, expectedLength);
+            ASSERT_EQ(std::memcmp(actual.data(), expected.data(), expectedLength), 0);
+
+            expectedLength = scalar.EncodeRepeat(data.data(), expected.data(), length);
+            actualLength = version.EncodeRepeat(data.data(), actual.data(), length);
+            ASSERT_EQ(actualLength, expectedLength);
+            ASSERT_EQ(std::memcmp(actual.data(), expected.data(), expectedLength), 0);
+
+            for (bool decode : { false, true })
+            {
+                scalar.Rotate(expected.data(), data.data(), length, decode);
+                version.Rotate(actual.data(), data.data(), length, decode);
+                ASSERT_EQ(std::memcmp(actual.data(), expected.data(), length), 0);
+            }
+        }
+    }
+}
+
+TEST_F(SawyerCodingTest, fuzz_round_trip)
+{
+    std::mt19937 rng(0xC0DE);
+    for (size_t iteration = 0; iteration < 200; iteration++)
+    {
+        size_t length = iteration < 50 ? iteration + 1 : std::uniform_int_distribution<size_t>(50, 50000)(rng);
+        auto data = make_fuzz_data(rng, length);
+        for (uint8_t encoding :
+             { CHUNK_ENCODING_NONE, CHUNK_ENCODING_RLE, CHUNK_ENCODING_RLECOMPRESSED, CHUNK_ENCODING_ROTATE })
+        {
+            SCOPED_TRACE("encoding " + std::to_string(encoding) + " length " + std::to_string(length));
+            test_round_trip(data, encoding);
+        }
+    }
+}
+
+TEST_F(SawyerCodingTest, round_trip_over_blocks)
+{
+    // RLE compressed chunks are encoded in blocks of 64 KiB.
+    std::mt19937 rng(0xB10C);
+    for (size_t length : { 65535, 65536, 65537, 3 * 65536 + 17 })
+    {
+        SCOPED_TRACE("length " + std::to_string(length));
+        test_round_trip(make_fuzz_data(rng, length), CHUNK_ENCODING_RLECOMPRESSED);
+        test_round_trip(std::vector<uint8_t>(length), CHUNK_ENCODING_RLECOMPRESSED);
+    }
+}
+
+TEST_F(SawyerCodingTest, read_chunks_matches_read_chunk)
+{
+    std::mt19937 rng(0x5E6);
+    const std::vector<size_t> lengths = { 1, 16, 2000, 70000, 300000, 5, 64 };
+    const std::vector<uint8_t> encodings = { CHUNK_ENCODING_ROTATE,        CHUNK_ENCODING_RLECOMPRESSED, CHUNK_ENCODING_RLE,
+                                             CHUNK_ENCODING_RLECOMPRESSED, CHUNK_ENCODING_NONE,          CHUNK_ENCODING_RLE,
+                                             CHUNK_ENCODING_RLECOMPRESSED };
+    MemoryStream ms;
+    for (size_t i = 0; i < lengths.size(); i++)
+    {
+        auto data = make_fuzz_data(rng, lengths[i]);
+        if (i == lengths.size() - 1)
+        {
+            // Random bytes are stored as single bytes by the repeat encoding, more of them than fit the destination.
+            std::uniform_int_distribution<int> byteDist(0, 255);
+            std::generate(data.begin(), data.end(), [&]() { return static_cast<uint8_t>(byteDist(rng)); });
+        }
+        sawyercoding_chunk_header header;
+        header.encoding = encodings[i];
+        header.length = static_cast<uint32_t>(data.size());
+        std::vector<uint8_t> encoded(sizeof(sawyercoding_chunk_header) + data.size() * 3 + 16);
+        ms.Write(encoded.data(), sawyercoding_write_chunk_buffer(encoded.data(), data.data(), header));
+    }
+
+    // Destinations both larger and smaller than the chunks, which are padded and cut off. Each destination is followed
+    // by guard bytes that must not be written.
+    constexpr size_t GUARD_LENGTH = 64;
+    const std::vector<size_t> destinationLengths = { 1, 20, 1000, 70000, 300001, 5, 16 };
+    std::vector<std::vector<uint8_t>> expected;
+    std::vector<std::vector<uint8_t>> actual;
+    std::vector<SawyerChunkDestination> destinations;
+    ms.SetPosition(0);
+    SawyerChunkReader reader(&ms);
+    for (size_t length : destinationLengths)
+    {
+        expected.emplace_back(length + GUARD_LENGTH, 0xCC);
+        actual.emplace_back(length + GUARD_LENGTH, 0xCC);
+        reader.ReadChunk(expected.back().data(), length);
+    }
+    for (size_t i = 0; i < actual.size(); i++)
+    {
+        destinations.push_back({ actual[i].data(), destinationLengths[i] });
+    }
+    ms.SetPosition(0);
+    reader.ReadChunks(destinations);
+    ASSERT_EQ(ms.GetPosition(), ms.GetLength());
+    ASSERT_EQ(actual, expected);
+    for (size_t i = 0; i < actual.size(); i++)
+    {
+        auto guard = std::vector<uint8_t>(actual[i].end() - GUARD_LENGTH, actual[i].end());
+        ASSERT_EQ(guard, std::vector<uint8_t>(GUARD_LENGTH, 0xCC));
+    }
+
+    // Running out of data leaves the stream where it was.
+    ms.SetPosition(0);
+    destinations.push_back({ actual[0].data(), destinationLengths[0] });
+    ASSERT_ANY_THROW(reader.ReadChunks(destinations));
+    ASSERT_EQ(ms.GetPosition(), 0U);
+}
+
 // 1024 bytes of random data
 // use `dd if=/dev/urandom bs=1024 count=1 | xxd -i` to get your own
 const uint8_t SawyerCodingTest::randomdata[] = {